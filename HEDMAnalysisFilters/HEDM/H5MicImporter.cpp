@@ -36,6 +36,17 @@
 
 #include "H5MicImporter.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/pipeline.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include <QtCore/QFileInfo>
 #include <QtCore/QObject>
 #include <QtCore/QString>
 #include <QtCore/QtDebug>
@@ -51,6 +62,126 @@ using namespace H5Support_NAMESPACE;
 
 #define AIM_STRING QString
 
+namespace
+{
+/**
+ * @brief A .mic file of H5MicImporter::importFiles() on its way from the parsing to
+ * the writing stage
+ */
+struct ParsedMicSlice
+{
+  int index = -1;
+  std::shared_ptr<MicReader> reader;
+  int err = 0;
+};
+
+// Image rows are gathered into chunks of about this many bytes, the size of the chunk
+// cache HDF5 reads a dataset through unless told otherwise
+const hsize_t k_ChunkBytes = 1024 * 1024;
+
+/**
+ * @brief Writes a data array with the given dataset creation properties. Contiguous
+ * arrays are written the way QH5Lite writes them.
+ */
+template <typename T>
+herr_t WriteDataArray(hid_t gid, const QString& name, int32_t rank, const hsize_t* dims, hid_t dataProperties, const T* data)
+{
+  if(H5P_DEFAULT == dataProperties)
+  {
+    return QH5Lite::writePointerDataset(gid, name, rank, dims, data);
+  }
+  hid_t dataType = QH5Lite::HDFTypeForPrimitive(T());
+  hid_t dataspaceId = H5Screate_simple(rank, dims, nullptr);
+  if(dataspaceId < 0)
+  {
+    return -1;
+  }
+  herr_t err = -1;
+  hid_t datasetId = H5Dcreate(gid, name.toLatin1().data(), dataType, dataspaceId, H5P_DEFAULT, dataProperties, H5P_DEFAULT);
+  if(datasetId >= 0)
+  {
+    err = H5Dwrite(datasetId, dataType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+    H5Dclose(datasetId);
+  }
+  H5Sclose(dataspaceId);
+  return err;
+}
+
+/**
+ * @brief Writes the values of slice z into a dataset with one more dimension than the
+ * slice. The dataset is created on the first write and grown to hold the slice.
+ * @param sliceRank The rank of the slice, the dataset has sliceRank + 1 dimensions
+ * @param sliceDims The dimensions of the slice, slowest first
+ */
+template <typename T>
+herr_t WriteStackedSlice(hid_t gid, const QString& name, hid_t dataProperties, int32_t sliceRank, hsize_t z, const hsize_t* sliceDims, const T* data)
+{
+  const int32_t k_MaxRank = 3;
+  int32_t rank = sliceRank + 1;
+  if(rank > k_MaxRank)
+  {
+    return -1;
+  }
+  hid_t dataType = QH5Lite::HDFTypeForPrimitive(T());
+  hsize_t extent[k_MaxRank] = {z + 1, 0, 0};
+  hsize_t start[k_MaxRank] = {z, 0, 0};
+  hsize_t count[k_MaxRank] = {1, 0, 0};
+  for(int32_t dim = 0; dim < sliceRank; dim++)
+  {
+    extent[dim + 1] = sliceDims[dim];
+    count[dim + 1] = sliceDims[dim];
+  }
+
+  hid_t datasetId = -1;
+  if(H5Lexists(gid, name.toLatin1().data(), H5P_DEFAULT) > 0)
+  {
+    datasetId = H5Dopen(gid, name.toLatin1().data(), H5P_DEFAULT);
+    if(datasetId < 0)
+    {
+      return -1;
+    }
+    hsize_t current[k_MaxRank] = {0, 0, 0};
+    hid_t fileSpace = H5Dget_space(datasetId);
+    H5Sget_simple_extent_dims(fileSpace, current, nullptr);
+    H5Sclose(fileSpace);
+    bool grow = false;
+    for(int32_t dim = 0; dim < rank; dim++)
+    {
+      grow = grow || extent[dim] > current[dim];
+      extent[dim] = std::max(extent[dim], current[dim]);
+    }
+    if(grow && H5Dset_extent(datasetId, extent) < 0)
+    {
+      H5Dclose(datasetId);
+      return -1;
+    }
+  }
+  else
+  {
+    hsize_t maxDims[k_MaxRank] = {H5S_UNLIMITED, H5S_UNLIMITED, H5S_UNLIMITED};
+    hid_t fileSpace = H5Screate_simple(rank, extent, maxDims);
+    datasetId = H5Dcreate(gid, name.toLatin1().data(), dataType, fileSpace, H5P_DEFAULT, dataProperties, H5P_DEFAULT);
+    H5Sclose(fileSpace);
+    if(datasetId < 0)
+    {
+      return -1;
+    }
+  }
+
+  herr_t err = -1;
+  hid_t fileSpace = H5Dget_space(datasetId);
+  hid_t memorySpace = H5Screate_simple(rank, count, nullptr);
+  if(H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start, nullptr, count, nullptr) >= 0)
+  {
+    err = H5Dwrite(datasetId, dataType, memorySpace, fileSpace, H5P_DEFAULT, data);
+  }
+  H5Sclose(memorySpace);
+  H5Sclose(fileSpace);
+  H5Dclose(datasetId);
+  return err;
+}
+} // namespace
+
 #define CHECK_FOR_CANCELED(AClass)                                                                                                                                                                     \
   if(m_Cancel == true)                                                                                                                                                                                 \
   {                                                                                                                                                                                                    \
@@ -90,11 +221,15 @@ using namespace H5Support_NAMESPACE;
     m_msgType* dataPtr = reader.get##prpty##Pointer();                                                                                                                                                 \
     if(nullptr != dataPtr)                                                                                                                                                                             \
     {                                                                                                                                                                                                  \
-      err = QH5Lite::writePointerDataset(gid, key, rank, dims, dataPtr);                                                                                                                               \
+      err = WriteDataArray(gid, key, rank, dims, dataProperties, dataPtr);                                                                                                                             \
       if(err < 0)                                                                                                                                                                                      \
       {                                                                                                                                                                                                \
         QString ss = QObject::tr("H5MicImporter Error: Could not write Mic Data array for '%1' to the HDF5 file with data set name '%2'\n").arg(key).arg(key);                                         \
         progressMessage(ss, 100);                                                                                                                                                                      \
+        if(H5P_DEFAULT != dataProperties)                                                                                                                                                              \
+        {                                                                                                                                                                                              \
+          H5Pclose(dataProperties);                                                                                                                                                                    \
+        }                                                                                                                                                                                              \
         err = H5Gclose(gid);                                                                                                                                                                           \
         err = H5Gclose(MicGroup);                                                                                                                                                                      \
         return -1;                                                                                                                                                                                     \
@@ -162,6 +297,12 @@ H5MicImporter::H5MicImporter()
 , yRes(0)
 , m_FileVersion(Mic::H5Mic::FileVersion)
 {
+  m_Compression = Mic::H5Mic::DeflateCompression;
+  m_CompressionLevel = 6;
+  m_ChunkRows = 0;
+  m_MaxSlicesInFlight = 0;
+  m_Layout = Mic::H5Mic::SliceGroups;
+  m_NumSlicesImported = 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -192,7 +333,7 @@ void H5MicImporter::getSpacing(float& x, float& y)
 // -----------------------------------------------------------------------------
 int H5MicImporter::numberOfSlicesImported()
 {
-  return 1;
+  return m_NumSlicesImported;
 }
 
 // -----------------------------------------------------------------------------
@@ -204,6 +345,7 @@ int H5MicImporter::importFile(hid_t fileId, int64_t z, const QString& MicFile)
   setCancel(false);
   setErrorCode(0);
   setPipelineMessage("");
+  m_NumSlicesImported = 0;
 
   //  std::cout << "H5MicImporter: Importing " << MicFile << std::endl;
   MicReader reader;
@@ -221,6 +363,111 @@ int H5MicImporter::importFile(hid_t fileId, int64_t z, const QString& MicFile)
     return -1;
   }
 
+  err = writeSlice(fileId, z, reader);
+  m_NumSlicesImported = (err < 0) ? 0 : 1;
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5MicImporter::importFiles(hid_t fileId, int64_t zStart, const QVector<QString>& micFiles)
+{
+  setCancel(false);
+  setErrorCode(0);
+  setPipelineMessage("");
+
+  // The lowest index of a slice that failed. The slices after it are not parsed any more,
+  // the slices before it are still parsed and written.
+  std::atomic<int> firstFailed(micFiles.size());
+  auto sliceFailed = [&firstFailed](int index) {
+    int current = firstFailed;
+    while(index < current && !firstFailed.compare_exchange_weak(current, index))
+    {
+    }
+  };
+  int err = 0;
+  m_NumSlicesImported = 0;
+
+  auto parseSlice = [&](ParsedMicSlice slice) -> ParsedMicSlice {
+    if(slice.index < firstFailed)
+    {
+      slice.reader = std::make_shared<MicReader>();
+      slice.reader->setFileName(micFiles[slice.index]);
+      slice.err = slice.reader->readFile();
+      if(slice.err < 0)
+      {
+        sliceFailed(slice.index);
+      }
+    }
+    return slice;
+  };
+
+  auto writeParsedSlice = [&](const ParsedMicSlice& slice) {
+    if(err < 0 || nullptr == slice.reader)
+    {
+      return;
+    }
+    if(slice.err < 0)
+    {
+      setPipelineMessage(slice.reader->getErrorMessage());
+      setErrorCode(slice.reader->getErrorCode());
+      progressMessage(slice.reader->getErrorMessage(), slice.reader->getErrorCode());
+      err = -1;
+      return;
+    }
+    err = writeSlice(fileId, zStart + slice.index, *(slice.reader));
+    if(err < 0)
+    {
+      sliceFailed(slice.index);
+      return;
+    }
+    m_NumSlicesImported++;
+  };
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  size_t maxSlicesInFlight = static_cast<size_t>(m_MaxSlicesInFlight);
+  if(m_MaxSlicesInFlight <= 0)
+  {
+    maxSlicesInFlight = 2 * static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+  }
+
+  // The files are parsed in parallel. Only the last stage calls into HDF5 and it runs
+  // serially and in order, so the slices are written one at a time in z order while at
+  // most maxSlicesInFlight parsed slices are held in memory.
+  int nextIndex = 0;
+  auto nextSlice = [&](tbb::flow_control& fc) -> ParsedMicSlice {
+    ParsedMicSlice slice;
+    if(nextIndex >= micFiles.size() || nextIndex > firstFailed || getCancel())
+    {
+      fc.stop();
+      return slice;
+    }
+    slice.index = nextIndex++;
+    return slice;
+  };
+  tbb::parallel_pipeline(maxSlicesInFlight, tbb::make_filter<void, ParsedMicSlice>(tbb::filter::serial_in_order, nextSlice) &
+                                                tbb::make_filter<ParsedMicSlice, ParsedMicSlice>(tbb::filter::parallel, parseSlice) &
+                                                tbb::make_filter<ParsedMicSlice, void>(tbb::filter::serial_in_order, writeParsedSlice));
+#else
+  for(int index = 0; index < micFiles.size() && index <= firstFailed && !getCancel(); index++)
+  {
+    ParsedMicSlice slice;
+    slice.index = index;
+    writeParsedSlice(parseSlice(slice));
+  }
+#endif
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5MicImporter::writeSlice(hid_t fileId, int64_t z, MicReader& reader)
+{
+  herr_t err = -1;
+
   // Write the fileversion attribute if it does not exist
   {
     QVector<hsize_t> dims;
@@ -231,7 +478,12 @@ int H5MicImporter::importFile(hid_t fileId, int64_t z, const QString& MicFile)
     if(attr_type < 0) // The attr_type variable was never set which means the attribute was NOT there
     {
       // The file version does not exist so write it to the file
-      err = QH5Lite::writeScalarAttribute(fileId, "/", Mic::H5Mic::FileVersionStr, m_FileVersion);
+      int fileVersion = m_FileVersion;
+      if(m_Layout != Mic::H5Mic::SliceGroups)
+      {
+        fileVersion = std::max(fileVersion, static_cast<int>(Mic::H5Mic::VolumeFileVersion));
+      }
+      err = QH5Lite::writeScalarAttribute(fileId, "/", Mic::H5Mic::FileVersionStr, fileVersion);
     }
     else
     {
@@ -340,39 +592,336 @@ int H5MicImporter::importFile(hid_t fileId, int64_t z, const QString& MicFile)
   // Close the "Header" group
   err = H5Gclose(gid);
 
-  // Create the "Data" group
-  gid = QH5Utilities::createGroup(MicGroup, Mic::H5Mic::Data);
-  if(gid < 0)
+  if(m_Layout != Mic::H5Mic::VolumeOnly)
   {
-    QString ss = QObject::tr("H5MicImporter Error: The 'Data' Group for Z index %1 could not be created."
-                             " Please check other error messages from the HDF5 library for possible reasons.")
-                     .arg(z);
+    // Create the "Data" group
+    gid = QH5Utilities::createGroup(MicGroup, Mic::H5Mic::Data);
+    if(gid < 0)
+    {
+      QString ss = QObject::tr("H5MicImporter Error: The 'Data' Group for Z index %1 could not be created."
+                               " Please check other error messages from the HDF5 library for possible reasons.")
+                       .arg(z);
+      progressMessage(ss, 100);
+      err = H5Gclose(MicGroup);
+      setPipelineMessage(ss);
+      setErrorCode(-700);
+      return -1;
+    }
+
+    int32_t rank = 1;
+    hsize_t dims[1] = {static_cast<hsize_t>(reader.getXDimension() * reader.getYDimension())};
+    hid_t dataProperties = createDataProperties(static_cast<hsize_t>(reader.getXDimension()), dims[0]);
+
+    WRITE_Mic_DATA_ARRAY(reader, float, gid, Euler1, Mic::Euler1);
+    WRITE_Mic_DATA_ARRAY(reader, float, gid, Euler2, Mic::Euler2);
+    WRITE_Mic_DATA_ARRAY(reader, float, gid, Euler3, Mic::Euler3);
+    WRITE_Mic_DATA_ARRAY(reader, float, gid, X, Mic::X);
+    WRITE_Mic_DATA_ARRAY(reader, float, gid, Y, Mic::Y);
+    WRITE_Mic_DATA_ARRAY(reader, float, gid, Confidence, Mic::Confidence);
+    WRITE_Mic_DATA_ARRAY(reader, int, gid, Phase, Mic::Phase);
+    if(H5P_DEFAULT != dataProperties)
+    {
+      H5Pclose(dataProperties);
+    }
+    // Close the "Data" group
+    err = H5Gclose(gid);
+  }
+
+  // Close the group for this file
+  err = H5Gclose(MicGroup);
+
+  if(m_Layout != Mic::H5Mic::SliceGroups)
+  {
+    err = writeVolumeSlice(fileId, z, reader);
+  }
+  return err;
+}
+
+#define WRITE_Mic_VOLUME_ARRAY(reader, m_msgType, prpty, key)                                                                                                                                          \
+  {                                                                                                                                                                                                    \
+    m_msgType* dataPtr = reader.get##prpty##Pointer();                                                                                                                                                 \
+    if(nullptr != dataPtr && err >= 0)                                                                                                                                                                 \
+    {                                                                                                                                                                                                  \
+      err = WriteStackedSlice(volumeGid, key, volumeProperties, 2, static_cast<hsize_t>(z), sliceDims, dataPtr);                                                                                       \
+      if(err < 0)                                                                                                                                                                                      \
+      {                                                                                                                                                                                                \
+        QString ss = QObject::tr("H5MicImporter Error: Could not write slice %1 of the Mic Volume array '%2'").arg(z).arg(key);                                                                        \
+        progressMessage(ss, 100);                                                                                                                                                                      \
+        setPipelineMessage(ss);                                                                                                                                                                        \
+        setErrorCode(-801);                                                                                                                                                                            \
+      }                                                                                                                                                                                                \
+    }                                                                                                                                                                                                  \
+  }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5MicImporter::writeVolumeSlice(hid_t fileId, int64_t z, MicReader& reader)
+{
+  hid_t volumeGid = QH5Utilities::createGroup(fileId, Mic::H5Mic::Volume);
+  if(volumeGid < 0)
+  {
+    QString ss = QObject::tr("H5MicImporter Error: The 'Volume' Group could not be created."
+                             " Please check other error messages from the HDF5 library for possible reasons.");
     progressMessage(ss, 100);
-    err = H5Gclose(MicGroup);
     setPipelineMessage(ss);
-    setErrorCode(-700);
+    setErrorCode(-800);
     return -1;
   }
 
-  int32_t rank = 1;
-  hsize_t dims[1] = {static_cast<hsize_t>(reader.getXDimension() * reader.getYDimension())};
-
-  WRITE_Mic_DATA_ARRAY(reader, float, gid, Euler1, Mic::Euler1);
-  WRITE_Mic_DATA_ARRAY(reader, float, gid, Euler2, Mic::Euler2);
-  WRITE_Mic_DATA_ARRAY(reader, float, gid, Euler3, Mic::Euler3);
-  WRITE_Mic_DATA_ARRAY(reader, float, gid, X, Mic::X);
-  WRITE_Mic_DATA_ARRAY(reader, float, gid, Y, Mic::Y);
-  WRITE_Mic_DATA_ARRAY(reader, float, gid, Confidence, Mic::Confidence);
-  WRITE_Mic_DATA_ARRAY(reader, int, gid, Phase, Mic::Phase);
-  // Close the "Data" group
-  err = H5Gclose(gid);
+  hsize_t sliceDims[2] = {static_cast<hsize_t>(reader.getYDimension()), static_cast<hsize_t>(reader.getXDimension())};
+  hid_t volumeProperties = createVolumeProperties(sliceDims[1], sliceDims[0]);
+  if(volumeProperties < 0)
+  {
+    H5Gclose(volumeGid);
+    return -1;
+  }
 
-  // Close the group for this file
-  err = H5Gclose(MicGroup);
+  // The x and y dimensions of every slice, so slices smaller than the volume can be placed
+  herr_t err = 0;
+  {
+    hsize_t rowDims[1] = {2};
+    hsize_t chunkDims[2] = {64, 2};
+    hid_t rowProperties = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_chunk(rowProperties, 2, chunkDims);
+    int64_t sliceDimensions[2] = {static_cast<int64_t>(reader.getXDimension()), static_cast<int64_t>(reader.getYDimension())};
+    err = WriteStackedSlice(volumeGid, Mic::H5Mic::SliceDimensions, rowProperties, 1, static_cast<hsize_t>(z), rowDims, sliceDimensions);
+    H5Pclose(rowProperties);
+    if(err < 0)
+    {
+      QString ss = QObject::tr("H5MicImporter Error: Could not write the dimensions of slice %1 into the Mic Volume").arg(z);
+      progressMessage(ss, 100);
+      setPipelineMessage(ss);
+      setErrorCode(-801);
+    }
+  }
 
+  WRITE_Mic_VOLUME_ARRAY(reader, float, Euler1, Mic::Euler1)
+  WRITE_Mic_VOLUME_ARRAY(reader, float, Euler2, Mic::Euler2)
+  WRITE_Mic_VOLUME_ARRAY(reader, float, Euler3, Mic::Euler3)
+  WRITE_Mic_VOLUME_ARRAY(reader, float, X, Mic::X)
+  WRITE_Mic_VOLUME_ARRAY(reader, float, Y, Mic::Y)
+  WRITE_Mic_VOLUME_ARRAY(reader, float, Confidence, Mic::Confidence)
+  WRITE_Mic_VOLUME_ARRAY(reader, int, Phase, Mic::Phase)
+
+  H5Pclose(volumeProperties);
+  H5Gclose(volumeGid);
+  return (err < 0) ? -1 : 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5MicImporter::writeVirtualVolume(hid_t fileId, const QString& sourceFile)
+{
+  if(sourceFile.isEmpty())
+  {
+    return writeVirtualDatasets(fileId, fileId, sourceFile);
+  }
+
+  // HDF5 resolves a relative path of a mapping or link against the view file or the
+  // working directory of whoever opens it, so the view stores the absolute path
+  QString sourcePath = QFileInfo(sourceFile).absoluteFilePath();
+  hid_t sourceId = QH5Utilities::openFile(sourcePath, true);
+  if(sourceId < 0)
+  {
+    QString ss = QObject::tr("H5MicImporter Error: The source file '%1' of the virtual Mic Volume could not be opened.").arg(sourceFile);
+    progressMessage(ss, 100);
+    setPipelineMessage(ss);
+    setErrorCode(-900);
+    return -1;
+  }
+  int err = writeVirtualDatasets(fileId, sourceId, sourcePath);
+  QH5Utilities::closeFile(sourceId);
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5MicImporter::writeVirtualDatasets(hid_t fileId, hid_t sourceId, const QString& sourceFile)
+{
+  int64_t zStart = 0;
+  int64_t zEnd = -1;
+  herr_t err = QH5Lite::readScalarDataset(sourceId, Ebsd::H5Ebsd::ZStartIndex, zStart);
+  if(err >= 0)
+  {
+    err = QH5Lite::readScalarDataset(sourceId, Ebsd::H5Ebsd::ZEndIndex, zEnd);
+  }
+  if(err < 0 || zStart < 0 || zEnd < zStart)
+  {
+    QString ss = QObject::tr("H5MicImporter Error: The source file does not hold a valid range of slices.");
+    progressMessage(ss, 100);
+    setPipelineMessage(ss);
+    setErrorCode(-901);
+    return -1;
+  }
+  if(H5Lexists(fileId, Mic::H5Mic::Volume.toLatin1().data(), H5P_DEFAULT) > 0)
+  {
+    QString ss = QObject::tr("H5MicImporter Error: The file already has a 'Volume' Group.");
+    progressMessage(ss, 100);
+    setPipelineMessage(ss);
+    setErrorCode(-902);
+    return -1;
+  }
+
+  // The x and y dimensions of every slice. Rows of missing slices stay empty.
+  size_t numRows = static_cast<size_t>(zEnd + 1);
+  std::vector<int64_t> sliceDimensions(2 * numRows, 0);
+  hsize_t volumeDims[3] = {numRows, 0, 0};
+  for(int64_t z = zStart; z <= zEnd; z++)
+  {
+    QString sliceName = QString::number(z);
+    if(H5Lexists(sourceId, sliceName.toLatin1().data(), H5P_DEFAULT) <= 0)
+    {
+      continue;
+    }
+    QString headerPath = sliceName + "/" + Mic::H5Mic::Header + "/";
+    int xDimension = 0;
+    int yDimension = 0;
+    err = QH5Lite::readScalarDataset(sourceId, headerPath + Mic::XDim, xDimension);
+    if(err >= 0)
+    {
+      err = QH5Lite::readScalarDataset(sourceId, headerPath + Mic::YDim, yDimension);
+    }
+    if(err < 0 || xDimension < 0 || yDimension < 0)
+    {
+      QString ss = QObject::tr("H5MicImporter Error: The dimensions of slice %1 could not be read from the source file.").arg(z);
+      progressMessage(ss, 100);
+      setPipelineMessage(ss);
+      setErrorCode(-901);
+      return -1;
+    }
+    sliceDimensions[2 * z] = xDimension;
+    sliceDimensions[2 * z + 1] = yDimension;
+    volumeDims[1] = std::max(volumeDims[1], static_cast<hsize_t>(yDimension));
+    volumeDims[2] = std::max(volumeDims[2], static_cast<hsize_t>(xDimension));
+  }
+
+  // A separate view file gets the root values and links to the slice groups of the source
+  if(sourceId != fileId)
+  {
+    QList<QString> names;
+    err = QH5Utilities::getGroupObjects(sourceId, H5Utilities::H5Support_DATASET, names);
+    for(const QString& name : names)
+    {
+      if(err >= 0 && H5Lexists(fileId, name.toLatin1().data(), H5P_DEFAULT) <= 0)
+      {
+        err = H5Ocopy(sourceId, name.toLatin1().data(), fileId, name.toLatin1().data(), H5P_DEFAULT, H5P_DEFAULT);
+      }
+    }
+    for(int64_t z = zStart; z <= zEnd && err >= 0; z++)
+    {
+      QString sliceName = QString::number(z);
+      if(H5Lexists(sourceId, sliceName.toLatin1().data(), H5P_DEFAULT) > 0 && H5Lexists(fileId, sliceName.toLatin1().data(), H5P_DEFAULT) <= 0)
+      {
+        err = H5Lcreate_external(sourceFile.toLatin1().data(), ("/" + sliceName).toLatin1().data(), fileId, sliceName.toLatin1().data(), H5P_DEFAULT, H5P_DEFAULT);
+      }
+    }
+    if(err >= 0)
+    {
+      int fileVersion = std::max(m_FileVersion, static_cast<int>(Mic::H5Mic::VolumeFileVersion));
+      err = QH5Lite::writeScalarAttribute(fileId, "/", Mic::H5Mic::FileVersionStr, fileVersion);
+    }
+    if(err < 0)
+    {
+      QString ss = QObject::tr("H5MicImporter Error: The root values and slice groups of the source file could not be linked into the view.");
+      progressMessage(ss, 100);
+      setPipelineMessage(ss);
+      setErrorCode(-903);
+      return -1;
+    }
+  }
+
+  hid_t volumeGid = QH5Utilities::createGroup(fileId, Mic::H5Mic::Volume);
+  if(volumeGid < 0)
+  {
+    QString ss = QObject::tr("H5MicImporter Error: The 'Volume' Group could not be created."
+                             " Please check other error messages from the HDF5 library for possible reasons.");
+    progressMessage(ss, 100);
+    setPipelineMessage(ss);
+    setErrorCode(-800);
+    return -1;
+  }
+  hsize_t rowDims[2] = {numRows, 2};
+  err = QH5Lite::writePointerDataset(volumeGid, Mic::H5Mic::SliceDimensions, 2, rowDims, sliceDimensions.data());
+
+  // Virtual dataset sources name files and datasets with printf style patterns and "."
+  // stands for the file of the view itself
+  QString mappedFile = sourceFile.isEmpty() ? QString(".") : QString(sourceFile).replace("%", "%%");
+  const QString arrayNames[] = {Mic::Euler1, Mic::Euler2, Mic::Euler3, Mic::X, Mic::Y, Mic::Confidence, Mic::Phase};
+  for(const QString& name : arrayNames)
+  {
+    hid_t dataType = -1;
+    hid_t dataProperties = H5Pcreate(H5P_DATASET_CREATE);
+    hid_t volumeSpace = H5Screate_simple(3, volumeDims, nullptr);
+    for(int64_t z = zStart; z <= zEnd && err >= 0; z++)
+    {
+      QString dataPath = QString::number(z) + "/" + Mic::H5Mic::Data;
+      QString arrayPath = dataPath + "/" + name;
+      hsize_t numElements = static_cast<hsize_t>(sliceDimensions[2 * z] * sliceDimensions[2 * z + 1]);
+      if(numElements == 0 || H5Lexists(sourceId, dataPath.toLatin1().data(), H5P_DEFAULT) <= 0 || H5Lexists(sourceId, arrayPath.toLatin1().data(), H5P_DEFAULT) <= 0)
+      {
+        continue;
+      }
+      hid_t datasetId = H5Dopen(sourceId, arrayPath.toLatin1().data(), H5P_DEFAULT);
+      if(datasetId < 0)
+      {
+        err = -1;
+        break;
+      }
+      hid_t sourceSpace = H5Dget_space(datasetId);
+      if(H5Sget_simple_extent_npoints(sourceSpace) != static_cast<hssize_t>(numElements))
+      {
+        err = -1;
+      }
+      if(dataType < 0)
+      {
+        dataType = H5Dget_type(datasetId);
+      }
+      H5Dclose(datasetId);
+
+      // The row major values of the slice fill the y = x = 0 corner of row z
+      hsize_t start[3] = {static_cast<hsize_t>(z), 0, 0};
+      hsize_t count[3] = {1, static_cast<hsize_t>(sliceDimensions[2 * z + 1]), static_cast<hsize_t>(sliceDimensions[2 * z])};
+      if(err >= 0)
+      {
+        err = H5Sselect_hyperslab(volumeSpace, H5S_SELECT_SET, start, nullptr, count, nullptr);
+      }
+      if(err >= 0)
+      {
+        err = H5Pset_virtual(dataProperties, volumeSpace, mappedFile.toLatin1().data(), ("/" + arrayPath).toLatin1().data(), sourceSpace);
+      }
+      H5Sclose(sourceSpace);
+    }
+    if(err >= 0 && dataType >= 0)
+    {
+      int fillValue = 0;
+      H5Pset_fill_value(dataProperties, H5T_NATIVE_INT, &fillValue);
+      H5Sselect_all(volumeSpace);
+      hid_t datasetId = H5Dcreate(volumeGid, name.toLatin1().data(), dataType, volumeSpace, H5P_DEFAULT, dataProperties, H5P_DEFAULT);
+      err = (datasetId < 0) ? -1 : H5Dclose(datasetId);
+    }
+    if(dataType >= 0)
+    {
+      H5Tclose(dataType);
+    }
+    H5Sclose(volumeSpace);
+    H5Pclose(dataProperties);
+    if(err < 0)
+    {
+      QString ss = QObject::tr("H5MicImporter Error: Could not map the slices of the Mic Data array '%1' into the virtual Mic Volume").arg(name);
+      progressMessage(ss, 100);
+      setPipelineMessage(ss);
+      setErrorCode(-903);
+      break;
+    }
+  }
+
+  H5Gclose(volumeGid);
+  return (err < 0) ? -1 : 0;
+}
+
 #define WRITE_PHASE_HEADER_DATA(reader, m_msgType, prpty, key)                                                                                                                                         \
   {                                                                                                                                                                                                    \
     m_msgType t = reader->get##prpty();                                                                                                                                                                \
@@ -474,6 +1023,90 @@ int H5MicImporter::writeZandCoordinates(MicPhase* p, hid_t ZandCGid)
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+hid_t H5MicImporter::createDataProperties(hsize_t xPoints, hsize_t numElements)
+{
+  if(m_Compression == Mic::H5Mic::NoCompression || xPoints == 0 || numElements == 0)
+  {
+    return H5P_DEFAULT;
+  }
+
+  // A chunk holds whole image rows so reading a band of rows only touches the chunks it overlaps
+  hsize_t chunkDims[1] = {std::min(numElements, getRowsPerChunk(xPoints) * xPoints)};
+  hid_t dataProperties = createChunkedProperties(1, chunkDims);
+  return (dataProperties < 0) ? H5P_DEFAULT : dataProperties;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+hid_t H5MicImporter::createVolumeProperties(hsize_t xPoints, hsize_t yPoints)
+{
+  hsize_t chunkDims[3] = {1, std::min(yPoints, getRowsPerChunk(xPoints)), xPoints};
+  return createChunkedProperties(3, chunkDims);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+hsize_t H5MicImporter::getRowsPerChunk(hsize_t xPoints) const
+{
+  if(m_ChunkRows > 0)
+  {
+    return static_cast<hsize_t>(m_ChunkRows);
+  }
+  // Every data array holds 4 byte values
+  return std::max<hsize_t>(1, k_ChunkBytes / (std::max<hsize_t>(1, xPoints) * sizeof(float)));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+hid_t H5MicImporter::createChunkedProperties(int32_t rank, const hsize_t* chunkDims)
+{
+  hid_t dataProperties = H5Pcreate(H5P_DATASET_CREATE);
+  if(dataProperties < 0)
+  {
+    return -1;
+  }
+  if(H5Pset_chunk(dataProperties, rank, chunkDims) < 0)
+  {
+    H5Pclose(dataProperties);
+    return -1;
+  }
+  if(m_Compression == Mic::H5Mic::NoCompression)
+  {
+    return dataProperties;
+  }
+
+  unsigned int level = static_cast<unsigned int>(std::min(std::max(m_CompressionLevel, 1), 9));
+  herr_t err = H5Pset_shuffle(dataProperties);
+  if(err >= 0)
+  {
+    err = -1;
+    if(m_Compression == Mic::H5Mic::Lz4Compression && H5Zfilter_avail(Mic::H5Mic::Lz4FilterId) > 0)
+    {
+      err = H5Pset_filter(dataProperties, Mic::H5Mic::Lz4FilterId, H5Z_FLAG_MANDATORY, 0, nullptr);
+    }
+    else if(m_Compression == Mic::H5Mic::ZstdCompression && H5Zfilter_avail(Mic::H5Mic::ZstdFilterId) > 0)
+    {
+      err = H5Pset_filter(dataProperties, Mic::H5Mic::ZstdFilterId, H5Z_FLAG_MANDATORY, 1, &level);
+    }
+    if(err < 0)
+    {
+      err = H5Pset_deflate(dataProperties, level);
+    }
+  }
+  if(err < 0)
+  {
+    H5Pclose(dataProperties);
+    return -1;
+  }
+  return dataProperties;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -72,6 +72,39 @@ class H5MicImporter : public EbsdImporter
 
     ~H5MicImporter() override;
 
+    /**
+     * @brief How the data arrays are stored. Every mode but NoCompression stores them in
+     * chunks of whole image rows with the bytes shuffled before they are compressed. LZ4
+     * and Zstandard need the HDF5 filter plugin for them, deflate is used when it is not
+     * installed. Defaults to DeflateCompression.
+     */
+    EBSD_INSTANCE_PROPERTY(Mic::H5Mic::Compression, Compression)
+
+    /**
+     * @brief The deflate or Zstandard level from 1 (fastest) to 9 (smallest). Defaults to 6.
+     */
+    EBSD_INSTANCE_PROPERTY(int, CompressionLevel)
+
+    /**
+     * @brief The number of image rows in a chunk. Zero (the default) puts as many rows
+     * in a chunk as fit in the 1 MB chunk cache HDF5 reads through.
+     */
+    EBSD_INSTANCE_PROPERTY(int, ChunkRows)
+
+    /**
+     * @brief Whether the data arrays go into the Data group of every slice, into the
+     * [z][y][x] datasets of the Volume group, or into both. The slice index is the z
+     * index into the volume. Files with a Volume group get FileVersion 6. Defaults
+     * to SliceGroups.
+     */
+    EBSD_INSTANCE_PROPERTY(Mic::H5Mic::Layout, Layout)
+
+    /**
+     * @brief The most slices importFiles() holds in memory at once, parsed or being
+     * parsed. Zero (the default) allows two per thread.
+     */
+    EBSD_INSTANCE_PROPERTY(int, MaxSlicesInFlight)
+
     /**
      * @brief Imports a specific file into the HDF5 file
      * @param fileId The valid HDF5 file Id for an already open HDF5 file
@@ -80,6 +113,31 @@ class H5MicImporter : public EbsdImporter
      */
     int importFile(hid_t fileId, int64_t index, const QString& MicFile);
 
+    /**
+     * @brief Imports a stack of files into the HDF5 file. The files are parsed on worker
+     * threads while the slices are written one at a time and in order, as HDF5 must not
+     * be called from two threads at once. Without SIMPL_USE_PARALLEL_ALGORITHMS the files
+     * are imported one after the other.
+     * @param fileId The valid HDF5 file Id for an already open HDF5 file
+     * @param zStart The slice index of the first file
+     * @param micFiles The absolute paths to the input .Mic files in slice order
+     * @return error condition
+     */
+    int importFiles(hid_t fileId, int64_t zStart, const QVector<QString>& micFiles);
+
+    /**
+     * @brief Writes a Volume group of HDF5 virtual datasets that map the Data arrays of
+     * every slice group of a per slice file onto [z][y][x] datasets, so H5MicVolumeReader
+     * reads the slices of the file with one read per array. No data is copied. A separate
+     * view file also gets the values of the root group and external links to the slice
+     * groups, so it can be opened in place of the source file.
+     * @param fileId The valid HDF5 file Id of the file that holds the view
+     * @param sourceFile The per slice file the view maps, or an empty string to add the
+     * view to the file of fileId itself. The view refers to it by its absolute path.
+     * @return error condition
+     */
+    int writeVirtualVolume(hid_t fileId, const QString& sourceFile = QString());
+
     /**
      * @brief Writes the phase data into the HDF5 file
      * @param reader Valid MicReader instance
@@ -119,6 +177,60 @@ class H5MicImporter : public EbsdImporter
   protected:
     H5MicImporter();
 
+    /**
+     * @brief Creates the dataset creation properties for the data arrays of a slice
+     * @param xPoints Number of grid points in an image row
+     * @param numElements Number of grid points in the slice
+     * @return The property list the caller closes or H5P_DEFAULT for contiguous storage
+     */
+    hid_t createDataProperties(hsize_t xPoints, hsize_t numElements);
+
+    /**
+     * @brief Creates the dataset creation properties for the [z][y][x] datasets of the
+     * Volume group. They are always chunked so the z extent can grow.
+     * @param xPoints Number of grid points in an image row of the first slice
+     * @param yPoints Number of image rows of the first slice
+     * @return The property list the caller closes or a negative value on error
+     */
+    hid_t createVolumeProperties(hsize_t xPoints, hsize_t yPoints);
+
+    /**
+     * @brief Returns the number of image rows in a chunk of a slice with the given row length
+     */
+    hsize_t getRowsPerChunk(hsize_t xPoints) const;
+
+    /**
+     * @brief Creates chunked dataset creation properties with the compression filters
+     * @return The property list the caller closes or a negative value on error
+     */
+    hid_t createChunkedProperties(int32_t rank, const hsize_t* chunkDims);
+
+    /**
+     * @brief Writes the data arrays of a slice into the datasets of the Volume group
+     * @param fileId The valid HDF5 file Id for an already open HDF5 file
+     * @param z The slice index
+     * @param reader The reader holding the slice
+     * @return error condition
+     */
+    int writeVolumeSlice(hid_t fileId, int64_t z, MicReader& reader);
+
+    /**
+     * @brief Writes the view of writeVirtualVolume() once the source file is open
+     * @param fileId The file that holds the view
+     * @param sourceId The per slice file, which is fileId when the view is added in place
+     * @param sourceFile The path of the per slice file or an empty string
+     * @return error condition
+     */
+    int writeVirtualDatasets(hid_t fileId, hid_t sourceId, const QString& sourceFile);
+
+    /**
+     * @brief Writes the header and data of a slice that the reader has read
+     * @param fileId The valid HDF5 file Id for an already open HDF5 file
+     * @param z The slice index
+     * @param reader The reader holding the slice
+     * @return error condition
+     */
+    int writeSlice(hid_t fileId, int64_t z, MicReader& reader);
 
   private:
     int64_t xDim;
@@ -126,6 +238,7 @@ class H5MicImporter : public EbsdImporter
     float xRes;
     float yRes;
     int   m_FileVersion;
+    int   m_NumSlicesImported;
 
   public:
     H5MicImporter(const H5MicImporter&) = delete;  // Copy Constructor Not Implemented
@@ -84,10 +84,20 @@ int H5MicReader::readFile()
     return -100;
   }
 
+  err = readSlice(fileId);
+  QH5Utilities::closeFile(fileId);
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5MicReader::readSlice(hid_t fileId)
+{
+  int err = -1;
   hid_t gid = H5Gopen(fileId, m_HDF5Path.toLatin1().data(), H5P_DEFAULT);
   if(gid < 0)
   {
-    err = QH5Utilities::closeFile(fileId);
     QString ss = QObject::tr("H5MicReader Error: Could not open path '%1'").arg(m_HDF5Path);
     setErrorMessage(ss);
     setErrorCode(-101);
@@ -103,7 +113,6 @@ int H5MicReader::readFile()
   err = readData(gid);
 
   err = H5Gclose(gid);
-  err = QH5Utilities::closeFile(fileId);
 
   return err;
 }
@@ -149,6 +158,21 @@ int H5MicReader::readHeaderOnly()
   return err;
 }
 
+#define READ_MIC_HEADER_DATA(cname, m_msgType, prpty, key, gid)                                                                                                                                        \
+  {                                                                                                                                                                                                    \
+    m_msgType t;                                                                                                                                                                                       \
+    err = QH5Lite::readScalarDataset(gid, key, t);                                                                                                                                                     \
+    if(err < 0)                                                                                                                                                                                        \
+    {                                                                                                                                                                                                  \
+      QString ss = QObject::tr("%1: The header value for '%2' was not found in the H5EBSD file").arg(cname).arg(key);                                                                                  \
+      setErrorCode(-90001);                                                                                                                                                                            \
+      setErrorMessage(ss);                                                                                                                                                                             \
+      err = H5Gclose(gid);                                                                                                                                                                             \
+      return -1;                                                                                                                                                                                       \
+    }                                                                                                                                                                                                  \
+    set##prpty(t);                                                                                                                                                                                     \
+  }
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -164,10 +188,10 @@ int H5MicReader::readHeader(hid_t parId)
     return -105;
   }
 
-  READ_EBSD_HEADER_DATA("H5MicReader", MicHeaderEntry<float>, float, XRes, Mic::XRes, gid)
-  READ_EBSD_HEADER_DATA("H5MicReader", MicHeaderEntry<float>, float, YRes, Mic::YRes, gid)
-  READ_EBSD_HEADER_DATA("H5MicReader", MicHeaderEntry<int>, int, XDim, Mic::XDim, gid)
-  READ_EBSD_HEADER_DATA("H5MicReader", MicHeaderEntry<int>, int, YDim, Mic::YDim, gid)
+  READ_MIC_HEADER_DATA("H5MicReader", float, XRes, Mic::XRes, gid)
+  READ_MIC_HEADER_DATA("H5MicReader", float, YRes, Mic::YRes, gid)
+  READ_MIC_HEADER_DATA("H5MicReader", int, XDim, Mic::XDim, gid)
+  READ_MIC_HEADER_DATA("H5MicReader", int, YDim, Mic::YDim, gid)
 
   hid_t phasesGid = H5Gopen(gid, Mic::H5Mic::Phases.toLatin1().data(), H5P_DEFAULT);
   if(phasesGid < 0)
@@ -209,16 +233,15 @@ int H5MicReader::readHeader(hid_t parId)
   return err;
 }
 
-#define MIC_READER_ALLOCATE_AND_READ(name, type)                                                                                                                                                       \
+#define MIC_READER_ALLOCATE_AND_READ(name, column, type)                                                                                                                                               \
   if(m_ReadAllArrays == true || m_ArrayNames.find(Mic::name) != m_ArrayNames.end())                                                                                                                    \
   {                                                                                                                                                                                                    \
-    type* _##name = allocateArray<type>(totalDataRows);                                                                                                                                                \
+    type* _##name = static_cast<type*>(m_ColumnArena.getColumn(arenaColumn++));                                                                                                                        \
     if(nullptr != _##name)                                                                                                                                                                             \
     {                                                                                                                                                                                                  \
-      ::memset(_##name, 0, numBytes);                                                                                                                                                                  \
       err = QH5Lite::readPointerDataset(gid, Mic::name, _##name);                                                                                                                                      \
     }                                                                                                                                                                                                  \
-    set##name##Pointer(_##name);                                                                                                                                                                       \
+    setColumnData(Mic::DataColumn::column, _##name);                                                                                                                                                   \
   }
 
 // -----------------------------------------------------------------------------
@@ -251,15 +274,31 @@ int H5MicReader::readData(hid_t parId)
   }
 
   setNumberOfElements(totalDataRows);
-  size_t numBytes = totalDataRows * sizeof(float);
-
-  MIC_READER_ALLOCATE_AND_READ(Euler1, float);
-  MIC_READER_ALLOCATE_AND_READ(Euler2, float);
-  MIC_READER_ALLOCATE_AND_READ(Euler3, float);
-  MIC_READER_ALLOCATE_AND_READ(Confidence, float);
-  MIC_READER_ALLOCATE_AND_READ(Phase, int);
-  MIC_READER_ALLOCATE_AND_READ(X, float);
-  MIC_READER_ALLOCATE_AND_READ(Y, float);
+
+  // The arrays share one block that is kept for the next slice, like the arrays MicReader reads
+  const QString columnNames[] = {Mic::Euler1, Mic::Euler2, Mic::Euler3, Mic::Confidence, Mic::Phase, Mic::X, Mic::Y};
+  size_t numColumns = 0;
+  for(const QString& name : columnNames)
+  {
+    numColumns += (m_ReadAllArrays || m_ArrayNames.contains(name)) ? 1 : 0;
+  }
+  if(!m_ColumnArena.layout(numColumns, totalDataRows, true))
+  {
+    H5Gclose(gid);
+    QString ss = QObject::tr("H5MicReader Error: Could not allocate the arrays for %1 points").arg(totalDataRows);
+    setErrorMessage(ss);
+    setErrorCode(-106);
+    return -106;
+  }
+  size_t arenaColumn = 0;
+
+  MIC_READER_ALLOCATE_AND_READ(Euler1, Euler1, float);
+  MIC_READER_ALLOCATE_AND_READ(Euler2, Euler2, float);
+  MIC_READER_ALLOCATE_AND_READ(Euler3, Euler3, float);
+  MIC_READER_ALLOCATE_AND_READ(Confidence, Confidence, float);
+  MIC_READER_ALLOCATE_AND_READ(Phase, Good, int);
+  MIC_READER_ALLOCATE_AND_READ(X, X, float);
+  MIC_READER_ALLOCATE_AND_READ(Y, Y, float);
 
   err = H5Gclose(gid);
 
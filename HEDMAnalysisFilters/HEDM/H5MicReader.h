@@ -116,6 +116,14 @@ class H5MicReader : public MicReader
      */
     int readFile() override;
 
+    /**
+     * @brief Reads the slice at the HDF5 path from a file that is already open, so a
+     * stack of slices can be read without opening the file for every one of them
+     * @param fileId Valid HDF5 file ID
+     * @return error condition
+     */
+    int readSlice(hid_t fileId);
+
     /**
      * @brief Reads the header section of the file
      * @param Valid HDF5 Group ID
@@ -162,6 +170,7 @@ class H5MicReader : public MicReader
   private:
     QVector<MicPhase::Pointer> m_Phases;
     QSet<QString> m_ArrayNames;
+    MicColumnArena m_ColumnArena;
     bool                  m_ReadAllArrays;
 
   public:
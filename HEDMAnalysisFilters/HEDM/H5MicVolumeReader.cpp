@@ -36,7 +36,16 @@
 
 #include "H5MicVolumeReader.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/concurrent_queue.h>
+#include <tbb/pipeline.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include <QtCore/QString>
 
@@ -51,6 +60,99 @@
 using namespace H5Support_NAMESPACE;
 #endif
 
+namespace
+{
+/**
+ * @brief Reads slices [zStart, zStart + numSlices) of a [z][y][x] dataset of the Volume
+ * group with a single read. Every slice lands in the middle of its xPoints * yPoints
+ * slab of dest, the same place the per slice Data groups are copied to.
+ * @param sliceDimensions The x and y dimensions of each slice that is read
+ */
+template <typename T>
+herr_t ReadVolumeArray(hid_t volumeGid, const QString& name, hsize_t zStart, const std::vector<int64_t>& sliceDimensions, hsize_t xPoints, hsize_t yPoints, T* dest)
+{
+  hsize_t numSlices = sliceDimensions.size() / 2;
+  hid_t datasetId = H5Dopen(volumeGid, name.toLatin1().data(), H5P_DEFAULT);
+  if(datasetId < 0)
+  {
+    return -1;
+  }
+  hid_t fileSpace = H5Dget_space(datasetId);
+  hsize_t memoryDims[3] = {numSlices, yPoints, xPoints};
+  hid_t memorySpace = H5Screate_simple(3, memoryDims, nullptr);
+  H5Sselect_none(fileSpace);
+  H5Sselect_none(memorySpace);
+
+  // Both selections run through the slices and their rows in the same order, so the
+  // union of the slice blocks maps every value of the file to its place in dest
+  herr_t err = 0;
+  for(hsize_t slice = 0; slice < numSlices && err >= 0; slice++)
+  {
+    hsize_t count[3] = {1, static_cast<hsize_t>(sliceDimensions[2 * slice + 1]), static_cast<hsize_t>(sliceDimensions[2 * slice])};
+    hsize_t fileStart[3] = {zStart + slice, 0, 0};
+    hsize_t memoryStart[3] = {slice, (yPoints - count[1]) / 2, (xPoints - count[2]) / 2};
+    if(count[1] == 0 || count[2] == 0)
+    {
+      continue;
+    }
+    err = H5Sselect_hyperslab(fileSpace, H5S_SELECT_OR, fileStart, nullptr, count, nullptr);
+    if(err >= 0)
+    {
+      err = H5Sselect_hyperslab(memorySpace, H5S_SELECT_OR, memoryStart, nullptr, count, nullptr);
+    }
+  }
+  if(err >= 0)
+  {
+    err = H5Dread(datasetId, QH5Lite::HDFTypeForPrimitive(T()), memorySpace, fileSpace, H5P_DEFAULT, dest);
+  }
+  H5Sclose(memorySpace);
+  H5Sclose(fileSpace);
+  H5Dclose(datasetId);
+  return err;
+}
+
+/**
+ * @brief A slice of H5MicVolumeReader::loadData() on its way from the reading to the
+ * placing stage
+ */
+struct LoadedMicSlice
+{
+  int64_t index = -1;
+  H5MicReader::Pointer reader;
+  int err = 0;
+};
+
+/**
+ * @brief Copies the rows of an xSlice * ySlice slice into the middle of slab z of dest,
+ * which holds slabs of xPoints * yPoints values
+ */
+template <typename T>
+void CopySliceRows(const T* source, size_t xSlice, size_t ySlice, T* dest, size_t z, size_t xPoints, size_t yPoints)
+{
+  if(nullptr == source || nullptr == dest)
+  {
+    return;
+  }
+  T* slab = dest + z * xPoints * yPoints + ((yPoints - ySlice) / 2) * xPoints + (xPoints - xSlice) / 2;
+  for(size_t j = 0; j < ySlice; j++)
+  {
+    std::copy(source + j * xSlice, source + (j + 1) * xSlice, slab + j * xPoints);
+  }
+}
+
+/**
+ * @brief Reverses the order of the numSlices slabs of sliceSize values
+ */
+template <typename T>
+void ReverseSlices(T* data, size_t numSlices, size_t sliceSize)
+{
+  for(size_t slice = 0; slice < numSlices / 2; slice++)
+  {
+    std::swap_ranges(data + slice * sliceSize, data + (slice + 1) * sliceSize, data + (numSlices - 1 - slice) * sliceSize);
+  }
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -231,29 +333,54 @@ QVector<MicPhase::Pointer> H5MicVolumeReader::getPhases()
 // -----------------------------------------------------------------------------
 int H5MicVolumeReader::loadData(int64_t xpoints, int64_t ypoints, int64_t zpoints, uint32_t ZDir)
 {
-  int index = 0;
   int err = -1;
   // Initialize all the pointers
   initPointers(xpoints * ypoints * zpoints);
 
-  int readerIndex = 0;
-  int xpointsslice = 0;
-  int ypointsslice = 0;
-  int xpointstemp = 0;
-  int ypointstemp = 0;
-  int xstop = 0;
-  int ystop = 0;
-  int zval = 0;
+  err = readVolumeInfo();
 
-  int xstartspot = 0;
-  int ystartspot = 0;
+  // The file stays open for all the slices, which also keeps its metadata cached
+  hid_t fileId = QH5Utilities::openFile(getFileName(), true);
+  if(fileId < 0)
+  {
+    std::cout << "H5MicDataLoader Error: Could not open the hdf5 file for reading." << std::endl;
+    return -1;
+  }
 
-  err = readVolumeInfo();
-  for(int slice = 0; slice < zpoints; ++slice)
+  // Files with a Volume group hold every array in one dataset that is read at once
+  if(H5Lexists(fileId, Mic::H5Mic::Volume.toLatin1().data(), H5P_DEFAULT) > 0)
+  {
+    err = loadVolumeData(fileId, xpoints, ypoints, zpoints, ZDir);
+  }
+  else
   {
+    err = loadSliceData(fileId, xpoints, ypoints, zpoints, ZDir);
+  }
+  QH5Utilities::closeFile(fileId);
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5MicVolumeReader::loadSliceData(hid_t fileId, int64_t xpoints, int64_t ypoints, int64_t zpoints, uint32_t ZDir)
+{
+  // If no stacking order preference was passed, read it from the file and use that value
+  if(ZDir == SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
+  {
+    ZDir = getStackingOrder();
+  }
+  size_t xPoints = static_cast<size_t>(xpoints);
+  size_t yPoints = static_cast<size_t>(ypoints);
+
+  // The first failure stops the slices that were not read yet
+  std::atomic<bool> failed(false);
+
+  // A reader keeps the block of its arrays for the next slice it reads, so the readers
+  // are set up once and reused instead of being created for every slice
+  auto newSliceReader = [&]() -> H5MicReader::Pointer {
     H5MicReader::Pointer reader = H5MicReader::New();
     reader->setFileName(getFileName());
-    reader->setHDF5Path(QString::number(slice + getSliceStart()));
     reader->setUserZDir(getStackingOrder());
     reader->setSampleTransformationAngle(getSampleTransformationAngle());
     reader->setSampleTransformationAxis(getSampleTransformationAxis());
@@ -261,94 +388,224 @@ int H5MicVolumeReader::loadData(int64_t xpoints, int64_t ypoints, int64_t zpoint
     reader->setEulerTransformationAxis(getEulerTransformationAxis());
     reader->readAllArrays(getReadAllArrays());
     reader->setArraysToRead(getArraysToRead());
-    err = reader->readFile();
-    if(err < 0)
+    return reader;
+  };
+
+  auto readSlice = [&](LoadedMicSlice slice) -> LoadedMicSlice {
+    slice.reader->setHDF5Path(QString::number(slice.index + getSliceStart()));
+    slice.err = slice.reader->readSlice(fileId);
+    if(slice.err < 0)
     {
-      std::cout << "H5MicDataLoader Error: There was an issue loading the data from the hdf5 file." << std::endl;
-      return -1;
+      failed = true;
     }
-    readerIndex = 0;
-    xpointsslice = reader->getXDimension();
-    ypointsslice = reader->getYDimension();
-    float* euler1Ptr = reader->getEuler1Pointer();
-    float* euler2Ptr = reader->getEuler2Pointer();
-    float* euler3Ptr = reader->getEuler3Pointer();
-    float* xPtr = reader->getXPointer();
-    float* yPtr = reader->getYPointer();
-    float* confPtr = reader->getConfidencePointer();
-    int* phasePtr = reader->getPhasePointer();
-
-    xpointstemp = static_cast<int>(xpoints);
-    ypointstemp = static_cast<int>(ypoints);
-    xstartspot = (xpointstemp - xpointsslice) / 2;
-    ystartspot = (ypointstemp - ypointsslice) / 2;
-    xstop = xpointsslice;
-    ystop = ypointsslice;
-
-    // If no stacking order preference was passed, read it from the file and use that value
-    if(ZDir == SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
+    return slice;
+  };
+
+  // Slices land in disjoint slabs of the arrays, so they are placed on any thread
+  auto placeSlice = [&](const LoadedMicSlice& slice) {
+    if(slice.err < 0 || nullptr == slice.reader)
     {
-      ZDir = getStackingOrder();
+      return;
     }
-    if(ZDir == SIMPL::RefFrameZDir::LowtoHigh)
+    H5MicReader& reader = *(slice.reader);
+    size_t xSlice = static_cast<size_t>(reader.getXDimension());
+    size_t ySlice = static_cast<size_t>(reader.getYDimension());
+    if(xSlice > xPoints || ySlice > yPoints)
     {
-      zval = slice;
+      failed = true;
+      return;
     }
+    size_t zval = static_cast<size_t>(slice.index);
     if(ZDir == SIMPL::RefFrameZDir::HightoLow)
     {
-      zval = static_cast<int>((zpoints - 1) - slice);
+      zval = static_cast<size_t>((zpoints - 1) - slice.index);
     }
 
-    // Copy the data from the current storage into the ReconstructionFunc Storage Location
-    for(int j = 0; j < ystop; j++)
+    CopySliceRows<float>(reader.getEuler1Pointer(), xSlice, ySlice, m_Euler1, zval, xPoints, yPoints);
+    CopySliceRows<float>(reader.getEuler2Pointer(), xSlice, ySlice, m_Euler2, zval, xPoints, yPoints);
+    CopySliceRows<float>(reader.getEuler3Pointer(), xSlice, ySlice, m_Euler3, zval, xPoints, yPoints);
+    CopySliceRows<float>(reader.getXPointer(), xSlice, ySlice, m_X, zval, xPoints, yPoints);
+    CopySliceRows<float>(reader.getYPointer(), xSlice, ySlice, m_Y, zval, xPoints, yPoints);
+    CopySliceRows<float>(reader.getConfidencePointer(), xSlice, ySlice, m_Conf, zval, xPoints, yPoints);
+    CopySliceRows<int>(reader.getPhasePointer(), xSlice, ySlice, m_Phase, zval, xPoints, yPoints);
+
+    /* For HEDM OIM Files if there is a single phase then the value of the phase
+     * data is zero (0). If there are 2 or more phases then the lowest value
+     * of phase is one (1). In the rest of the reconstruction code we follow the
+     * convention that the lowest value is One (1) even if there is only a single
+     * phase. The next loop converts all zeros to ones within the slice.
+     */
+    if(nullptr != reader.getPhasePointer() && nullptr != m_Phase)
     {
-      for(int i = 0; i < xstop; i++)
+      int* slab = m_Phase + zval * xPoints * yPoints;
+      for(size_t j = 0; j < ySlice; j++)
       {
-        index = (zval * xpointstemp * ypointstemp) + ((j + ystartspot) * xpointstemp) + (i + xstartspot);
-        if(nullptr != euler1Ptr)
-        {
-          m_Euler1[index] = euler1Ptr[readerIndex];
-        }
-        if(nullptr != euler2Ptr)
-        {
-          m_Euler2[index] = euler2Ptr[readerIndex];
-        }
-        if(nullptr != euler3Ptr)
-        {
-          m_Euler3[index] = euler3Ptr[readerIndex];
-        }
-        if(nullptr != xPtr)
-        {
-          m_X[index] = xPtr[readerIndex];
-        }
-        if(nullptr != yPtr)
-        {
-          m_Y[index] = yPtr[readerIndex];
-        }
-        if(nullptr != confPtr)
-        {
-          m_Conf[index] = confPtr[readerIndex];
-        }
-        if(nullptr != phasePtr)
-        {
-          m_Phase[index] = phasePtr[readerIndex];
-        } // Phase
-
-        /* For HEDM OIM Files if there is a single phase then the value of the phase
-         * data is zero (0). If there are 2 or more phases then the lowest value
-         * of phase is one (1). In the rest of the reconstruction code we follow the
-         * convention that the lowest value is One (1) even if there is only a single
-         * phase. The next if statement converts all zeros to ones if there is a single
-         * phase in the OIM data.
-         */
-        if(nullptr != phasePtr && m_Phase[index] < 1)
-        {
-          m_Phase[index] = 1;
-        }
-
-        ++readerIndex;
+        int* row = slab + (j + (yPoints - ySlice) / 2) * xPoints + (xPoints - xSlice) / 2;
+        std::replace_if(row, row + xSlice, [](int phase) { return phase < 1; }, 1);
       }
     }
+  };
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  size_t maxSlicesInFlight = 2 * static_cast<size_t>(tbb::task_scheduler_init::default_num_threads());
+
+  // HDF5 must not be called from two threads at once, so the slices are read one after
+  // the other by the serial first stage while the slices already read are placed. A
+  // reader goes back to the idle readers once its slice is placed, so there are never
+  // more readers than slices in flight.
+  tbb::concurrent_queue<H5MicReader::Pointer> idleReaders;
+  int64_t nextIndex = 0;
+  auto nextSlice = [&](tbb::flow_control& fc) -> LoadedMicSlice {
+    LoadedMicSlice slice;
+    if(nextIndex >= zpoints || failed)
+    {
+      fc.stop();
+      return slice;
+    }
+    slice.index = nextIndex++;
+    if(!idleReaders.try_pop(slice.reader))
+    {
+      slice.reader = newSliceReader();
+    }
+    return readSlice(slice);
+  };
+  auto placeAndReleaseSlice = [&](const LoadedMicSlice& slice) {
+    placeSlice(slice);
+    idleReaders.push(slice.reader);
+  };
+  tbb::parallel_pipeline(maxSlicesInFlight, tbb::make_filter<void, LoadedMicSlice>(tbb::filter::serial_in_order, nextSlice) &
+                                                tbb::make_filter<LoadedMicSlice, void>(tbb::filter::parallel, placeAndReleaseSlice));
+#else
+  LoadedMicSlice slice;
+  slice.reader = newSliceReader();
+  for(int64_t index = 0; index < zpoints && !failed; index++)
+  {
+    slice.index = index;
+    placeSlice(readSlice(slice));
   }
-  return err;
+#endif
+
+  if(failed)
+  {
+    std::cout << "H5MicDataLoader Error: There was an issue loading the data from the hdf5 file." << std::endl;
+    return -1;
+  }
+  return 0;
+}
+
+#define H5MICREADER_READ_VOLUME_ARRAY(name, var, type)                                                                                                                                                 \
+  if(nullptr != var && err >= 0)                                                                                                                                                                       \
+  {                                                                                                                                                                                                    \
+    err = ReadVolumeArray<type>(volumeGid, Mic::name, firstSlice, sliceDimensions, xPoints, yPoints, var);                                                                                             \
+    if(err >= 0 && reverse)                                                                                                                                                                            \
+    {                                                                                                                                                                                                  \
+      ReverseSlices<type>(var, numSlices, sliceSize);                                                                                                                                                  \
+    }                                                                                                                                                                                                  \
+  }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5MicVolumeReader::loadVolumeData(hid_t fileId, int64_t xpoints, int64_t ypoints, int64_t zpoints, uint32_t ZDir)
+{
+  hid_t volumeGid = H5Gopen(fileId, Mic::H5Mic::Volume.toLatin1().data(), H5P_DEFAULT);
+  if(volumeGid < 0)
+  {
+    std::cout << "H5MicDataLoader Error: Could not open the 'Volume' group of the hdf5 file." << std::endl;
+    return -1;
+  }
+
+  size_t numSlices = static_cast<size_t>(zpoints);
+  hsize_t xPoints = static_cast<hsize_t>(xpoints);
+  hsize_t yPoints = static_cast<hsize_t>(ypoints);
+  size_t sliceSize = static_cast<size_t>(xpoints * ypoints);
+  hsize_t firstSlice = static_cast<hsize_t>(getSliceStart());
+
+  // The x and y dimensions of every slice that is read
+  std::vector<int64_t> sliceDimensions(2 * numSlices, 0);
+  herr_t err = 0;
+  {
+    hid_t datasetId = H5Dopen(volumeGid, Mic::H5Mic::SliceDimensions.toLatin1().data(), H5P_DEFAULT);
+    hid_t fileSpace = (datasetId < 0) ? -1 : H5Dget_space(datasetId);
+    hsize_t extent[2] = {0, 0};
+    if(fileSpace >= 0)
+    {
+      H5Sget_simple_extent_dims(fileSpace, extent, nullptr);
+    }
+    err = (fileSpace < 0 || firstSlice + numSlices > extent[0]) ? -1 : 0;
+    if(err >= 0)
+    {
+      hsize_t start[2] = {firstSlice, 0};
+      hsize_t count[2] = {numSlices, 2};
+      hid_t memorySpace = H5Screate_simple(2, count, nullptr);
+      err = H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, start, nullptr, count, nullptr);
+      if(err >= 0)
+      {
+        err = H5Dread(datasetId, H5T_NATIVE_INT64, memorySpace, fileSpace, H5P_DEFAULT, sliceDimensions.data());
+      }
+      H5Sclose(memorySpace);
+    }
+    if(fileSpace >= 0)
+    {
+      H5Sclose(fileSpace);
+    }
+    if(datasetId >= 0)
+    {
+      H5Dclose(datasetId);
+    }
+  }
+  for(size_t slice = 0; slice < numSlices && err >= 0; slice++)
+  {
+    if(sliceDimensions[2 * slice] > xpoints || sliceDimensions[2 * slice + 1] > ypoints)
+    {
+      err = -1;
+    }
+  }
+  if(err < 0)
+  {
+    std::cout << "H5MicDataLoader Error: The slices of the 'Volume' group do not match the requested volume." << std::endl;
+    H5Gclose(volumeGid);
+    return -1;
+  }
+
+  // If no stacking order preference was passed, read it from the file and use that value
+  if(ZDir == SIMPL::RefFrameZDir::UnknownRefFrameZDirection)
+  {
+    ZDir = getStackingOrder();
+  }
+  bool reverse = (ZDir == SIMPL::RefFrameZDir::HightoLow);
+
+  H5MICREADER_READ_VOLUME_ARRAY(Euler1, m_Euler1, float)
+  H5MICREADER_READ_VOLUME_ARRAY(Euler2, m_Euler2, float)
+  H5MICREADER_READ_VOLUME_ARRAY(Euler3, m_Euler3, float)
+  H5MICREADER_READ_VOLUME_ARRAY(X, m_X, float)
+  H5MICREADER_READ_VOLUME_ARRAY(Y, m_Y, float)
+  H5MICREADER_READ_VOLUME_ARRAY(Confidence, m_Conf, float)
+  H5MICREADER_READ_VOLUME_ARRAY(Phase, m_Phase, int)
+  H5Gclose(volumeGid);
+  if(err < 0)
+  {
+    std::cout << "H5MicDataLoader Error: There was an issue loading the data from the hdf5 file." << std::endl;
+    return -1;
+  }
+
+  // A single phase is stored as zero, see loadData(). Only the points inside a slice are set.
+  if(nullptr != m_Phase)
+  {
+    for(size_t slice = 0; slice < numSlices; slice++)
+    {
+      size_t xSlice = static_cast<size_t>(sliceDimensions[2 * slice]);
+      size_t ySlice = static_cast<size_t>(sliceDimensions[2 * slice + 1]);
+      size_t zval = reverse ? (numSlices - 1 - slice) : slice;
+      size_t xStart = (xPoints - xSlice) / 2;
+      size_t yStart = (yPoints - ySlice) / 2;
+      for(size_t j = 0; j < ySlice; j++)
+      {
+        int* row = m_Phase + zval * sliceSize + (j + yStart) * xPoints + xStart;
+        std::replace_if(row, row + xSlice, [](int phase) { return phase < 1; }, 1);
+      }
+    }
+  }
+  return 0;
 }
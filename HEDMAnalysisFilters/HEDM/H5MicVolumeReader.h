@@ -118,6 +118,24 @@ class H5MicVolumeReader : public H5EbsdVolumeReader
   private:
     QVector<MicPhase::Pointer> m_Phases;
 
+    /**
+     * @brief Reads the slices from the [z][y][x] datasets of the Volume group, one read
+     * per array. Called by loadData() when the file has a Volume group.
+     * @param fileId The open HDF5 file
+     * @return error condition
+     */
+    int loadVolumeData(hid_t fileId, int64_t xpoints, int64_t ypoints, int64_t zpoints, uint32_t ZDir);
+
+    /**
+     * @brief Reads the slices from the Data groups of the slices through the open file.
+     * With SIMPL_USE_PARALLEL_ALGORITHMS the slices are read one at a time while worker
+     * threads copy the slices already read into the arrays row by row. The H5MicReaders
+     * that read the slices are reused once their slice has been copied.
+     * @param fileId The open HDF5 file
+     * @return error condition
+     */
+    int loadSliceData(hid_t fileId, int64_t xpoints, int64_t ypoints, int64_t zpoints, uint32_t ZDir);
+
 
     /**
      * @brief Allocats a contiguous chunk of memory to store values from the .Mic file
@@ -151,7 +169,7 @@ class H5MicVolumeReader : public H5EbsdVolumeReader
 #if defined ( SIMPL_USE_SSE ) && defined ( __SSE2__ )
         _mm_free(ptr );
 #else
-        delete[] ptr;
+        free(ptr);
 #endif
         ptr = nullptr;
         //       m_NumberOfElements = 0;
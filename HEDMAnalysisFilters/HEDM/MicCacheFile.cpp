@@ -0,0 +1,265 @@
+/* ============================================================================
+ * Copyright (c) 2010, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2010, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "MicCacheFile.h"
+
+#include <cstring>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+
+namespace
+{
+// "MICCACHE" as read from memory on a little endian machine
+const quint64 k_Magic = 0x454843414343494DULL;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicCacheFile::MicCacheFile(const QString& filePath)
+: m_File(filePath)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicCacheFile::~MicCacheFile()
+{
+  close();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString MicCacheFile::GenerateCacheFilePath(const QString& micFilePath)
+{
+  QFileInfo fi(micFilePath);
+  QString parentPath(fi.path());
+  // Only the .mic extension is dropped so the layers of a stack like sample.001.mic
+  // and sample.002.mic keep sidecars of their own
+  QString name = fi.completeBaseName() + "." + Mic::Cache::FileExt;
+  if(QDir::toNativeSeparators(parentPath).isEmpty())
+  {
+    return name;
+  }
+  return parentPath + QDir::separator() + name;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+quint64 MicCacheFile::HashContent(const char* begin, const char* end)
+{
+  const quint64 k_Multiplier = 0x9E3779B97F4A7C15ULL;
+  size_t size = static_cast<size_t>(end - begin);
+  quint64 hash = k_Multiplier ^ static_cast<quint64>(size);
+  const char* ptr = begin;
+  for(; ptr + sizeof(quint64) <= end; ptr += sizeof(quint64))
+  {
+    quint64 word = 0;
+    ::memcpy(&word, ptr, sizeof(quint64));
+    hash = (hash ^ (word * k_Multiplier)) * 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 31;
+  }
+  quint64 word = 0;
+  ::memcpy(&word, ptr, static_cast<size_t>(end - ptr));
+  hash = (hash ^ (word * k_Multiplier)) * 0xBF58476D1CE4E5B9ULL;
+  hash ^= hash >> 31;
+  return hash;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 MicCacheFile::Align(qint64 offset)
+{
+  return (offset + 7) & ~static_cast<qint64>(7);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicCacheFile::WriteFile(const QString& filePath, MicCacheHeader header, const QString& micFilePath, const QVector<const void*>& triangleArrays, const QVector<const void*>& cellArrays)
+{
+  if(triangleArrays.size() != Mic::Cache::NumTriangleArrays || cellArrays.size() != Mic::Cache::NumCellArrays)
+  {
+    return false;
+  }
+
+  QByteArray path = micFilePath.toUtf8();
+  header.magic = k_Magic;
+  header.version = Mic::Cache::FileVersion;
+  header.pathLength = static_cast<quint32>(path.size());
+
+  QString tempFilePath = filePath + ".tmp";
+  QFile out(tempFilePath);
+  if(!out.open(QIODevice::WriteOnly | QIODevice::Truncate))
+  {
+    return false;
+  }
+
+  const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  qint64 offset = sizeof(MicCacheHeader) + path.size();
+  bool ok = out.write(reinterpret_cast<const char*>(&header), sizeof(MicCacheHeader)) == sizeof(MicCacheHeader);
+  ok = ok && out.write(path) == path.size();
+  ok = ok && out.write(padding, Align(offset) - offset) == Align(offset) - offset;
+
+  qint64 numBytes = static_cast<qint64>(header.numTriangles * 4);
+  for(int i = 0; ok && i < triangleArrays.size(); i++)
+  {
+    ok = out.write(static_cast<const char*>(triangleArrays[i]), numBytes) == numBytes;
+    ok = ok && out.write(padding, Align(numBytes) - numBytes) == Align(numBytes) - numBytes;
+  }
+  numBytes = static_cast<qint64>(header.numCells * 4);
+  for(int i = 0; ok && i < cellArrays.size(); i++)
+  {
+    ok = out.write(static_cast<const char*>(cellArrays[i]), numBytes) == numBytes;
+    ok = ok && out.write(padding, Align(numBytes) - numBytes) == Align(numBytes) - numBytes;
+  }
+  out.close();
+
+  if(ok)
+  {
+    QFile::remove(filePath);
+    ok = QFile::rename(tempFilePath, filePath);
+  }
+  if(!ok)
+  {
+    QFile::remove(tempFilePath);
+  }
+  return ok;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicCacheFile::open(const QString& micFilePath, qint64 micFileSize, qint64 micLastModified)
+{
+  close();
+  if(!m_File.open(QIODevice::ReadOnly))
+  {
+    return false;
+  }
+  m_Size = m_File.size();
+  if(m_Size < static_cast<qint64>(sizeof(MicCacheHeader)))
+  {
+    close();
+    return false;
+  }
+  m_Data = m_File.map(0, m_Size);
+  if(nullptr == m_Data)
+  {
+    close();
+    return false;
+  }
+
+  ::memcpy(&m_Header, m_Data, sizeof(MicCacheHeader));
+  if(m_Header.magic != k_Magic || m_Header.version != Mic::Cache::FileVersion || m_Header.micFileSize != micFileSize || m_Header.micLastModified != micLastModified)
+  {
+    close();
+    return false;
+  }
+
+  QByteArray path = micFilePath.toUtf8();
+  qint64 offset = sizeof(MicCacheHeader);
+  if(m_Header.pathLength != static_cast<quint32>(path.size()) || offset + path.size() > m_Size || ::memcmp(m_Data + offset, path.constData(), path.size()) != 0)
+  {
+    close();
+    return false;
+  }
+
+  m_TrianglesOffset = Align(offset + path.size());
+  m_CellsOffset = m_TrianglesOffset + Mic::Cache::NumTriangleArrays * Align(static_cast<qint64>(m_Header.numTriangles * 4));
+  qint64 expectedSize = m_CellsOffset + Mic::Cache::NumCellArrays * Align(static_cast<qint64>(m_Header.numCells * 4));
+  if(expectedSize != m_Size || static_cast<quint64>(m_Header.xDim) * static_cast<quint64>(m_Header.yDim) != m_Header.numCells)
+  {
+    close();
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const MicCacheHeader& MicCacheFile::getHeader() const
+{
+  return m_Header;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const void* MicCacheFile::getTriangleArray(int index) const
+{
+  if(nullptr == m_Data || index < 0 || index >= Mic::Cache::NumTriangleArrays)
+  {
+    return nullptr;
+  }
+  return m_Data + m_TrianglesOffset + index * Align(static_cast<qint64>(m_Header.numTriangles * 4));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const void* MicCacheFile::getCellArray(int index) const
+{
+  if(nullptr == m_Data || index < 0 || index >= Mic::Cache::NumCellArrays)
+  {
+    return nullptr;
+  }
+  return m_Data + m_CellsOffset + index * Align(static_cast<qint64>(m_Header.numCells * 4));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicCacheFile::close()
+{
+  if(nullptr != m_Data)
+  {
+    m_File.unmap(m_Data);
+    m_Data = nullptr;
+  }
+  if(m_File.isOpen())
+  {
+    m_File.close();
+  }
+  m_Size = 0;
+  m_Header = MicCacheHeader();
+}
@@ -0,0 +1,168 @@
+/* ============================================================================
+ * Copyright (c) 2010, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2010, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QFile>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "MicConstants.h"
+
+/**
+ * @brief The fixed size block at the start of a .miccache file. All values are
+ * stored in the byte order of the machine that wrote the file, the magic value
+ * is used to reject files written on a machine with a different byte order.
+ */
+struct MicCacheHeader
+{
+  quint64 magic = 0;
+  quint32 version = 0;
+  quint32 pathLength = 0;     // Length of the UTF-8 .mic file path that follows the header
+  qint64 micFileSize = 0;     // Size in bytes of the .mic file
+  qint64 micLastModified = 0; // Modification time of the .mic file in ms since the epoch
+  quint64 contentHash = 0;    // MicCacheFile::HashContent() of the .mic file
+  qint32 xDim = 0;
+  qint32 yDim = 0;
+  float xRes = 0.0f;
+  float yRes = 0.0f;
+  float edgeLength = 0.0f; // Edge length of the refined triangles
+  qint32 level = 0;
+  float xOrigin = 0.0f; // Position of grid point (0, 0) in the units of the .mic file
+  float yOrigin = 0.0f;
+  quint64 numTriangles = 0;
+  quint64 numCells = 0;
+};
+
+/**
+ * @class MicCacheFile MicCacheFile.h HEDMAnalysisFilters/HEDM/MicCacheFile.h
+ * @brief Reads and writes the binary sidecar file that MicReader keeps next to a
+ * .mic file. The sidecar holds the parsed triangle table and the rasterized grid
+ * so that loading an unchanged .mic file again only needs to map the sidecar and
+ * copy the arrays out of it instead of parsing the text.
+ *
+ * The layout is the MicCacheHeader, the .mic file path, the triangle arrays in
+ * Mic::Cache::TriangleArray order and the grid arrays in Mic::Cache::CellArray order.
+ * Every array element is 4 bytes wide and every section starts on an 8 byte boundary.
+ *
+ * @date Oct 2026
+ * @version 1.0
+ */
+class MicCacheFile
+{
+  public:
+    /**
+     * @brief Opens the cache file at filePath
+     * @param filePath Path to the .miccache file
+     */
+    MicCacheFile(const QString& filePath);
+    virtual ~MicCacheFile();
+
+    /**
+     * @brief Returns the path of the cache file that belongs to the given .mic file
+     */
+    static QString GenerateCacheFilePath(const QString& micFilePath);
+
+    /**
+     * @brief Computes the 64 bit content hash of the bytes in [begin, end) that
+     * is stored in the cache file to detect changes to the .mic file.
+     */
+    static quint64 HashContent(const char* begin, const char* end);
+
+    /**
+     * @brief Writes a new cache file. The file is written under a temporary name
+     * and then renamed so that a reader never sees a partially written file.
+     * @param filePath Path to the .miccache file
+     * @param header The header values. The magic, version and pathLength are filled in.
+     * @param micFilePath The absolute path of the .mic file
+     * @param triangleArrays numTriangles values for each entry in Mic::Cache::TriangleArray
+     * @param cellArrays numCells values for each entry in Mic::Cache::CellArray
+     * @return true if the file was written
+     */
+    static bool WriteFile(const QString& filePath, MicCacheHeader header, const QString& micFilePath, const QVector<const void*>& triangleArrays, const QVector<const void*>& cellArrays);
+
+    /**
+     * @brief Maps the cache file and checks that it was written by this version for
+     * the given .mic file and that the size and modification time still match.
+     * The content hash is not checked here, see getHeader().
+     * @param micFilePath The absolute path of the .mic file
+     * @param micFileSize The current size of the .mic file
+     * @param micLastModified The current modification time of the .mic file
+     * @return true if the cache file can be used
+     */
+    bool open(const QString& micFilePath, qint64 micFileSize, qint64 micLastModified);
+
+    /**
+     * @brief Returns the header of an opened cache file
+     */
+    const MicCacheHeader& getHeader() const;
+
+    /**
+     * @brief Returns a pointer to the numTriangles values of a triangle array inside the mapped file
+     * @param index One of the Mic::Cache::TriangleArray values
+     */
+    const void* getTriangleArray(int index) const;
+
+    /**
+     * @brief Returns a pointer to the numCells values of a grid array inside the mapped file
+     * @param index One of the Mic::Cache::CellArray values
+     */
+    const void* getCellArray(int index) const;
+
+    /**
+     * @brief Unmaps and closes the cache file
+     */
+    void close();
+
+  private:
+    QFile m_File;
+    uchar* m_Data = nullptr;
+    qint64 m_Size = 0;
+    MicCacheHeader m_Header;
+    qint64 m_TrianglesOffset = 0;
+    qint64 m_CellsOffset = 0;
+
+    /**
+     * @brief Rounds an offset up to the next 8 byte boundary
+     */
+    static qint64 Align(qint64 offset);
+
+  public:
+    MicCacheFile(const MicCacheFile&) = delete;            // Copy Constructor Not Implemented
+    MicCacheFile(MicCacheFile&&) = delete;                 // Move Constructor Not Implemented
+    MicCacheFile& operator=(const MicCacheFile&) = delete; // Copy Assignment Not Implemented
+    MicCacheFile& operator=(MicCacheFile&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,234 @@
+/* ============================================================================
+ * Copyright (c) 2010, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2010, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "MicColumnArena.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace
+{
+const size_t k_HugePageSize = 2 * 1024 * 1024;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t RoundUp(size_t value, size_t multiple)
+{
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+char* AllocateBlock(size_t& numBytes, bool hugePages)
+{
+  size_t alignment = MicColumnArena::k_Alignment;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if(hugePages && numBytes >= k_HugePageSize)
+  {
+    alignment = k_HugePageSize;
+    numBytes = RoundUp(numBytes, k_HugePageSize);
+  }
+#else
+  (void)hugePages;
+#endif
+
+  void* block = nullptr;
+#if defined(_WIN32)
+  block = _aligned_malloc(numBytes, alignment);
+#else
+  if(posix_memalign(&block, alignment, numBytes) != 0)
+  {
+    block = nullptr;
+  }
+#endif
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if(nullptr != block && alignment == k_HugePageSize)
+  {
+    // Only a hint, the block works the same if the kernel does not back it with huge pages
+    madvise(block, numBytes, MADV_HUGEPAGE);
+  }
+#endif
+  return static_cast<char*>(block);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FreeBlock(char* block)
+{
+#if defined(_WIN32)
+  _aligned_free(block);
+#else
+  free(block);
+#endif
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicColumnArena::MicColumnArena() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicColumnArena::~MicColumnArena()
+{
+  release();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicColumnArena::layout(size_t numColumns, size_t numElements, bool zeroFill)
+{
+  // Every column is a 4 byte float or int
+  size_t columnBytes = numElements * 4;
+  size_t stride = RoundUp(columnBytes, k_Alignment);
+  size_t numBytes = numColumns * stride;
+  if(numBytes > m_Capacity)
+  {
+    release();
+    size_t capacity = numBytes;
+    m_Block = AllocateBlock(capacity, m_UseHugePages);
+    if(nullptr == m_Block)
+    {
+      return false;
+    }
+    m_Capacity = capacity;
+  }
+  m_NumColumns = numColumns;
+  m_NumElements = numElements;
+  m_ColumnStride = stride;
+  if(zeroFill)
+  {
+    for(size_t i = 0; i < numColumns; i++)
+    {
+      ::memset(m_Block + i * stride, 0, columnBytes);
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void* MicColumnArena::getColumn(size_t index) const
+{
+  if(nullptr == m_Block || index >= m_NumColumns)
+  {
+    return nullptr;
+  }
+  return m_Block + index * m_ColumnStride;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t MicColumnArena::getNumColumns() const
+{
+  return m_NumColumns;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t MicColumnArena::getNumElements() const
+{
+  return m_NumElements;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t MicColumnArena::getCapacity() const
+{
+  return m_Capacity;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicColumnArena::setUseHugePages(bool b)
+{
+  m_UseHugePages = b;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicColumnArena::getUseHugePages() const
+{
+  return m_UseHugePages;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicColumnArena::release()
+{
+  if(nullptr != m_Block)
+  {
+    FreeBlock(m_Block);
+  }
+  m_Block = nullptr;
+  m_Capacity = 0;
+  m_NumColumns = 0;
+  m_NumElements = 0;
+  m_ColumnStride = 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicColumnArena::swap(MicColumnArena& other)
+{
+  std::swap(m_Block, other.m_Block);
+  std::swap(m_Capacity, other.m_Capacity);
+  std::swap(m_NumColumns, other.m_NumColumns);
+  std::swap(m_NumElements, other.m_NumElements);
+  std::swap(m_ColumnStride, other.m_ColumnStride);
+}
@@ -0,0 +1,124 @@
+/* ============================================================================
+ * Copyright (c) 2010, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2010, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @class MicColumnArena MicColumnArena.h HEDMAnalysisFilters/HEDM/MicColumnArena.h
+ * @brief Holds the columns of one MicReader table, the parsed triangles or the grid,
+ * in a single block of memory. Every column starts on a 64 byte boundary so vector
+ * code can use aligned loads.
+ *
+ * The block is kept when the arena is laid out again for a table that fits, so a
+ * reader that reads layer after layer allocates and faults in its memory once
+ * instead of once per column and file.
+ *
+ * @date Oct 2026
+ * @version 1.0
+ */
+class MicColumnArena
+{
+  public:
+    MicColumnArena();
+    virtual ~MicColumnArena();
+
+    /**
+     * @brief The alignment of every column in bytes
+     */
+    static const size_t k_Alignment = 64;
+
+    /**
+     * @brief Lays out numColumns columns of numElements 4 byte values. The block is
+     * reused if it is large enough, otherwise it is replaced. The columns of the
+     * previous layout are invalid afterwards.
+     * @param numColumns Number of columns
+     * @param numElements Number of values in each column
+     * @param zeroFill Sets every value of every column to zero
+     * @return false if the memory could not be allocated. The arena is empty then.
+     */
+    bool layout(size_t numColumns, size_t numElements, bool zeroFill);
+
+    /**
+     * @brief Returns the start of a column of the current layout or nullptr
+     * @param index A column index less than the numColumns of layout()
+     */
+    void* getColumn(size_t index) const;
+
+    /**
+     * @brief Returns the numColumns and numElements of the current layout
+     */
+    size_t getNumColumns() const;
+    size_t getNumElements() const;
+
+    /**
+     * @brief Returns the number of bytes of the block
+     */
+    size_t getCapacity() const;
+
+    /**
+     * @brief When true blocks of 2 MB and more are aligned to 2 MB and marked for
+     * transparent huge pages, which saves page faults and TLB misses on large layers.
+     * This only has an effect on Linux.
+     */
+    void setUseHugePages(bool b);
+    bool getUseHugePages() const;
+
+    /**
+     * @brief Frees the block
+     */
+    void release();
+
+    /**
+     * @brief Exchanges the block and layout with another arena
+     */
+    void swap(MicColumnArena& other);
+
+  private:
+    char* m_Block = nullptr;
+    size_t m_Capacity = 0;
+    size_t m_NumColumns = 0;
+    size_t m_NumElements = 0;
+    size_t m_ColumnStride = 0;
+    bool m_UseHugePages = false;
+
+  public:
+    MicColumnArena(const MicColumnArena&) = delete;            // Copy Constructor Not Implemented
+    MicColumnArena(MicColumnArena&&) = delete;                 // Move Constructor Not Implemented
+    MicColumnArena& operator=(const MicColumnArena&) = delete; // Copy Assignment Not Implemented
+    MicColumnArena& operator=(MicColumnArena&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,135 @@
+/* ============================================================================
+ * Copyright (c) 2010, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2010, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class MicCompactCodec MicCompactCodec.h HEDMAnalysisFilters/HEDM/MicCompactCodec.h
+ * @brief Converts the Euler angles and confidences of a .mic file to and from the
+ * compact arrays that ReadMicData and ReadMicStack create on request under the
+ * Mic::CompactEulerAngles and Mic::CompactConfidence names.
+ *
+ * An Euler angle in degrees becomes a 16 bit code that splits a full turn into 65536
+ * steps, so angles outside of [0, 360) wrap around and every angle is off by at most
+ * half a step, plus the rounding of the float angle itself. A confidence becomes an
+ * 8 bit code that splits [0, 1] into 255 steps, values outside of [0, 1] are clamped.
+ * The array functions are plain loops over contiguous memory without branches so the
+ * compiler vectorizes them.
+ *
+ * @date Oct 2026
+ * @version 1.0
+ */
+class MicCompactCodec
+{
+  public:
+    /**
+     * @brief Degrees per Euler angle code and the largest error of a decoded angle
+     */
+    static constexpr float k_EulerStep = 360.0f / 65536.0f;
+    static constexpr float k_EulerMaxError = 0.5f * k_EulerStep;
+
+    /**
+     * @brief Confidence per confidence code and the largest error of a decoded
+     * confidence in [0, 1]
+     */
+    static constexpr float k_ConfidenceStep = 1.0f / 255.0f;
+    static constexpr float k_ConfidenceMaxError = 0.5f * k_ConfidenceStep;
+
+    /**
+     * @brief Returns the code of an Euler angle in degrees
+     */
+    static inline uint16_t encodeEulerAngle(float degrees)
+    {
+      // The nearest step as a signed integer, whose low 16 bits are the step modulo a full turn
+      int32_t nearest = static_cast<int32_t>(std::floor(degrees * (1.0f / k_EulerStep) + 0.5f));
+      return static_cast<uint16_t>(nearest & 0xFFFF);
+    }
+
+    /**
+     * @brief Returns the Euler angle in degrees of a code
+     */
+    static inline float decodeEulerAngle(uint16_t code)
+    {
+      return static_cast<float>(code) * k_EulerStep;
+    }
+
+    /**
+     * @brief Returns the code of a confidence
+     */
+    static inline uint8_t encodeConfidence(float confidence)
+    {
+      float clamped = confidence < 0.0f ? 0.0f : (confidence > 1.0f ? 1.0f : confidence);
+      return static_cast<uint8_t>(clamped * 255.0f + 0.5f);
+    }
+
+    /**
+     * @brief Returns the confidence of a code
+     */
+    static inline float decodeConfidence(uint8_t code)
+    {
+      return static_cast<float>(code) * k_ConfidenceStep;
+    }
+
+    /**
+     * @brief Encodes count Euler angles, for example numPoints * 3 interleaved angles
+     */
+    static void encodeEulerAngles(const float* degrees, uint16_t* codes, size_t count);
+
+    /**
+     * @brief Decodes count Euler angle codes into degrees
+     */
+    static void decodeEulerAngles(const uint16_t* codes, float* degrees, size_t count);
+
+    /**
+     * @brief Encodes count confidences
+     */
+    static void encodeConfidences(const float* confidences, uint8_t* codes, size_t count);
+
+    /**
+     * @brief Decodes count confidence codes
+     */
+    static void decodeConfidences(const uint8_t* codes, float* confidences, size_t count);
+
+  public:
+    MicCompactCodec() = delete;
+    MicCompactCodec(const MicCompactCodec&) = delete;            // Copy Constructor Not Implemented
+    MicCompactCodec(MicCompactCodec&&) = delete;                 // Move Constructor Not Implemented
+    MicCompactCodec& operator=(const MicCompactCodec&) = delete; // Copy Assignment Not Implemented
+    MicCompactCodec& operator=(MicCompactCodec&&) = delete;      // Move Assignment Not Implemented
+};
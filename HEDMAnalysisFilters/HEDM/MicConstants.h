@@ -69,8 +69,71 @@
 
   const QString FileVersionStr("FileVersion");
   const unsigned int FileVersion = 5;
+
+  /* Files with the Volume group are marked with this FileVersion */
+  const unsigned int VolumeFileVersion = 6;
+
+  /* The Volume group holds one [z][y][x] dataset per data array. Slices smaller than
+   * the volume start at y = x = 0 and SliceDimensions holds the x and y dimensions of
+   * every slice. */
+  const QString Volume("Volume");
+  const QString SliceDimensions("SliceDimensions");
+
+  /* Where H5MicImporter writes the data arrays. The per slice Header groups are always written. */
+  enum Layout
+  {
+    SliceGroups = 0, // A Data group per slice
+    SliceGroupsAndVolume,
+    VolumeOnly
+  };
+
+  /* How H5MicImporter stores the data arrays of a slice */
+  enum Compression
+  {
+    NoCompression = 0, // Contiguous and uncompressed like older files
+    DeflateCompression,
+    Lz4Compression,
+    ZstdCompression
+  };
+
+  /* The registered HDF5 filter ids of the codecs that need a filter plugin */
+  const int Lz4FilterId = 32004;
+  const int ZstdFilterId = 32015;
   } // namespace H5Mic
 
+  namespace Cache
+  {
+  const QString FileExt("miccache");
+  const unsigned int FileVersion = 4; // 4: the Y cell array holds the Y positions of the grid
+
+  /* The per triangle arrays in the order they are stored in a .miccache file */
+  enum TriangleArray
+  {
+    TriangleEuler1 = 0,
+    TriangleEuler2,
+    TriangleEuler3,
+    TriangleConfidence,
+    TrianglePhase,
+    TriangleUp,
+    TriangleX,
+    TriangleY,
+    NumTriangleArrays
+  };
+
+  /* The per grid cell arrays in the order they are stored in a .miccache file */
+  enum CellArray
+  {
+    CellEuler1 = 0,
+    CellEuler2,
+    CellEuler3,
+    CellConfidence,
+    CellPhase,
+    CellX,
+    CellY,
+    NumCellArrays
+  };
+  } // namespace Cache
+
     const QString Manufacturer("HEDM");
 
     DECLARE_STRING_CONST(Cubic)
@@ -159,6 +222,80 @@
     DECLARE_STRING_CONST(YRes)
     DECLARE_STRING_CONST(PhaseName)
 
+    /* Every value of the .config header that MicReader keeps, listed as ENTRY(type, name).
+     * The name is also the key of the value in the .config file. */
+#define MIC_HEADER_ENTRIES(ENTRY)                      \
+  ENTRY(QString, InfileBasename)                       \
+  ENTRY(int, InfileSerialLength)                       \
+  ENTRY(QString, OutfileBasename)                      \
+  ENTRY(int, OutfileSerialLength)                      \
+  ENTRY(QString, OutStructureBasename)                 \
+  ENTRY(int, BCPeakDetectorOffset)                     \
+  ENTRY(QString, InFileType)                           \
+  ENTRY(QString, OutfileExtension)                     \
+  ENTRY(QString, InfileExtesnion)                      \
+  ENTRY(float, BeamEnergyWidth)                        \
+  ENTRY(QString, BeamDirection)                        \
+  ENTRY(int, BeamDeflectionChiLaue)                    \
+  ENTRY(float, BeamHeight)                             \
+  ENTRY(float, BeamEnergy)                             \
+  ENTRY(QString, DetectorFilename)                     \
+  ENTRY(QString, OptimizationConstrainFilename)        \
+  ENTRY(int, EtaLimit)                                 \
+  ENTRY(QString, SampleFilename)                       \
+  ENTRY(QString, StructureFilename)                    \
+  ENTRY(QString, RotationRangeFilename)                \
+  ENTRY(QString, FundamentalZoneFilename)              \
+  ENTRY(QString, SampleSymmetry)                       \
+  ENTRY(float, MinAmplitudeFraction)                   \
+  ENTRY(int, MaxQ)                                     \
+  ENTRY(float, MaxInitSideLength)                      \
+  ENTRY(float, MinSideLength)                          \
+  ENTRY(float, LocalOrientationGridRadius)             \
+  ENTRY(float, MinLocalResolution)                     \
+  ENTRY(float, MaxLocalResolution)                     \
+  ENTRY(float, MaxAcceptedCost)                        \
+  ENTRY(float, MaxConvergenceCost)                     \
+  ENTRY(int, MaxMCSteps)                               \
+  ENTRY(float, MCRadiusScaleFactor)                    \
+  ENTRY(int, SuccessiveRestarts)                       \
+  ENTRY(int, SecondsBetweenSave)                       \
+  ENTRY(int, NumParameterOptimizationSteps)            \
+  ENTRY(int, NumElementToOptimizePerPE)                \
+  ENTRY(QString, OptimizationFilename)                 \
+  ENTRY(QString, DetectionLimitFilename)               \
+  ENTRY(float, ParameterMCInitTemperature)             \
+  ENTRY(QString, OrientationSearchMethod)              \
+  ENTRY(float, CoolingFraction)                        \
+  ENTRY(float, ThermalizeFraction)                     \
+  ENTRY(int, ParameterRefinements)                     \
+  ENTRY(int, NumDetectors)                             \
+  ENTRY(QString, DetectorSpacing)                      \
+  ENTRY(float, DetectorSpacingDeviation)               \
+  ENTRY(QString, DetectorOrientationDeviationInEuler)  \
+  ENTRY(float, DetectorOrientationDeviationInSO3)      \
+  ENTRY(int, ParamMCMaxLocalRestarts)                  \
+  ENTRY(int, ParamMCMaxGlobalRestarts)                 \
+  ENTRY(int, ParamMCNumGlobalSearchElements)           \
+  ENTRY(int, ConstrainedOptimization)                  \
+  ENTRY(int, SearchVolumeReductionFactor)              \
+  ENTRY(int, FileNumStart)                             \
+  ENTRY(int, FileNumEnd)                               \
+  ENTRY(QString, SampleLocation)                       \
+  ENTRY(QString, SampleOrientation)                    \
+  ENTRY(int, EnableStrain)                             \
+  ENTRY(QString, SampleCenter)                         \
+  ENTRY(float, SampleRadius)                           \
+  ENTRY(float, MaxDeepeningHitRatio)                   \
+  ENTRY(float, ConsistencyError)                       \
+  ENTRY(float, BraggFilterTolerance)                   \
+  ENTRY(float, MinAccelerationThreshold)               \
+  ENTRY(int, MaxDiscreteCandidates)                    \
+  ENTRY(int, XDim)                                     \
+  ENTRY(int, YDim)                                     \
+  ENTRY(float, XRes)                                   \
+  ENTRY(float, YRes)
+
     const QString Euler1("Euler1");
     const QString Euler2("Euler2");
     const QString Euler3("Euler3");
@@ -169,6 +306,58 @@
     const QString Level("Level");
     const QString Up("Up");
 
+    /* The names of the arrays that hold MicCompactCodec codes instead of the float Euler
+     * angles and confidences. They differ from the float names so that filters that expect
+     * float EulerAngles or Confidence arrays do not pick up the codes. */
+    const QString CompactEulerAngles("CompactEulerAngles");
+    const QString CompactConfidence("CompactConfidence");
+
+    /* The columns that MicReader only reads when they are asked for by name. Z is the
+     * third column of a data row. The reconstruction codes write 3 float and 6 int columns
+     * after the confidence (hit ratio, peak counts, ...) whose meaning depends on the code
+     * that wrote the file, so they are named after their 1 based position in the row. */
+    const QString Z("Z");
+    const QString Column11("Column11");
+    const QString Column12("Column12");
+    const QString Column13("Column13");
+    const QString Column14("Column14");
+    const QString Column15("Column15");
+    const QString Column16("Column16");
+    const QString Column17("Column17");
+    const QString Column18("Column18");
+    const QString Column19("Column19");
+
+  namespace DataColumn
+  {
+  /* The columns of a .mic data row in the order they appear in the row */
+  enum Index
+  {
+    X = 0,
+    Y,
+    Z,
+    Up,
+    Level,
+    Good,
+    Euler1,
+    Euler2,
+    Euler3,
+    Confidence,
+    Column11,
+    Column12,
+    Column13,
+    Column14,
+    Column15,
+    Column16,
+    Column17,
+    Column18,
+    Column19,
+    Count
+  };
+
+  /* The type of each column, 'f' for float and 'i' for int, in Index order */
+  const char Types[] = "fffiiifffffffiiiiii";
+  } // namespace DataColumn
+
 
   }
 
@@ -0,0 +1,261 @@
+/* ============================================================================
+ * Copyright (c) 2010, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2010, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "MicCoverageMap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <list>
+
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+
+#include "MicTriangleRasterizer.h"
+
+namespace
+{
+// Number of maps that are kept. A stack normally needs only one, the rest covers
+// stacks whose layers alternate between a few grids.
+const size_t k_MaxCachedMaps = 4;
+
+// Column of the spans that no cell covers
+const qint32 k_NoCell = std::numeric_limits<qint32>::min();
+
+QMutex& CacheMutex()
+{
+  static QMutex mutex;
+  return mutex;
+}
+
+std::list<MicCoverageMap::Pointer>& CachedMaps()
+{
+  static std::list<MicCoverageMap::Pointer> maps; // Most recently used first
+  return maps;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicCoverageMap::MicCoverageMap() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicCoverageMap::~MicCoverageMap() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicCoverageMap::Pointer MicCoverageMap::Get(int xDim, int yDim, float spacing, float xOrigin, float yOrigin, const MicLattice& lattice, int level, bool parallel)
+{
+  {
+    QMutexLocker locker(&CacheMutex());
+    std::list<Pointer>& maps = CachedMaps();
+    for(std::list<Pointer>::iterator iter = maps.begin(); iter != maps.end(); ++iter)
+    {
+      const MicCoverageMap& map = *(*iter);
+      int columnOffset = 0;
+      int rowOffset = 0;
+      if(map.m_XDim == xDim && map.m_YDim == yDim && map.m_Spacing == spacing && map.m_XOrigin == xOrigin && map.m_YOrigin == yOrigin && map.m_Level == level &&
+         map.findCellOffset(lattice, columnOffset, rowOffset))
+      {
+        maps.splice(maps.begin(), maps, iter);
+        return maps.front();
+      }
+    }
+  }
+
+  Pointer map(new MicCoverageMap());
+  map->m_XDim = xDim;
+  map->m_YDim = yDim;
+  map->m_Spacing = spacing;
+  map->m_XOrigin = xOrigin;
+  map->m_YOrigin = yOrigin;
+  map->m_EdgeLength = lattice.getEdgeLength();
+  map->m_Level = level;
+  map->m_LatticeXOrigin = lattice.getXOrigin();
+  map->m_LatticeYOrigin = lattice.getYOrigin();
+  map->m_UpAtOrigin = lattice.isUpCell(0, 0);
+
+  // Every cell whose triangle can reach the grid, wherever the lattice holds a triangle or not.
+  // A triangle reaches one edge length to the right of its left vertex and one row up.
+  size_t numPoints = (xDim > 0 && yDim > 0) ? static_cast<size_t>(xDim) * static_cast<size_t>(yDim) : 0;
+  float halfEdge = map->m_EdgeLength / 2.0f;
+  float height = map->m_EdgeLength * sqrtf(3.0f) / 2.0f;
+  int columnBegin = static_cast<int>(std::floor((xOrigin - map->m_LatticeXOrigin) / halfEdge)) - 2;
+  int columnEnd = static_cast<int>(std::ceil((xOrigin + static_cast<float>(xDim - 1) * spacing - map->m_LatticeXOrigin) / halfEdge)) + 1;
+  int rowBegin = static_cast<int>(std::floor((yOrigin - map->m_LatticeYOrigin) / height)) - 1;
+  int rowEnd = static_cast<int>(std::ceil((yOrigin + static_cast<float>(yDim - 1) * spacing - map->m_LatticeYOrigin) / height)) + 1;
+  std::vector<qint32> cellColumns;
+  std::vector<qint32> cellRows;
+  std::vector<float> triX;
+  std::vector<float> triY;
+  std::vector<int> triUp;
+  if(numPoints > 0 && halfEdge > 0.0f)
+  {
+    size_t numCells = static_cast<size_t>(columnEnd - columnBegin) * static_cast<size_t>(rowEnd - rowBegin);
+    cellColumns.reserve(numCells);
+    cellRows.reserve(numCells);
+    triX.reserve(numCells);
+    triY.reserve(numCells);
+    triUp.reserve(numCells);
+    for(int row = rowBegin; row < rowEnd; row++)
+    {
+      for(int column = columnBegin; column < columnEnd; column++)
+      {
+        // The left vertex the same way MicLattice::getLeftVertex() places it
+        bool up = map->isUpCell(column, row);
+        cellColumns.push_back(column);
+        cellRows.push_back(row);
+        triX.push_back(map->m_LatticeXOrigin + static_cast<float>(column) * halfEdge);
+        triY.push_back(map->m_LatticeYOrigin + static_cast<float>(row + (up ? 0 : 1)) * height);
+        triUp.push_back(up ? 1 : 2);
+      }
+    }
+  }
+
+  std::vector<int> owners(numPoints, -1);
+  if(!triX.empty())
+  {
+    MicTriangleRasterizer rasterizer(xDim, yDim, spacing, xOrigin, yOrigin);
+    rasterizer.setParallel(parallel);
+    rasterizer.rasterize(triX.data(), triY.data(), triUp.data(), triX.size(), map->m_EdgeLength, owners.data());
+  }
+
+  // Neighboring grid points are usually closer than a cell is wide, so runs of points in
+  // one cell are stored once
+  size_t point = 0;
+  while(point < numPoints)
+  {
+    int owner = owners[point];
+    size_t end = point + 1;
+    while(end < numPoints && owners[end] == owner && end - point < std::numeric_limits<quint32>::max())
+    {
+      ++end;
+    }
+    Span span;
+    span.column = (owner < 0) ? k_NoCell : cellColumns[owner];
+    span.row = (owner < 0) ? 0 : cellRows[owner];
+    span.length = static_cast<quint32>(end - point);
+    map->m_Spans.push_back(span);
+    point = end;
+  }
+  map->m_Spans.shrink_to_fit();
+
+  QMutexLocker locker(&CacheMutex());
+  std::list<Pointer>& maps = CachedMaps();
+  maps.push_front(map);
+  if(maps.size() > k_MaxCachedMaps)
+  {
+    maps.pop_back();
+  }
+  return map;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicCoverageMap::ClearCache()
+{
+  QMutexLocker locker(&CacheMutex());
+  CachedMaps().clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicCoverageMap::findOwners(const MicLattice& lattice, int* owners) const
+{
+  size_t numPoints = (m_XDim > 0 && m_YDim > 0) ? static_cast<size_t>(m_XDim) * static_cast<size_t>(m_YDim) : 0;
+  int columnOffset = 0;
+  int rowOffset = 0;
+  if(!findCellOffset(lattice, columnOffset, rowOffset))
+  {
+    std::fill(owners, owners + numPoints, -1);
+    return false;
+  }
+
+  size_t point = 0;
+  for(const Span& span : m_Spans)
+  {
+    qint64 triangle = (span.column == k_NoCell) ? MicLattice::k_NoTriangle : lattice.findTriangle(span.column - columnOffset, span.row - rowOffset);
+    std::fill(owners + point, owners + point + span.length, static_cast<int>(triangle));
+    point += span.length;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t MicCoverageMap::getNumberOfSpans() const
+{
+  return m_Spans.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicCoverageMap::findCellOffset(const MicLattice& lattice, int& columnOffset, int& rowOffset) const
+{
+  if(lattice.getEdgeLength() != m_EdgeLength || m_EdgeLength <= 0.0f)
+  {
+    return false;
+  }
+
+  // The origin of a lattice is the lowest left vertex of its triangles, so the lattices of two
+  // layers are the same if their origins are a whole number of cells apart. Allow for the
+  // rounding of the coordinates in the file the same way MicLattice::build() does.
+  float u = (lattice.getXOrigin() - m_LatticeXOrigin) / (m_EdgeLength / 2.0f);
+  float v = (lattice.getYOrigin() - m_LatticeYOrigin) / (m_EdgeLength * sqrtf(3.0f) / 2.0f);
+  columnOffset = static_cast<int>(std::lround(u));
+  rowOffset = static_cast<int>(std::lround(v));
+  if(std::fabs(u - static_cast<float>(columnOffset)) > 0.1f || std::fabs(v - static_cast<float>(rowOffset)) > 0.1f)
+  {
+    return false;
+  }
+  // Cell (0, 0) of the lattice is cell (columnOffset, rowOffset) of the map and has to point the same way
+  return lattice.isUpCell(0, 0) == isUpCell(columnOffset, rowOffset);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicCoverageMap::isUpCell(int column, int row) const
+{
+  return (((column + row) & 1) == 0) == m_UpAtOrigin;
+}
@@ -0,0 +1,147 @@
+/* ============================================================================
+ * Copyright (c) 2010, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2010, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+#include "EbsdLib/EbsdSetGetMacros.h"
+
+#include "MicLattice.h"
+
+/**
+ * @class MicCoverageMap MicCoverageMap.h HEDMAnalysisFilters/HEDM/MicCoverageMap.h
+ * @brief Holds which cell of a triangle lattice covers each point of the grid that a
+ * .mic file is resampled onto, as spans of grid points that share a cell.
+ *
+ * The layers of a z-stack are reconstructed on the same triangle lattice, only the
+ * triangles that each layer holds differ. The map is therefore built for every cell of
+ * the lattice that reaches the grid, with MicTriangleRasterizer, and findOwners() turns
+ * it into the triangles of one layer by looking up the triangle of each span in the
+ * MicLattice of that layer. Get() keeps the most recently built maps in a small process
+ * wide cache keyed by the grid, the edge length, the level and the position of the
+ * lattice, so the geometric work is done once per stack and every layer is a gather.
+ *
+ * @date Oct 2026
+ * @version 1.0
+ */
+class MicCoverageMap
+{
+  public:
+    EBSD_SHARED_POINTERS(MicCoverageMap)
+
+    virtual ~MicCoverageMap();
+
+    /**
+     * @brief Returns the coverage map of a lattice on the given grid. A map that was built
+     * earlier for the same grid and a lattice with the same edge length, level and cells
+     * is reused, otherwise the cells are rasterized and the new map is added to the cache.
+     * @param xDim Number of grid points along X
+     * @param yDim Number of grid points along Y
+     * @param spacing Distance between grid points
+     * @param xOrigin X coordinate of grid point (0, 0)
+     * @param yOrigin Y coordinate of grid point (0, 0)
+     * @param lattice The lattice of the triangles
+     * @param level The level the triangles were refined to
+     * @param parallel Passed to MicTriangleRasterizer::setParallel() if the map has to be built
+     */
+    static Pointer Get(int xDim, int yDim, float spacing, float xOrigin, float yOrigin, const MicLattice& lattice, int level, bool parallel);
+
+    /**
+     * @brief Removes every map from the cache
+     */
+    static void ClearCache();
+
+    /**
+     * @brief Finds the triangle of the lattice that covers each grid point
+     * @param lattice The lattice of the triangles, which may hold any subset of the cells
+     * @param owners xDim * yDim values (out). The index of the covering triangle or -1.
+     * @return false if the lattice is not the one of the map, every owner is -1 then
+     */
+    bool findOwners(const MicLattice& lattice, int* owners) const;
+
+    /**
+     * @brief Returns the number of spans of grid points that share a cell
+     */
+    size_t getNumberOfSpans() const;
+
+  protected:
+    MicCoverageMap();
+
+  private:
+    /**
+     * @brief Grid points [begin, begin + length) lie in one cell, in the coordinates of
+     * the lattice the map was built for. The spans cover the grid points in order.
+     */
+    struct Span
+    {
+      qint32 column;
+      qint32 row;
+      quint32 length;
+    };
+
+    int m_XDim = 0;
+    int m_YDim = 0;
+    float m_Spacing = 0.0f;
+    float m_XOrigin = 0.0f;
+    float m_YOrigin = 0.0f;
+    float m_EdgeLength = 0.0f;
+    int m_Level = 0;
+    float m_LatticeXOrigin = 0.0f;
+    float m_LatticeYOrigin = 0.0f;
+    bool m_UpAtOrigin = true;
+    std::vector<Span> m_Spans;
+
+    /**
+     * @brief Finds the offset that takes the cells of a lattice to the cells of the map
+     * @return false if the lattice is not the one of the map
+     */
+    bool findCellOffset(const MicLattice& lattice, int& columnOffset, int& rowOffset) const;
+
+    /**
+     * @brief Returns whether the triangle of a cell of the map points up
+     */
+    bool isUpCell(int column, int row) const;
+
+  public:
+    MicCoverageMap(const MicCoverageMap&) = delete;            // Copy Constructor Not Implemented
+    MicCoverageMap(MicCoverageMap&&) = delete;                 // Move Constructor Not Implemented
+    MicCoverageMap& operator=(const MicCoverageMap&) = delete; // Copy Assignment Not Implemented
+    MicCoverageMap& operator=(MicCoverageMap&&) = delete;      // Move Assignment Not Implemented
+};
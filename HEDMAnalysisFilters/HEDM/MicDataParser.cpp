@@ -0,0 +1,361 @@
+/* ============================================================================
+ * Copyright (c) 2010, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2010, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "MicDataParser.h"
+
+#include <cfloat>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace
+{
+/* Every power of ten up to 1e22 is exactly representable as a double */
+const double k_PowersOfTen[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+const int k_MaxExactPowerOfTen = 22;
+const int k_MaxSignificantDigits = 19;
+const uint64_t k_MaxExactMantissa = (static_cast<uint64_t>(1) << 53);
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+inline bool isDigit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+// -----------------------------------------------------------------------------
+// Returns true if the double lies exactly half way between two adjacent floats.
+// The value must be within the range of normal floats. Rounding such a value to
+// float could differ from rounding the original decimal string directly.
+// -----------------------------------------------------------------------------
+inline bool isFloatHalfway(double value)
+{
+  uint64_t bits = 0;
+  ::memcpy(&bits, &value, sizeof(bits));
+  // A double carries 29 more fraction bits than a float
+  const uint64_t lowMask = (static_cast<uint64_t>(1) << 29) - 1;
+  const uint64_t halfBit = (static_cast<uint64_t>(1) << 28);
+  return (bits & lowMask) == halfBit;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const char* MicDataParser::findLineEnd(const char* ptr, const char* end)
+{
+  if(ptr >= end)
+  {
+    return end;
+  }
+  const void* newLine = ::memchr(ptr, '\n', static_cast<size_t>(end - ptr));
+  return (nullptr == newLine) ? end : static_cast<const char*>(newLine);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t MicDataParser::countRows(const char* begin, const char* end)
+{
+  size_t numRows = 0;
+  const char* ptr = begin;
+  while(ptr < end)
+  {
+    const char* lineEnd = findLineEnd(ptr, end);
+    if(!isBlank(ptr, lineEnd))
+    {
+      ++numRows;
+    }
+    ptr = (lineEnd < end) ? lineEnd + 1 : end;
+  }
+  return numRows;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t MicDataParser::countRowsInBox(const char* begin, const char* end, float xMin, float xMax, float yMin, float yMax)
+{
+  size_t numRows = 0;
+  const char* ptr = begin;
+  while(ptr < end)
+  {
+    const char* lineEnd = findLineEnd(ptr, end);
+    if(!isBlank(ptr, lineEnd))
+    {
+      const char* token = ptr;
+      float x = -1.0f;
+      float y = -1.0f;
+      if(!scanFloat(token, lineEnd, x))
+      {
+        x = -1.0f;
+      }
+      else if(!scanFloat(token, lineEnd, y))
+      {
+        y = -1.0f;
+      }
+      // The same test MicReader::parseDataLine() drops the row with
+      if(!(x < xMin || x > xMax || y < yMin || y > yMax))
+      {
+        ++numRows;
+      }
+    }
+    ptr = (lineEnd < end) ? lineEnd + 1 : end;
+  }
+  return numRows;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<const char*> MicDataParser::findChunkBoundaries(const char* begin, const char* end, size_t numChunks)
+{
+  std::vector<const char*> boundaries(1, begin);
+  if(numChunks == 0)
+  {
+    numChunks = 1;
+  }
+  size_t totalSize = static_cast<size_t>(end - begin);
+  for(size_t i = 1; i < numChunks; ++i)
+  {
+    // Move the nominal split point forward to the start of the next line
+    const char* split = begin + (totalSize / numChunks) * i;
+    if(split <= boundaries.back())
+    {
+      continue;
+    }
+    const char* lineEnd = findLineEnd(split - 1, end);
+    split = (lineEnd < end) ? lineEnd + 1 : end;
+    if(split >= end)
+    {
+      break;
+    }
+    boundaries.push_back(split);
+  }
+  boundaries.push_back(end);
+  return boundaries;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicDataParser::scanFloat(const char*& ptr, const char* end, float& value)
+{
+  const char* p = skipWhiteSpace(ptr, end);
+  bool negative = false;
+  if(p < end && (*p == '+' || *p == '-'))
+  {
+    negative = (*p == '-');
+    ++p;
+  }
+  // Hex floats, nan and inf are left to strtof()
+  if(p < end && !isDigit(*p) && *p != '.')
+  {
+    return scanFloatSlow(ptr, end, value);
+  }
+  if(p + 1 < end && p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+  {
+    return scanFloatSlow(ptr, end, value);
+  }
+
+  uint64_t mantissa = 0;
+  int numDigits = 0;
+  int exponent = 0;
+  bool truncated = false;
+  bool sawDigit = false;
+
+  while(p < end && isDigit(*p))
+  {
+    sawDigit = true;
+    if(numDigits < k_MaxSignificantDigits)
+    {
+      mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+      if(mantissa != 0)
+      {
+        ++numDigits;
+      }
+    }
+    else
+    {
+      ++exponent;
+      truncated = truncated || (*p != '0');
+    }
+    ++p;
+  }
+
+  if(p < end && *p == '.')
+  {
+    ++p;
+    while(p < end && isDigit(*p))
+    {
+      sawDigit = true;
+      if(numDigits < k_MaxSignificantDigits)
+      {
+        mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+        if(mantissa != 0)
+        {
+          ++numDigits;
+        }
+        --exponent;
+      }
+      else
+      {
+        truncated = truncated || (*p != '0');
+      }
+      ++p;
+    }
+  }
+
+  if(!sawDigit)
+  {
+    return scanFloatSlow(ptr, end, value);
+  }
+
+  // sscanf() consumes a dangling 'e' or 'e+' even though it does not change the value
+  if(p < end && (*p == 'e' || *p == 'E'))
+  {
+    const char* q = p + 1;
+    bool negativeExponent = false;
+    if(q < end && (*q == '+' || *q == '-'))
+    {
+      negativeExponent = (*q == '-');
+      ++q;
+    }
+    if(q < end && isDigit(*q))
+    {
+      int expValue = 0;
+      while(q < end && isDigit(*q))
+      {
+        if(expValue < 100000)
+        {
+          expValue = expValue * 10 + (*q - '0');
+        }
+        ++q;
+      }
+      exponent += negativeExponent ? -expValue : expValue;
+    }
+    p = q;
+  }
+
+  if(mantissa == 0)
+  {
+    value = negative ? -0.0f : 0.0f;
+    ptr = p;
+    return true;
+  }
+
+  if(truncated || mantissa > k_MaxExactMantissa || exponent < -k_MaxExactPowerOfTen || exponent > k_MaxExactPowerOfTen)
+  {
+    return scanFloatSlow(ptr, end, value);
+  }
+
+  // Both operands are exact so this is a single correctly rounded operation
+  double result = static_cast<double>(mantissa);
+  if(exponent < 0)
+  {
+    result = result / k_PowersOfTen[-exponent];
+  }
+  else
+  {
+    result = result * k_PowersOfTen[exponent];
+  }
+
+  if(result < static_cast<double>(FLT_MIN) || result > static_cast<double>(FLT_MAX) || isFloatHalfway(result))
+  {
+    return scanFloatSlow(ptr, end, value);
+  }
+
+  float f = static_cast<float>(result);
+  value = negative ? -f : f;
+  ptr = p;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicDataParser::scanFloatSlow(const char*& ptr, const char* end, float& value)
+{
+  const char* p = skipWhiteSpace(ptr, end);
+  const char* tokenEnd = p;
+  while(tokenEnd < end && !isWhiteSpace(*tokenEnd))
+  {
+    ++tokenEnd;
+  }
+  // strtof() needs a nul terminated string
+  std::string token(p, tokenEnd);
+  char* stop = nullptr;
+  float f = std::strtof(token.c_str(), &stop);
+  if(stop == token.c_str())
+  {
+    return false;
+  }
+  value = f;
+  ptr = p + (stop - token.c_str());
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicDataParser::scanInt(const char*& ptr, const char* end, int& value)
+{
+  const char* p = skipWhiteSpace(ptr, end);
+  bool negative = false;
+  if(p < end && (*p == '+' || *p == '-'))
+  {
+    negative = (*p == '-');
+    ++p;
+  }
+  if(p >= end || !isDigit(*p))
+  {
+    return false;
+  }
+  int64_t accum = 0;
+  while(p < end && isDigit(*p))
+  {
+    if(accum < (static_cast<int64_t>(1) << 40))
+    {
+      accum = accum * 10 + (*p - '0');
+    }
+    ++p;
+  }
+  value = static_cast<int>(negative ? -accum : accum);
+  ptr = p;
+  return true;
+}
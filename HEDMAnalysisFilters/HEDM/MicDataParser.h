@@ -0,0 +1,174 @@
+/* ============================================================================
+ * Copyright (c) 2010, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2010, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class MicDataParser MicDataParser.h HEDMAnalysisFilters/HEDM/MicDataParser.h
+ * @brief Scans the numeric columns of a HEDM .mic data row directly out of a range
+ * of characters (for example a memory mapped file) so that parsing a row does not
+ * need any heap allocation. The plain decimal notation written by the HEDM
+ * reconstruction codes is converted without consulting the C locale and the result
+ * is bit-for-bit the same value that sscanf("%f") and sscanf("%d") produce for the
+ * same text. The rare inputs that are handed to strtof() get exactly the conversion
+ * that sscanf() would have performed.
+ *
+ * Each scan function skips leading white space, converts the longest prefix that
+ * forms a number and advances the pointer past it. If no number could be converted
+ * the pointer is left untouched and false is returned, which mirrors how sscanf
+ * stops at the first failed conversion.
+ *
+ * @date Oct 2026
+ * @version 1.0
+ */
+class MicDataParser
+{
+  public:
+    /**
+     * @brief Returns true if the character is one of the white space characters that sscanf skips
+     */
+    static inline bool isWhiteSpace(char c)
+    {
+      return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    /**
+     * @brief Returns a pointer to the first non white space character in [ptr, end)
+     */
+    static inline const char* skipWhiteSpace(const char* ptr, const char* end)
+    {
+      while(ptr < end && isWhiteSpace(*ptr))
+      {
+        ++ptr;
+      }
+      return ptr;
+    }
+
+    /**
+     * @brief Returns true if the range only contains white space characters
+     */
+    static inline bool isBlank(const char* begin, const char* end)
+    {
+      return skipWhiteSpace(begin, end) == end;
+    }
+
+    /**
+     * @brief Skips leading white space and the run of non white space characters after it
+     * without converting them. This is how a column that is not needed is passed over.
+     * @param ptr Current position. Advanced past the token on success
+     * @param end One past the last character that may be read
+     * @return true if there was a token to skip
+     */
+    static inline bool skipToken(const char*& ptr, const char* end)
+    {
+      const char* next = skipWhiteSpace(ptr, end);
+      if(next == end)
+      {
+        return false;
+      }
+      while(next < end && !isWhiteSpace(*next))
+      {
+        ++next;
+      }
+      ptr = next;
+      return true;
+    }
+
+    /**
+     * @brief Returns a pointer to the next '\n' in [ptr, end) or end if there is none
+     */
+    static const char* findLineEnd(const char* ptr, const char* end);
+
+    /**
+     * @brief Counts the lines in [begin, end) that contain anything other than white space.
+     * These are exactly the lines that are handed to the row parser.
+     */
+    static size_t countRows(const char* begin, const char* end);
+
+    /**
+     * @brief Counts the rows in [begin, end) whose first two columns, the X and Y of the
+     * row, lie inside the box. Only those two columns are converted. A row that is too
+     * short to hold them counts with the position -1 the way MicReader parses it.
+     */
+    static size_t countRowsInBox(const char* begin, const char* end, float xMin, float xMax, float yMin, float yMax);
+
+    /**
+     * @brief Splits [begin, end) into at most numChunks pieces of roughly equal size
+     * that all start at the beginning of a line, so each piece can be parsed on its own.
+     * @param begin Start of the first line
+     * @param end One past the end of the data
+     * @param numChunks The requested number of chunks
+     * @return The chunk boundaries. Chunk i is [boundaries[i], boundaries[i + 1]) so
+     * the returned vector has one more entry than there are chunks.
+     */
+    static std::vector<const char*> findChunkBoundaries(const char* begin, const char* end, size_t numChunks);
+
+    /**
+     * @brief Scans a single precision floating point value.
+     * @param ptr Current position. Advanced past the value on success
+     * @param end One past the last character that may be read
+     * @param value The converted value (out)
+     * @return true if a value was converted
+     */
+    static bool scanFloat(const char*& ptr, const char* end, float& value);
+
+    /**
+     * @brief Scans a decimal integer value.
+     * @param ptr Current position. Advanced past the value on success
+     * @param end One past the last character that may be read
+     * @param value The converted value (out)
+     * @return true if a value was converted
+     */
+    static bool scanInt(const char*& ptr, const char* end, int& value);
+
+  private:
+    /**
+     * @brief Converts the value with strtof(). This is only used for the rare inputs
+     * where the fast conversion can not guarantee a correctly rounded result (more
+     * than 19 significant digits, very large or very small exponents, hex floats,
+     * nan/inf and values that land exactly half way between two floats).
+     */
+    static bool scanFloatSlow(const char*& ptr, const char* end, float& value);
+
+  public:
+    MicDataParser() = delete;
+    MicDataParser(const MicDataParser&) = delete;            // Copy Constructor Not Implemented
+    MicDataParser(MicDataParser&&) = delete;                 // Move Constructor Not Implemented
+    MicDataParser& operator=(const MicDataParser&) = delete; // Copy Assignment Not Implemented
+    MicDataParser& operator=(MicDataParser&&) = delete;      // Move Assignment Not Implemented
+};
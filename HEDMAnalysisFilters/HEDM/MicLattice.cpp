@@ -0,0 +1,293 @@
+/* ============================================================================
+ * Copyright (c) 2010, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2010, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "MicLattice.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicLattice::MicLattice() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicLattice::~MicLattice() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicLattice::build(const float* triX, const float* triY, const int* triUp, size_t numTriangles, float edgeLength)
+{
+  m_EdgeLength = edgeLength;
+  m_Columns = 0;
+  m_Rows = 0;
+  m_Cells.clear();
+  m_Table.clear();
+  m_SparseTable.clear();
+  if(numTriangles == 0)
+  {
+    return true;
+  }
+  if(numTriangles > static_cast<size_t>(std::numeric_limits<qint32>::max()) || edgeLength <= 0.0f)
+  {
+    return false;
+  }
+
+  float xMin = *std::min_element(triX, triX + numTriangles);
+  float yMin = *std::min_element(triY, triY + numTriangles);
+  float halfEdge = edgeLength / 2.0f;
+  float height = edgeLength * sqrtf(3.0f) / 2.0f;
+
+  // Row 0 is the row below the lowest left vertex so the down triangles along the
+  // bottom of the data have a row too
+  m_XOrigin = xMin;
+  m_YOrigin = yMin - height;
+
+  // Every triangle is checked against the lattice of the first one. Allow for the
+  // rounding of the coordinates in the file but not for a shifted triangle.
+  std::vector<qint64> columns(numTriangles);
+  std::vector<qint64> rows(numTriangles);
+  qint64 maxColumn = 0;
+  qint64 maxRow = 0;
+  for(size_t i = 0; i < numTriangles; i++)
+  {
+    if(triUp[i] != 1 && triUp[i] != 2)
+    {
+      return false;
+    }
+    float u = (triX[i] - xMin) / halfEdge;
+    float v = (triY[i] - yMin) / height;
+    columns[i] = std::llround(u);
+    rows[i] = std::llround(v) + (triUp[i] == 1 ? 1 : 0);
+    if(std::fabs(u - static_cast<float>(columns[i])) > 0.1f || std::fabs(v + (triUp[i] == 1 ? 1.0f : 0.0f) - static_cast<float>(rows[i])) > 0.1f)
+    {
+      return false;
+    }
+    int parity = static_cast<int>((columns[i] + rows[i]) & 1) ^ (triUp[i] == 1 ? 0 : 1);
+    if(i == 0)
+    {
+      m_UpParity = parity;
+    }
+    else if(parity != m_UpParity)
+    {
+      return false;
+    }
+    maxColumn = std::max(maxColumn, columns[i]);
+    maxRow = std::max(maxRow, rows[i]);
+  }
+
+  qint64 numCells = (maxColumn + 1) * (maxRow + 1);
+  if(numCells > static_cast<qint64>(std::numeric_limits<quint32>::max()))
+  {
+    return false;
+  }
+  m_Columns = static_cast<int>(maxColumn + 1);
+  m_Rows = static_cast<int>(maxRow + 1);
+
+  // A file that covers its lattice densely, like the hexagon of a full reconstruction,
+  // has about 1.3 cells per triangle, so a table over all the cells is both the fastest
+  // and the smallest lookup. Sparse files fall back to a hash map.
+  bool dense = static_cast<quint64>(numCells) <= 4 * static_cast<quint64>(numTriangles) + 1024;
+  if(dense)
+  {
+    m_Table.assign(static_cast<size_t>(numCells), static_cast<qint32>(k_NoTriangle));
+  }
+  else
+  {
+    m_SparseTable.reserve(numTriangles);
+  }
+
+  m_Cells.resize(numTriangles);
+  for(size_t i = 0; i < numTriangles; i++)
+  {
+    quint32 cell = static_cast<quint32>(rows[i] * m_Columns + columns[i]);
+    m_Cells[i] = cell;
+    bool inserted = true;
+    if(dense)
+    {
+      inserted = (m_Table[cell] == k_NoTriangle);
+      m_Table[cell] = static_cast<qint32>(i);
+    }
+    else
+    {
+      inserted = m_SparseTable.emplace(cell, static_cast<quint32>(i)).second;
+    }
+    if(!inserted)
+    {
+      m_Cells.clear();
+      m_Table.clear();
+      m_SparseTable.clear();
+      m_Columns = 0;
+      m_Rows = 0;
+      return false;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t MicLattice::getNumberOfTriangles() const
+{
+  return m_Cells.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MicLattice::getNumberOfColumns() const
+{
+  return m_Columns;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MicLattice::getNumberOfRows() const
+{
+  return m_Rows;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float MicLattice::getEdgeLength() const
+{
+  return m_EdgeLength;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float MicLattice::getXOrigin() const
+{
+  return m_XOrigin;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float MicLattice::getYOrigin() const
+{
+  return m_YOrigin;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MicLattice::getColumn(size_t triangle) const
+{
+  return static_cast<int>(m_Cells[triangle] % static_cast<quint32>(m_Columns));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MicLattice::getRow(size_t triangle) const
+{
+  return static_cast<int>(m_Cells[triangle] / static_cast<quint32>(m_Columns));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicLattice::isUp(size_t triangle) const
+{
+  return isUpCell(getColumn(triangle), getRow(triangle));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicLattice::isUpCell(int column, int row) const
+{
+  return ((column + row) & 1) == m_UpParity;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicLattice::getLeftVertex(size_t triangle, float& x, float& y) const
+{
+  // The left vertex of an up triangle is at the bottom of its row, that of a down triangle at the top
+  int row = getRow(triangle) + (isUp(triangle) ? 0 : 1);
+  x = m_XOrigin + static_cast<float>(getColumn(triangle)) * (m_EdgeLength / 2.0f);
+  y = m_YOrigin + static_cast<float>(row) * (m_EdgeLength * sqrtf(3.0f) / 2.0f);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 MicLattice::findTriangle(int column, int row) const
+{
+  if(column < 0 || column >= m_Columns || row < 0 || row >= m_Rows)
+  {
+    return k_NoTriangle;
+  }
+  quint32 cell = static_cast<quint32>(row) * static_cast<quint32>(m_Columns) + static_cast<quint32>(column);
+  if(!m_Table.empty())
+  {
+    return m_Table[cell];
+  }
+  std::unordered_map<quint32, quint32>::const_iterator iter = m_SparseTable.find(cell);
+  return (iter == m_SparseTable.end()) ? k_NoTriangle : static_cast<qint64>(iter->second);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicLattice::findNeighbors(size_t triangle, qint64 neighbors[3]) const
+{
+  int column = getColumn(triangle);
+  int row = getRow(triangle);
+  neighbors[0] = findTriangle(column - 1, row);
+  neighbors[1] = findTriangle(column + 1, row);
+  neighbors[2] = findTriangle(column, isUp(triangle) ? row - 1 : row + 1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t MicLattice::getDataSize() const
+{
+  // Each hash map node holds the key, the value and the next pointer, plus one bucket pointer
+  size_t sparseSize = m_SparseTable.size() * (2 * sizeof(quint32) + sizeof(void*)) + m_SparseTable.bucket_count() * sizeof(void*);
+  return m_Cells.size() * sizeof(quint32) + m_Table.size() * sizeof(qint32) + sparseSize;
+}
@@ -0,0 +1,151 @@
+/* ============================================================================
+ * Copyright (c) 2010, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2010, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+#include "EbsdLib/EbsdSetGetMacros.h"
+
+/**
+ * @class MicLattice MicLattice.h HEDMAnalysisFilters/HEDM/MicLattice.h
+ * @brief Integer coordinates for the triangles of a .mic file.
+ *
+ * All the triangles of a .mic file have the same edge length and sit on one
+ * triangular lattice. The lattice is cut into rows of height edgeLength * sqrt(3) / 2
+ * and every row into columns of half an edge length. A triangle is identified by
+ * the row it lies in and the column of its left vertex, and up and down triangles
+ * alternate along a row, so whether a triangle points up follows from its column
+ * and row. One 32 bit cell index per triangle therefore replaces the X, Y and Up
+ * columns of the file.
+ *
+ * A lookup table from cell to triangle makes finding the 3 triangles that share an
+ * edge with a triangle a constant time operation:
+ * @li The triangles in columns column - 1 and column + 1 of the same row
+ * @li The triangle in the same column of the row below (up) or above (down)
+ *
+ * @date Oct 2026
+ * @version 1.0
+ */
+class MicLattice
+{
+  public:
+    EBSD_SHARED_POINTERS(MicLattice)
+
+    MicLattice();
+    virtual ~MicLattice();
+
+    /**
+     * @brief Value returned for cells that do not hold a triangle
+     */
+    static const qint64 k_NoTriangle = -1;
+
+    /**
+     * @brief Places the triangles on the lattice
+     * @param triX X coordinate of the left vertex of each triangle
+     * @param triY Y coordinate of the left vertex of each triangle
+     * @param triUp 1 if the triangle points up, 2 if it points down
+     * @param numTriangles Number of triangles
+     * @param edgeLength Edge length of the triangles
+     * @return false if a triangle is not on the lattice of the first triangle, two triangles
+     * share a cell or the lattice is too large for 32 bit cell indices
+     */
+    bool build(const float* triX, const float* triY, const int* triUp, size_t numTriangles, float edgeLength);
+
+    size_t getNumberOfTriangles() const;
+    int getNumberOfColumns() const;
+    int getNumberOfRows() const;
+    float getEdgeLength() const;
+
+    /**
+     * @brief Returns the X and Y coordinate of the bottom of column 0 and row 0
+     */
+    float getXOrigin() const;
+    float getYOrigin() const;
+
+    int getColumn(size_t triangle) const;
+    int getRow(size_t triangle) const;
+    bool isUp(size_t triangle) const;
+
+    /**
+     * @brief Returns whether the triangle of a cell points up. Cells outside of the lattice
+     * continue its pattern.
+     */
+    bool isUpCell(int column, int row) const;
+
+    /**
+     * @brief Returns the coordinates of the left vertex of a triangle, which are the X and Y
+     * values of the triangle in the .mic file
+     */
+    void getLeftVertex(size_t triangle, float& x, float& y) const;
+
+    /**
+     * @brief Returns the triangle in the given cell or k_NoTriangle
+     */
+    qint64 findTriangle(int column, int row) const;
+
+    /**
+     * @brief Finds the triangles that share an edge with a triangle
+     * @param triangle The triangle
+     * @param neighbors The left, right and bottom (up) or top (down) neighbor or k_NoTriangle (out)
+     */
+    void findNeighbors(size_t triangle, qint64 neighbors[3]) const;
+
+    /**
+     * @brief Returns the number of bytes held by the lattice
+     */
+    size_t getDataSize() const;
+
+  private:
+    float m_EdgeLength = 0.0f;
+    float m_XOrigin = 0.0f;
+    float m_YOrigin = 0.0f;
+    int m_Columns = 0;
+    int m_Rows = 0;
+    int m_UpParity = 0;
+    std::vector<quint32> m_Cells;
+    std::vector<qint32> m_Table;
+    std::unordered_map<quint32, quint32> m_SparseTable;
+
+  public:
+    MicLattice(const MicLattice&) = delete;            // Copy Constructor Not Implemented
+    MicLattice(MicLattice&&) = delete;                 // Move Constructor Not Implemented
+    MicLattice& operator=(const MicLattice&) = delete; // Copy Assignment Not Implemented
+    MicLattice& operator=(MicLattice&&) = delete;      // Move Assignment Not Implemented
+};
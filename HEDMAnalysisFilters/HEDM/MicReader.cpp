@@ -36,6 +36,16 @@
 #include "MicReader.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
 
 #include <QtCore/QDir>
 #include <QtCore/QFile>
@@ -47,7 +57,11 @@
 #include "EbsdLib/EbsdMacros.h"
 #include "EbsdLib/EbsdMath.h"
 
+#include "MicCacheFile.h"
 #include "MicConstants.h"
+#include "MicCoverageMap.h"
+#include "MicDataParser.h"
+#include "MicTriangleRasterizer.h"
 
 #ifdef _MSC_VER
 
@@ -58,10 +72,373 @@
 #endif
 #endif
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+/**
+ * @brief The CountMicRowsImpl class counts the data rows in each chunk of a .mic file,
+ * or just the rows inside the bounding box of the filter if it has one
+ */
+class CountMicRowsImpl
+{
+  const std::vector<const char*>& m_ChunkBoundaries;
+  std::vector<size_t>& m_RowCounts;
+  const MicRowFilter& m_Filter;
+
+public:
+  CountMicRowsImpl(const std::vector<const char*>& chunkBoundaries, std::vector<size_t>& rowCounts, const MicRowFilter& filter)
+  : m_ChunkBoundaries(chunkBoundaries)
+  , m_RowCounts(rowCounts)
+  , m_Filter(filter)
+  {
+  }
+  virtual ~CountMicRowsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      if(m_Filter.useBoundingBox)
+      {
+        m_RowCounts[i] = MicDataParser::countRowsInBox(m_ChunkBoundaries[i], m_ChunkBoundaries[i + 1], m_Filter.xMin, m_Filter.xMax, m_Filter.yMin, m_Filter.yMax);
+      }
+      else
+      {
+        m_RowCounts[i] = MicDataParser::countRows(m_ChunkBoundaries[i], m_ChunkBoundaries[i + 1]);
+      }
+    }
+  }
+
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+};
+
+/**
+ * @brief The ParseMicRowsImpl class parses each chunk of a .mic file into the rows
+ * that start at the chunk's row offset
+ */
+class ParseMicRowsImpl
+{
+  MicReader* m_Reader;
+  const std::vector<const char*>& m_ChunkBoundaries;
+  const std::vector<size_t>& m_RowOffsets;
+  std::vector<size_t>& m_KeptRows;
+  size_t m_MaxRows;
+
+public:
+  ParseMicRowsImpl(MicReader* reader, const std::vector<const char*>& chunkBoundaries, const std::vector<size_t>& rowOffsets, std::vector<size_t>& keptRows, size_t maxRows)
+  : m_Reader(reader)
+  , m_ChunkBoundaries(chunkBoundaries)
+  , m_RowOffsets(rowOffsets)
+  , m_KeptRows(keptRows)
+  , m_MaxRows(maxRows)
+  {
+  }
+  virtual ~ParseMicRowsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      if(m_RowOffsets[i] < m_MaxRows)
+      {
+        size_t endRow = (i + 1 < m_RowOffsets.size()) ? std::min(m_RowOffsets[i + 1], m_MaxRows) : m_MaxRows;
+        m_KeptRows[i] = m_Reader->parseDataRows(m_ChunkBoundaries[i], m_ChunkBoundaries[i + 1], m_RowOffsets[i], endRow);
+      }
+    }
+  }
+
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+};
+#endif
+
+namespace
+{
+/**
+ * @brief One entry of the .config key table. Exactly one of the member pointers is
+ * set and it selects the MicHeaderValues member that the value is stored in.
+ */
+struct MicHeaderKey
+{
+  const char* name;
+  size_t length;
+  int MicHeaderValues::*intValue;
+  float MicHeaderValues::*floatValue;
+  QString MicHeaderValues::*stringValue;
+};
+
+constexpr MicHeaderKey MakeHeaderKey(const char* name, size_t length, int MicHeaderValues::*value)
+{
+  return {name, length, value, nullptr, nullptr};
+}
+
+constexpr MicHeaderKey MakeHeaderKey(const char* name, size_t length, float MicHeaderValues::*value)
+{
+  return {name, length, nullptr, value, nullptr};
+}
+
+constexpr MicHeaderKey MakeHeaderKey(const char* name, size_t length, QString MicHeaderValues::*value)
+{
+  return {name, length, nullptr, nullptr, value};
+}
+
+#define MIC_HEADER_KEY(type, prpty) MakeHeaderKey(#prpty, sizeof(#prpty) - 1, &MicHeaderValues::prpty),
+constexpr MicHeaderKey k_HeaderKeys[] = {MIC_HEADER_ENTRIES(MIC_HEADER_KEY)};
+#undef MIC_HEADER_KEY
+constexpr size_t k_NumHeaderKeys = sizeof(k_HeaderKeys) / sizeof(MicHeaderKey);
+
+// The keys are found with a perfect hash: every key lands in its own slot of a 256 entry
+// table so a lookup is one hash, one table read and one key compare. The seed was picked
+// so that no two keys collide. If a new key collides the static_assert below fails and a
+// new seed has to be searched for.
+constexpr size_t k_HeaderSlotCount = 256;
+constexpr uint32_t k_HeaderHashSeed = 29872;
+constexpr uint8_t k_EmptyHeaderSlot = 0xFF;
+static_assert(k_NumHeaderKeys < k_EmptyHeaderSlot, "The .config key table has too many keys for 8 bit slots");
+
+constexpr size_t HeaderKeySlot(const char* key, size_t length)
+{
+  // 32 bit FNV-1a with a custom offset basis, folded down to the table size
+  uint32_t hash = k_HeaderHashSeed;
+  for(size_t i = 0; i < length; i++)
+  {
+    hash = (hash ^ static_cast<uint8_t>(key[i])) * 16777619u;
+  }
+  return (hash ^ (hash >> 16)) & (k_HeaderSlotCount - 1);
+}
+
+struct MicHeaderSlots
+{
+  uint8_t slots[k_HeaderSlotCount];
+};
+
+constexpr MicHeaderSlots MakeHeaderSlots()
+{
+  MicHeaderSlots table = {};
+  for(size_t i = 0; i < k_HeaderSlotCount; i++)
+  {
+    table.slots[i] = k_EmptyHeaderSlot;
+  }
+  for(size_t i = 0; i < k_NumHeaderKeys; i++)
+  {
+    table.slots[HeaderKeySlot(k_HeaderKeys[i].name, k_HeaderKeys[i].length)] = static_cast<uint8_t>(i);
+  }
+  return table;
+}
+
+constexpr MicHeaderSlots k_HeaderSlots = MakeHeaderSlots();
+
+constexpr bool HeaderSlotsArePerfect()
+{
+  for(size_t i = 0; i < k_NumHeaderKeys; i++)
+  {
+    if(k_HeaderSlots.slots[HeaderKeySlot(k_HeaderKeys[i].name, k_HeaderKeys[i].length)] != i)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+static_assert(HeaderSlotsArePerfect(), "Two .config keys share a hash slot, pick a new k_HeaderHashSeed");
+
+/**
+ * @brief Returns the table entry for the key in [key, key + length) or nullptr if it is not a known key
+ */
+const MicHeaderKey* FindHeaderKey(const char* key, size_t length)
+{
+  uint8_t index = k_HeaderSlots.slots[HeaderKeySlot(key, length)];
+  if(index == k_EmptyHeaderSlot)
+  {
+    return nullptr;
+  }
+  const MicHeaderKey& entry = k_HeaderKeys[index];
+  if(entry.length != length || ::memcmp(entry.name, key, length) != 0)
+  {
+    return nullptr;
+  }
+  return &entry;
+}
+
+/**
+ * @brief Returns the array name of a column. The Good column is read into the Phase array.
+ * @param column A Mic::DataColumn::Index
+ */
+const QString& ColumnName(int column)
+{
+  static const QString k_Names[Mic::DataColumn::Count] = {Mic::X,        Mic::Y,        Mic::Z,        Mic::Up,       Mic::Level,    Mic::Phase,    Mic::Euler1,
+                                                          Mic::Euler2,   Mic::Euler3,   Mic::Confidence, Mic::Column11, Mic::Column12, Mic::Column13, Mic::Column14,
+                                                          Mic::Column15, Mic::Column16, Mic::Column17, Mic::Column18, Mic::Column19};
+  return k_Names[column];
+}
+
+/**
+ * @brief Returns true for the columns that are kept in MicReader::m_ExtraColumns
+ */
+bool IsExtraColumn(int column)
+{
+  return column == Mic::DataColumn::Z || column >= Mic::DataColumn::Column11;
+}
+
+/**
+ * @brief Copies the value of the owning triangle into every grid point that a triangle covers
+ */
+template <typename T>
+void GatherColumn(const T* triangleValues, T* gridValues, const int* owners, size_t numPoints)
+{
+  for(size_t point = 0; point < numPoints; point++)
+  {
+    int i = owners[point];
+    if(i >= 0)
+    {
+      gridValues[point] = triangleValues[i];
+    }
+  }
+}
+
+/**
+ * @brief GatherColumn() for a column of the given Mic::DataColumn::Index
+ */
+void GatherTypedColumn(int column, const void* triangleValues, void* gridValues, const int* owners, size_t numPoints)
+{
+  if(Mic::DataColumn::Types[column] == 'f')
+  {
+    GatherColumn(static_cast<const float*>(triangleValues), static_cast<float*>(gridValues), owners, numPoints);
+  }
+  else
+  {
+    GatherColumn(static_cast<const int*>(triangleValues), static_cast<int*>(gridValues), owners, numPoints);
+  }
+}
+
+/**
+ * @brief Returns true if the arrays of the target hold the grid column
+ */
+bool HeldByTarget(const MicGridTarget* target, int column)
+{
+  if(nullptr == target)
+  {
+    return false;
+  }
+  switch(column)
+  {
+  case Mic::DataColumn::Euler1:
+  case Mic::DataColumn::Euler2:
+  case Mic::DataColumn::Euler3:
+    return nullptr != target->eulerAngles || nullptr != target->compactEulerAngles;
+  case Mic::DataColumn::Good:
+    return nullptr != target->phases;
+  case Mic::DataColumn::Confidence:
+    return nullptr != target->confidences || nullptr != target->compactConfidences;
+  default:
+    return false;
+  }
+}
+
+/**
+ * @brief Writes the position in microns of every grid point that a triangle covers into
+ * x and y. Points that no triangle covers and arrays that are nullptr are skipped.
+ */
+void FillGridPositions(const int* owners, int xDim, int yDim, float xRes, float yRes, float xMinUM, float yMinUM, float* x, float* y)
+{
+  size_t point = 0;
+  for(int k = 0; k < yDim; k++)
+  {
+    for(int j = 0; j < xDim; j++, point++)
+    {
+      if(owners[point] < 0)
+      {
+        continue;
+      }
+      if(nullptr != x)
+      {
+        x[point] = float(j) * xRes + xMinUM;
+      }
+      if(nullptr != y)
+      {
+        y[point] = float(k) * yRes + yMinUM;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Writes the values of the triangle that covers each grid point into the arrays
+ * of the target. The Euler angles are interleaved. The compact arrays take precedence
+ * over the float arrays. Points that no triangle covers and arrays that are nullptr
+ * are skipped.
+ */
+void ScatterOntoTarget(const MicGridTarget& target, const int* owners, size_t numPoints, const float* triEuler1, const float* triEuler2, const float* triEuler3, const float* triConf,
+                       const int* triPhase)
+{
+  bool hasEuler = (nullptr != triEuler1 && nullptr != triEuler2 && nullptr != triEuler3);
+  for(size_t point = 0; point < numPoints; point++)
+  {
+    int i = owners[point];
+    if(i < 0)
+    {
+      continue;
+    }
+    if(hasEuler && nullptr != target.compactEulerAngles)
+    {
+      target.compactEulerAngles[3 * point] = MicCompactCodec::encodeEulerAngle(triEuler1[i]);
+      target.compactEulerAngles[3 * point + 1] = MicCompactCodec::encodeEulerAngle(triEuler2[i]);
+      target.compactEulerAngles[3 * point + 2] = MicCompactCodec::encodeEulerAngle(triEuler3[i]);
+    }
+    else if(hasEuler && nullptr != target.eulerAngles)
+    {
+      target.eulerAngles[3 * point] = triEuler1[i];
+      target.eulerAngles[3 * point + 1] = triEuler2[i];
+      target.eulerAngles[3 * point + 2] = triEuler3[i];
+    }
+    if(nullptr != target.phases && nullptr != triPhase)
+    {
+      target.phases[point] = triPhase[i];
+    }
+    if(nullptr != triConf && nullptr != target.compactConfidences)
+    {
+      target.compactConfidences[point] = MicCompactCodec::encodeConfidence(triConf[i]);
+    }
+    else if(nullptr != triConf && nullptr != target.confidences)
+    {
+      target.confidences[point] = triConf[i];
+    }
+  }
+}
+
+/**
+ * @brief Copies an array out of the cache file unless the array is not read
+ */
+void CopyCacheArray(void* destination, const void* source, size_t numBytes)
+{
+  if(nullptr != destination)
+  {
+    ::memcpy(destination, source, numBytes);
+  }
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 MicReader::MicReader()
+: m_ParallelParsing(true)
+, m_ParallelChunkSize(k_DefaultParallelChunkSize)
+, m_DeviceReadTimeout(k_DefaultDeviceReadTimeout)
+, m_UseCacheFile(false)
+, m_ResampleToGrid(true)
+, m_UseHugePages(false)
+, m_GridTarget(nullptr)
+, m_ReadAllArrays(true)
+, m_CacheFileWritten(false)
+, m_NumParsedColumns(0)
+, m_DataArena(nullptr)
+, edgeLength(0.0f)
+, refinementLevel(0)
+, xOrigin(0.0f)
+, yOrigin(0.0f)
 {
 
   // Init all the arrays to nullptr
@@ -74,77 +451,9 @@ MicReader::MicReader()
   m_Up = nullptr;
   m_X = nullptr;
   m_Y = nullptr;
-
-  m_HeaderMap[Mic::InfileBasename] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::InfileBasename);
-  m_HeaderMap[Mic::InfileSerialLength] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::InfileSerialLength);
-  m_HeaderMap[Mic::OutfileBasename] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::OutfileBasename);
-  m_HeaderMap[Mic::OutfileSerialLength] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::OutfileSerialLength);
-  m_HeaderMap[Mic::OutStructureBasename] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::OutStructureBasename);
-  m_HeaderMap[Mic::BCPeakDetectorOffset] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::BCPeakDetectorOffset);
-  m_HeaderMap[Mic::InFileType] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::InFileType);
-  m_HeaderMap[Mic::OutfileExtension] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::OutfileExtension);
-  m_HeaderMap[Mic::InfileExtesnion] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::InfileExtesnion);
-  m_HeaderMap[Mic::BeamEnergyWidth] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::BeamEnergyWidth);
-  m_HeaderMap[Mic::BeamDirection] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::BeamDirection);
-  m_HeaderMap[Mic::BeamDeflectionChiLaue] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::BeamDeflectionChiLaue);
-  m_HeaderMap[Mic::BeamHeight] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::BeamHeight);
-  m_HeaderMap[Mic::BeamEnergy] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::BeamEnergy);
-  m_HeaderMap[Mic::DetectorFilename] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::DetectorFilename);
-  m_HeaderMap[Mic::OptimizationConstrainFilename] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::OptimizationConstrainFilename);
-  m_HeaderMap[Mic::EtaLimit] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::EtaLimit);
-  m_HeaderMap[Mic::SampleFilename] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::SampleFilename);
-  m_HeaderMap[Mic::StructureFilename] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::StructureFilename);
-  m_HeaderMap[Mic::RotationRangeFilename] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::RotationRangeFilename);
-  m_HeaderMap[Mic::FundamentalZoneFilename] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::FundamentalZoneFilename);
-  m_HeaderMap[Mic::SampleSymmetry] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::SampleSymmetry);
-  m_HeaderMap[Mic::MinAmplitudeFraction] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::MinAmplitudeFraction);
-  m_HeaderMap[Mic::MaxQ] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::MaxQ);
-  m_HeaderMap[Mic::MaxInitSideLength] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::MaxInitSideLength);
-  m_HeaderMap[Mic::MinSideLength] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::MinSideLength);
-  m_HeaderMap[Mic::LocalOrientationGridRadius] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::LocalOrientationGridRadius);
-  m_HeaderMap[Mic::MinLocalResolution] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::MinLocalResolution);
-  m_HeaderMap[Mic::MaxLocalResolution] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::MaxLocalResolution);
-  m_HeaderMap[Mic::MaxAcceptedCost] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::MaxAcceptedCost);
-  m_HeaderMap[Mic::MaxConvergenceCost] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::MaxConvergenceCost);
-  m_HeaderMap[Mic::MaxMCSteps] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::MaxMCSteps);
-  m_HeaderMap[Mic::MCRadiusScaleFactor] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::MCRadiusScaleFactor);
-  m_HeaderMap[Mic::SuccessiveRestarts] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::SuccessiveRestarts);
-  m_HeaderMap[Mic::SecondsBetweenSave] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::SecondsBetweenSave);
-  m_HeaderMap[Mic::NumParameterOptimizationSteps] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::NumParameterOptimizationSteps);
-  m_HeaderMap[Mic::NumElementToOptimizePerPE] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::NumElementToOptimizePerPE);
-  m_HeaderMap[Mic::OptimizationFilename] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::OptimizationFilename);
-  m_HeaderMap[Mic::DetectionLimitFilename] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::DetectionLimitFilename);
-  m_HeaderMap[Mic::ParameterMCInitTemperature] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::ParameterMCInitTemperature);
-  m_HeaderMap[Mic::OrientationSearchMethod] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::OrientationSearchMethod);
-  m_HeaderMap[Mic::CoolingFraction] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::CoolingFraction);
-  m_HeaderMap[Mic::ThermalizeFraction] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::ThermalizeFraction);
-  m_HeaderMap[Mic::ParameterRefinements] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::ParameterRefinements);
-  m_HeaderMap[Mic::NumDetectors] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::NumDetectors);
-  m_HeaderMap[Mic::DetectorSpacing] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::DetectorSpacing);
-  m_HeaderMap[Mic::DetectorSpacingDeviation] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::DetectorSpacingDeviation);
-  m_HeaderMap[Mic::DetectorOrientationDeviationInEuler] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::DetectorOrientationDeviationInEuler);
-  m_HeaderMap[Mic::DetectorOrientationDeviationInSO3] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::DetectorOrientationDeviationInSO3);
-  m_HeaderMap[Mic::ParamMCMaxLocalRestarts] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::ParamMCMaxLocalRestarts);
-  m_HeaderMap[Mic::ParamMCMaxGlobalRestarts] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::ParamMCMaxGlobalRestarts);
-  m_HeaderMap[Mic::ParamMCNumGlobalSearchElements] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::ParamMCNumGlobalSearchElements);
-  m_HeaderMap[Mic::ConstrainedOptimization] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::ConstrainedOptimization);
-  m_HeaderMap[Mic::SearchVolumeReductionFactor] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::SearchVolumeReductionFactor);
-  m_HeaderMap[Mic::FileNumStart] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::FileNumStart);
-  m_HeaderMap[Mic::FileNumEnd] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::FileNumEnd);
-  m_HeaderMap[Mic::SampleLocation] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::SampleLocation);
-  m_HeaderMap[Mic::SampleOrientation] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::SampleOrientation);
-  m_HeaderMap[Mic::EnableStrain] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::EnableStrain);
-  m_HeaderMap[Mic::SampleCenter] = MicStringHeaderEntry::NewEbsdHeaderEntry(Mic::SampleCenter);
-  m_HeaderMap[Mic::SampleRadius] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::SampleRadius);
-  m_HeaderMap[Mic::MaxDeepeningHitRatio] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::MaxDeepeningHitRatio);
-  m_HeaderMap[Mic::ConsistencyError] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::ConsistencyError);
-  m_HeaderMap[Mic::BraggFilterTolerance] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::BraggFilterTolerance);
-  m_HeaderMap[Mic::MinAccelerationThreshold] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::MinAccelerationThreshold);
-  m_HeaderMap[Mic::MaxDiscreteCandidates] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::MaxDiscreteCandidates);
-  m_HeaderMap[Mic::XDim] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::XDim);
-  m_HeaderMap[Mic::YDim] = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::YDim);
-  m_HeaderMap[Mic::XRes] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::XRes);
-  m_HeaderMap[Mic::YRes] = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::YRes);
+  std::fill(m_ExtraColumns, m_ExtraColumns + Mic::DataColumn::Count, nullptr);
+  std::fill(m_ColumnTargets, m_ColumnTargets + Mic::DataColumn::Count, nullptr);
+  std::fill(m_FilterColumns, m_FilterColumns + Mic::DataColumn::Count, false);
 
   setNumFeatures(8);
 }
@@ -160,29 +469,34 @@ MicReader::~MicReader()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void MicReader::initPointers(size_t numElements)
+void MicReader::initPointers(size_t numElements, bool triangleTable, const MicGridTarget* callerGrid)
 {
   setNumberOfElements(numElements);
-  size_t numBytes = numElements * sizeof(float);
-  m_Euler1 = allocateArray<float>(numElements);
-  m_Euler2 = allocateArray<float>(numElements);
-  m_Euler3 = allocateArray<float>(numElements);
-  m_Conf = allocateArray<float>(numElements);
-  m_Phase = allocateArray<int>(numElements);
-  m_Level = allocateArray<int>(numElements);
-  m_Up = allocateArray<int>(numElements);
-  m_X = allocateArray<float>(numElements);
-  m_Y = allocateArray<float>(numElements);
+  bool usedColumns[Mic::DataColumn::Count];
+  size_t numColumns = 0;
+  for(int column = 0; column < Mic::DataColumn::Count; column++)
+  {
+    // The triangle table always holds the columns that place the triangles
+    bool placesTriangles = (column == Mic::DataColumn::X || column == Mic::DataColumn::Y || column == Mic::DataColumn::Up || column == Mic::DataColumn::Level);
+    usedColumns[column] = (triangleTable && placesTriangles) || (isArrayRead(ColumnName(column)) && !HeldByTarget(callerGrid, column));
+    numColumns += usedColumns[column] ? 1 : 0;
+  }
 
-  ::memset(m_Euler1, 0, numBytes);
-  ::memset(m_Euler2, 0, numBytes);
-  ::memset(m_Euler3, 0, numBytes);
-  ::memset(m_Conf, 0, numBytes);
-  ::memset(m_Phase, 0, numBytes);
-  ::memset(m_Level, 0, numBytes);
-  ::memset(m_Up, 0, numBytes);
-  ::memset(m_X, 0, numBytes);
-  ::memset(m_Y, 0, numBytes);
+  // The arrays of the previous read are given up, their memory is reused
+  MicColumnArena& arena = triangleTable ? m_TableArena : m_GridArena;
+  arena.setUseHugePages(m_UseHugePages);
+  bool allocated = arena.layout(numColumns, numElements, !triangleTable);
+  m_DataArena = &arena;
+
+  size_t index = 0;
+  for(int column = 0; column < Mic::DataColumn::Count; column++)
+  {
+    if(usedColumns[column])
+    {
+      setColumnData(column, allocated ? arena.getColumn(index) : nullptr);
+      index++;
+    }
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -190,15 +504,222 @@ void MicReader::initPointers(size_t numElements)
 // -----------------------------------------------------------------------------
 void MicReader::deletePointers()
 {
-  deallocateArrayData<float>(m_Euler1);
-  deallocateArrayData<float>(m_Euler2);
-  deallocateArrayData<float>(m_Euler3);
-  deallocateArrayData<float>(m_Conf);
-  deallocateArrayData<int>(m_Phase);
-  deallocateArrayData<int>(m_Level);
-  deallocateArrayData<int>(m_Up);
-  deallocateArrayData<float>(m_X);
-  deallocateArrayData<float>(m_Y);
+  for(int column = 0; column < Mic::DataColumn::Count; column++)
+  {
+    setColumnData(column, nullptr);
+  }
+  m_DataArena = nullptr;
+  m_Lattice.reset();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReader::releaseScratchMemory()
+{
+  if(m_DataArena != &m_TableArena)
+  {
+    m_TableArena.release();
+  }
+  if(m_DataArena != &m_GridArena)
+  {
+    m_GridArena.release();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void* MicReader::getColumnData(int column)
+{
+  switch(column)
+  {
+  case Mic::DataColumn::X:
+    return m_X;
+  case Mic::DataColumn::Y:
+    return m_Y;
+  case Mic::DataColumn::Up:
+    return m_Up;
+  case Mic::DataColumn::Level:
+    return m_Level;
+  case Mic::DataColumn::Good:
+    return m_Phase;
+  case Mic::DataColumn::Euler1:
+    return m_Euler1;
+  case Mic::DataColumn::Euler2:
+    return m_Euler2;
+  case Mic::DataColumn::Euler3:
+    return m_Euler3;
+  case Mic::DataColumn::Confidence:
+    return m_Conf;
+  default:
+    return m_ExtraColumns[column];
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReader::setColumnData(int column, void* data)
+{
+  switch(column)
+  {
+  case Mic::DataColumn::X:
+    m_X = static_cast<float*>(data);
+    break;
+  case Mic::DataColumn::Y:
+    m_Y = static_cast<float*>(data);
+    break;
+  case Mic::DataColumn::Up:
+    m_Up = static_cast<int*>(data);
+    break;
+  case Mic::DataColumn::Level:
+    m_Level = static_cast<int*>(data);
+    break;
+  case Mic::DataColumn::Good:
+    m_Phase = static_cast<int*>(data);
+    break;
+  case Mic::DataColumn::Euler1:
+    m_Euler1 = static_cast<float*>(data);
+    break;
+  case Mic::DataColumn::Euler2:
+    m_Euler2 = static_cast<float*>(data);
+    break;
+  case Mic::DataColumn::Euler3:
+    m_Euler3 = static_cast<float*>(data);
+    break;
+  case Mic::DataColumn::Confidence:
+    m_Conf = static_cast<float*>(data);
+    break;
+  default:
+    m_ExtraColumns[column] = data;
+    break;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReader::planColumns()
+{
+  std::fill(m_FilterColumns, m_FilterColumns + Mic::DataColumn::Count, false);
+  m_FilterColumns[Mic::DataColumn::Confidence] = m_ParseFilter.useMinConfidence;
+  m_FilterColumns[Mic::DataColumn::Good] = m_ParseFilter.goodOnly;
+  m_FilterColumns[Mic::DataColumn::X] = m_ParseFilter.useBoundingBox;
+  m_FilterColumns[Mic::DataColumn::Y] = m_ParseFilter.useBoundingBox;
+
+  m_NumParsedColumns = 0;
+  for(int column = 0; column < Mic::DataColumn::Count; column++)
+  {
+    m_ColumnTargets[column] = getColumnData(column);
+    if(nullptr != m_ColumnTargets[column] || m_FilterColumns[column])
+    {
+      m_NumParsedColumns = column + 1;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReader::moveRows(size_t from, size_t to, size_t count)
+{
+  for(int column = 0; column < Mic::DataColumn::Count; column++)
+  {
+    char* data = static_cast<char*>(getColumnData(column));
+    if(nullptr != data)
+    {
+      // Every column is a 4 byte float or int
+      ::memmove(data + 4 * to, data + 4 * from, 4 * count);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReader::shrinkColumns(size_t numRows)
+{
+  size_t numColumns = 0;
+  for(int column = 0; column < Mic::DataColumn::Count; column++)
+  {
+    numColumns += (nullptr != getColumnData(column)) ? 1 : 0;
+  }
+  if(numColumns == m_TableArena.getNumColumns() && numRows == m_TableArena.getNumElements())
+  {
+    setNumberOfElements(numRows);
+    return;
+  }
+  MicColumnArena shrunk;
+  shrunk.setUseHugePages(m_UseHugePages);
+  if(!shrunk.layout(numColumns, numRows, false))
+  {
+    // Keeping the larger block only costs memory
+    setNumberOfElements(numRows);
+    return;
+  }
+
+  size_t index = 0;
+  for(int column = 0; column < Mic::DataColumn::Count; column++)
+  {
+    void* data = getColumnData(column);
+    if(nullptr == data)
+    {
+      continue;
+    }
+    void* target = shrunk.getColumn(index++);
+    // Every column is a 4 byte float or int
+    ::memcpy(target, data, 4 * numRows);
+    setColumnData(column, target);
+  }
+  m_TableArena.swap(shrunk);
+  m_DataArena = &m_TableArena;
+  setNumberOfElements(numRows);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReader::setArraysToRead(QSet<QString> names)
+{
+  m_ArrayNames = names;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReader::readAllArrays(bool b)
+{
+  m_ReadAllArrays = b;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicReader::isArrayRead(const QString& name) const
+{
+  if(m_ArrayNames.contains(name))
+  {
+    return true;
+  }
+  if(!m_ReadAllArrays)
+  {
+    return false;
+  }
+  return name == Mic::Euler1 || name == Mic::Euler2 || name == Mic::Euler3 || name == Mic::Confidence || name == Mic::Phase || name == Mic::X || name == Mic::Y;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t MicReader::getDataSize()
+{
+  size_t numBytes = m_TableArena.getCapacity() + m_GridArena.getCapacity();
+  if(nullptr != m_Lattice.get())
+  {
+    numBytes += m_Lattice->getDataSize();
+  }
+  return numBytes;
 }
 
 // -----------------------------------------------------------------------------
@@ -242,6 +763,13 @@ void* MicReader::getPointerByName(const QString& featureName)
   {
     return static_cast<void*>(m_Y);
   }
+  for(int column = 0; column < Mic::DataColumn::Count; column++)
+  {
+    if(IsExtraColumn(column) && featureName.compare(ColumnName(column)) == 0)
+    {
+      return m_ExtraColumns[column];
+    }
+  }
   return nullptr;
 }
 
@@ -286,6 +814,13 @@ Ebsd::NumType MicReader::getPointerType(const QString& featureName)
   {
     return Ebsd::Float;
   }
+  for(int column = 0; column < Mic::DataColumn::Count; column++)
+  {
+    if(IsExtraColumn(column) && featureName.compare(ColumnName(column)) == 0)
+    {
+      return (Mic::DataColumn::Types[column] == 'f') ? Ebsd::Float : Ebsd::Int32;
+    }
+  }
   return Ebsd::UnknownNumType;
 }
 
@@ -294,11 +829,27 @@ Ebsd::NumType MicReader::getPointerType(const QString& featureName)
 // -----------------------------------------------------------------------------
 int MicReader::readHeaderOnly()
 {
-  int err = 1;
-  QByteArray buf;
+  // Read the .config and .dat files
+  int err = readHeaderFiles();
+  if(err < 0)
+  {
+    return err;
+  }
 
-  QString origHeader;
-  setOriginalHeader(origHeader);
+  // Only the first rows of the .mic file are needed to size the grid
+  return readMicGeometry();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MicReader::readConfigFile()
+{
+  int err = 1;
+  QByteArray buf;
+
+  QString origHeader;
+  setOriginalHeader(origHeader);
   m_PhaseVector.clear();
 
   m_CurrentPhase = MicPhase::New();
@@ -317,7 +868,7 @@ int MicReader::readHeaderOnly()
     name = parentPath + QDir::separator() + name + ".config";
   }
 
-  QFile inHeader(getFileName());
+  QFile inHeader(name);
   if(!inHeader.open(QIODevice::ReadOnly | QIODevice::Text))
   {
     QString msg = QString("HEDM .config file could not be opened: ") + name;
@@ -328,14 +879,18 @@ int MicReader::readHeaderOnly()
 
   // 'name' now contains the complete path to the file with the new extension
 
-  while(!inHeader.atEnd())
+  // The .config file is small so read it in one go and parse the lines in place
+  buf = inHeader.readAll();
+  const char* ptr = buf.constData();
+  const char* end = ptr + buf.size();
+  while(ptr < end)
   {
-    buf = inHeader.readLine();
-    origHeader.append(buf); // Append the line NOW to the header as we are going to modify it next
-
-    parseHeaderLine(buf);
+    const char* lineEnd = MicDataParser::findLineEnd(ptr, end);
+    parseHeaderLine(ptr, lineEnd);
+    ptr = (lineEnd < end) ? lineEnd + 1 : end;
   }
   // Update the Original Header variable
+  origHeader = QString(buf);
   setOriginalHeader(origHeader);
 
   return err;
@@ -398,6 +953,76 @@ int MicReader::readDatFile()
 //
 // -----------------------------------------------------------------------------
 int MicReader::readFile()
+{
+  m_CacheFileWritten = false;
+  int err = readHeaderFiles();
+  if(err < 0)
+  {
+    return err;
+  }
+
+  // We need to pass in the buffer because it has the first line of data
+  err = readMicFile();
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MicReader::readBuffer(const char* data, size_t size)
+{
+  m_CacheFileWritten = false;
+  int err = 0;
+  if(getFileName().isEmpty())
+  {
+    setOriginalHeader(QString());
+    m_PhaseVector.clear();
+  }
+  else
+  {
+    err = readHeaderFiles();
+  }
+  if(err < 0)
+  {
+    return err;
+  }
+  return readMicContents(data, data + size);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MicReader::readDevice(QIODevice* device)
+{
+  if(nullptr == device || !device->isReadable())
+  {
+    QString msg = QObject::tr("The Mic data could not be read from the device");
+    setErrorMessage(msg);
+    setErrorCode(-117);
+    return -117;
+  }
+
+  // The parser needs all the rows at once, so a sequential device is read to its end.
+  // Devices like pipes of a QProcess deliver the data as it is written.
+  QByteArray contents = device->readAll();
+  while(!device->atEnd())
+  {
+    if(!device->waitForReadyRead(m_DeviceReadTimeout) && !device->atEnd())
+    {
+      QString msg = QObject::tr("The device delivered no Mic data for %1 ms before its end").arg(m_DeviceReadTimeout);
+      setErrorMessage(msg);
+      setErrorCode(-118);
+      return -118;
+    }
+    contents.append(device->readAll());
+  }
+  return readBuffer(contents.constData(), static_cast<size_t>(contents.size()));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MicReader::readHeaderFiles()
 {
   int err = 1;
 
@@ -406,7 +1031,7 @@ int MicReader::readFile()
   m_PhaseVector.clear();
 
   // Read the .config file
-  err = readHeaderOnly();
+  err = readConfigFile();
   if(err < 0)
   {
     return err;
@@ -414,13 +1039,6 @@ int MicReader::readFile()
 
   // Read the .dat file
   err = readDatFile();
-  if(err < 0)
-  {
-    return err;
-  }
-
-  // We need to pass in the buffer because it has the first line of data
-  err = readMicFile();
   return err;
 }
 
@@ -431,7 +1049,7 @@ int MicReader::readMicFile()
 {
 
   QFile in(getFileName());
-  if(!in.open(QIODevice::ReadOnly | QIODevice::Text))
+  if(!in.open(QIODevice::ReadOnly))
   {
     QString msg = QObject::tr("Mic file could not be opened: %1").arg(getFileName());
     setErrorMessage(msg);
@@ -439,64 +1057,121 @@ int MicReader::readMicFile()
     return -113;
   }
 
+  int err = checkRegionOfInterest();
+  if(err < 0)
+  {
+    return err;
+  }
+
   // Delete any currently existing pointers
   deletePointers();
-  // Initialize new pointers
   size_t totalDataRows = 0;
-  size_t totalPossibleDataRows = 0;
-  //  size_t featuresRead = 0;
-  float origEdgeLength;
-  float xMax = 0, yMax = 0;
-  float xMin = 1000000000, yMin = 1000000000;
-  float xMinUM, yMinUM;
-  int32_t counter = 0;
-  bool ok = false;
-  QByteArray buf;
-
-  // Read the First line in the file which is the edge length
-  buf = in.readLine();
-  origEdgeLength = buf.toFloat(&ok);
-
-  // Read the first line of actual data which we then derive the actual number of data rows
-  buf = in.readLine();
-  parseDataLine(buf, 0);
+  float origEdgeLength = 0.0f;
+
+  // Map the file into memory so the rows are tokenized in place. Devices that can
+  // not be mapped are read into a single buffer instead.
+  qint64 fileSize = in.size();
+  uchar* mappedData = (fileSize > 0) ? in.map(0, fileSize) : nullptr;
+  QByteArray contents;
+  const char* begin = reinterpret_cast<const char*>(mappedData);
+  const char* end = begin + fileSize;
+  if(nullptr == mappedData)
+  {
+    contents = in.readAll();
+    begin = contents.constData();
+    end = begin + contents.size();
+  }
 
-  int level = m_Level[0];
-  float newEdgeLength = origEdgeLength / powf(2.0, float(level));
-  totalPossibleDataRows = static_cast<size_t>(6.0f * powf(4.0f, float(level)));
+  // An up to date cache file replaces parsing and rasterizing the text. It only holds
+  // the arrays that are read by default, so it is of no use when other columns are asked for.
+  bool readsExtraColumns = false;
+  for(int column = 0; column < Mic::DataColumn::Count; column++)
+  {
+    readsExtraColumns = readsExtraColumns || (IsExtraColumn(column) && isArrayRead(ColumnName(column)));
+  }
+  quint64 contentHash = 0;
+  if(m_UseCacheFile && nullptr == m_GridTarget && !readsExtraColumns && !m_RowFilter.isActive() && !m_RegionOfInterest.enabled)
+  {
+    contentHash = MicCacheFile::HashContent(begin, end);
+    if(readCacheFile(contentHash))
+    {
+      if(nullptr != mappedData)
+      {
+        in.unmap(mappedData);
+      }
+      return 0;
+    }
+  }
 
-  // Reinitialize the pointers that hold the data to the proper size
-  initPointers(totalPossibleDataRows);
+  err = parseMicBuffer(begin, end, origEdgeLength, totalDataRows);
+  if(nullptr != mappedData)
+  {
+    in.unmap(mappedData);
+  }
+  contents.clear();
+  if(err < 0)
+  {
+    return err;
+  }
+  return processRows(origEdgeLength, totalDataRows, m_UseCacheFile, contentHash);
+}
 
-  // Reparse the first data line to get those values into the new arrays
-  parseDataLine(buf, 0);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MicReader::readMicContents(const char* begin, const char* end)
+{
+  int err = checkRegionOfInterest();
+  if(err < 0)
+  {
+    return err;
+  }
 
-  buf = in.readLine();
-  ++counter;
-  for(size_t i = 1; i < totalPossibleDataRows; ++i)
+  deletePointers();
+  size_t totalDataRows = 0;
+  float origEdgeLength = 0.0f;
+  err = parseMicBuffer(begin, end, origEdgeLength, totalDataRows);
+  if(err < 0)
   {
-    parseDataLine(buf, i);
-    buf = in.readLine();
+    return err;
+  }
+  // Contents that did not come from the file have no cache file
+  return processRows(origEdgeLength, totalDataRows, false, 0);
+}
 
-    ++counter;
-    if(in.atEnd())
-    {
-      break;
-    }
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MicReader::checkRegionOfInterest()
+{
+  if(m_RegionOfInterest.enabled && !m_RegionOfInterest.isValid())
+  {
+    QString msg = QObject::tr("The region of interest of the Mic file is empty: %1").arg(getFileName());
+    setErrorMessage(msg);
+    setErrorCode(-116);
+    return -116;
   }
-  totalDataRows = counter;
+  return 0;
+}
 
-  std::vector<float> EA1(totalDataRows, 0.0);
-  std::vector<float> EA2(totalDataRows, 0.0);
-  std::vector<float> EA3(totalDataRows, 0.0);
-  std::vector<float> confidence(totalDataRows, 0.0);
-  std::vector<int> phase(totalDataRows, 0);
-  std::vector<int> up(totalDataRows, 0);
-  std::vector<float> xVal(totalDataRows, 0.0);
-  std::vector<float> yVal(totalDataRows, 0.0);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MicReader::processRows(float origEdgeLength, size_t totalDataRows, bool writeCache, quint64 contentHash)
+{
+  float xMax = 0, yMax = 0;
+  float xMin = 1000000000, yMin = 1000000000;
+  float xMinUM, yMinUM;
+
+  int level = m_Level[0];
+  float newEdgeLength = origEdgeLength / powf(2.0, float(level));
+  edgeLength = newEdgeLength;
+  refinementLevel = level;
+
+  // Find the extent of the triangle centers. A region of interest is the extent of the grid itself.
   float constant = static_cast<float>(1.0f / (2.0 * sqrt(3.0)));
-  float x, y;
-  for(size_t i = 0; i < totalDataRows; ++i)
+  float x = 0.0f, y = 0.0f;
+  for(size_t i = 0; i < totalDataRows && !m_RegionOfInterest.enabled; ++i)
   {
     if(m_Up[i] == 1)
     {
@@ -524,188 +1199,785 @@ int MicReader::readMicFile()
     {
       yMin = y;
     }
-    EA1[i] = m_Euler1[i];
-    EA2[i] = m_Euler2[i];
-    EA3[i] = m_Euler3[i];
-    confidence[i] = m_Conf[i];
-    phase[i] = m_Phase[i];
-    up[i] = m_Up[i];
-    xVal[i] = m_X[i];
-    yVal[i] = m_Y[i];
   }
   xMin = xMin - (2.0 * newEdgeLength);
   xMax = xMax + (2.0 * newEdgeLength);
   yMin = yMin - (2.0 * newEdgeLength);
   yMax = yMax + (2.0 * newEdgeLength);
-  xDim = int((xMax - xMin) / newEdgeLength) + 1;
-  yDim = int((yMax - yMin) / newEdgeLength) + 1;
-  xRes = newEdgeLength * 1000.0f;
-  yRes = newEdgeLength * 1000.0f;
+  if(m_RegionOfInterest.enabled)
+  {
+    xMin = m_RegionOfInterest.xMin;
+    xMax = m_RegionOfInterest.xMax;
+    yMin = m_RegionOfInterest.yMin;
+    yMax = m_RegionOfInterest.yMax;
+  }
+  setGridGeometry(newEdgeLength, xMin, xMax, yMin, yMax);
+  MicGridTarget grid;
+  grid.xDim = xDim;
+  grid.yDim = yDim;
+  grid.spacing = newEdgeLength;
+  grid.xOrigin = xMin;
+  grid.yOrigin = yMin;
+  std::vector<int> owners;
+  if(nullptr != m_GridTarget)
+  {
+    resampleOntoTarget(m_Euler1, m_Euler2, m_Euler3, m_Conf, m_Phase, m_Up, m_X, m_Y, totalDataRows, newEdgeLength);
+    deletePointers();
+    setNumberOfElements(0);
+    return 0;
+  }
+  void* triColumns[Mic::DataColumn::Count];
+  if(!m_ResampleToGrid)
+  {
+    // The parsed rows already are the triangle table. The cache file holds the grid as
+    // well, so it is rasterized into scratch memory that only lives while the file is written.
+    if(writeCache && !m_RowFilter.isActive() && !m_RegionOfInterest.enabled)
+    {
+      void* gridColumns[Mic::DataColumn::Count];
+      for(int column = 0; column < Mic::DataColumn::Count; column++)
+      {
+        triColumns[column] = getColumnData(column);
+        gridColumns[column] = nullptr;
+      }
+      findGridOwners(grid, nullptr, m_X, m_Y, m_Up, totalDataRows, owners);
+      m_CacheFileWritten = writeGridCacheFile(contentHash, newEdgeLength, level, totalDataRows, triColumns, gridColumns, owners.data());
+    }
+    buildLattice();
+    return 0;
+  }
   xMinUM = xMin * 1000.0f;
-  yMinUM = xMin * 1000.0f;
+  yMinUM = yMin * 1000.0f;
 
-  EbsdHeaderEntry::Pointer xDimHeader = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::XDim, xDim);
-  m_HeaderMap[Mic::XDim] = xDimHeader;
+  // The parsed rows are the triangle table that gets rasterized. Take them out of the
+  // member pointers so the grid arrays can be laid out next to the table. The table
+  // stays in its arena for the next read.
+  for(int column = 0; column < Mic::DataColumn::Count; column++)
+  {
+    triColumns[column] = getColumnData(column);
+    setColumnData(column, nullptr);
+  }
+  const float* triX = static_cast<const float*>(triColumns[Mic::DataColumn::X]);
+  const float* triY = static_cast<const float*>(triColumns[Mic::DataColumn::Y]);
+  const int* triUp = static_cast<const int*>(triColumns[Mic::DataColumn::Up]);
+
+  // The GridAllocator may take over the Euler angles, phases and confidences so they
+  // are resampled straight into the memory of the caller
+  MicGridTarget allocated = allocateGridTarget();
+  initPointers(xDim * yDim, false, &allocated);
+
+  // Every grid point takes the values of the triangle that covers it. Points that no
+  // triangle covers keep the zeros from initPointers().
+  findGridOwners(grid, nullptr, triX, triY, triUp, totalDataRows, owners);
+
+  size_t numPoints = static_cast<size_t>(xDim) * static_cast<size_t>(yDim);
+  ScatterOntoTarget(allocated, owners.data(), numPoints, static_cast<const float*>(triColumns[Mic::DataColumn::Euler1]), static_cast<const float*>(triColumns[Mic::DataColumn::Euler2]),
+                    static_cast<const float*>(triColumns[Mic::DataColumn::Euler3]), static_cast<const float*>(triColumns[Mic::DataColumn::Confidence]),
+                    static_cast<const int*>(triColumns[Mic::DataColumn::Good]));
+  for(int column = Mic::DataColumn::Z; column < Mic::DataColumn::Count; column++)
+  {
+    void* gridData = getColumnData(column);
+    if(nullptr == gridData || nullptr == triColumns[column] || column == Mic::DataColumn::Up || column == Mic::DataColumn::Level)
+    {
+      continue;
+    }
+    GatherTypedColumn(column, triColumns[column], gridData, owners.data(), numPoints);
+  }
 
-  EbsdHeaderEntry::Pointer yDimHeader = MicHeaderEntry<int>::NewEbsdHeaderEntry(Mic::YDim, yDim);
-  m_HeaderMap[Mic::YDim] = yDimHeader;
+  // X and Y of the grid are the positions of the covered grid points
+  FillGridPositions(owners.data(), xDim, yDim, xRes, yRes, xMinUM, yMinUM, m_X, m_Y);
 
-  EbsdHeaderEntry::Pointer xResHeader = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::XRes, xRes);
-  m_HeaderMap[Mic::XRes] = xResHeader;
+  if(writeCache && !m_RowFilter.isActive() && !m_RegionOfInterest.enabled)
+  {
+    void* gridColumns[Mic::DataColumn::Count];
+    for(int column = 0; column < Mic::DataColumn::Count; column++)
+    {
+      gridColumns[column] = getColumnData(column);
+    }
+    m_CacheFileWritten = writeGridCacheFile(contentHash, newEdgeLength, level, totalDataRows, triColumns, gridColumns, owners.data());
+  }
 
-  EbsdHeaderEntry::Pointer yResHeader = MicHeaderEntry<float>::NewEbsdHeaderEntry(Mic::YRes, yRes);
-  m_HeaderMap[Mic::YRes] = yResHeader;
+  return 0;
+}
 
-  // Delete any currently existing pointers
-  deletePointers();
-  // Resize pointers
-  initPointers(xDim * yDim);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicReader::writeGridCacheFile(quint64 contentHash, float newEdgeLength, int level, size_t numTriangles, void* const* triColumns, void* const* gridColumns, const int* owners)
+{
+  // The cache file holds every array that is read by default, one grid column after the
+  // other. The grid columns that the reader does not hold, because the GridAllocator took
+  // them or only the triangle table is kept, are rasterized once more for it.
+  const int cellColumns[Mic::Cache::NumCellArrays] = {Mic::DataColumn::Euler1, Mic::DataColumn::Euler2, Mic::DataColumn::Euler3, Mic::DataColumn::Confidence,
+                                                      Mic::DataColumn::Good,   Mic::DataColumn::X,      Mic::DataColumn::Y};
+  const int triangleColumns[Mic::Cache::NumTriangleArrays] = {Mic::DataColumn::Euler1, Mic::DataColumn::Euler2, Mic::DataColumn::Euler3, Mic::DataColumn::Confidence,
+                                                              Mic::DataColumn::Good,   Mic::DataColumn::Up,     Mic::DataColumn::X,      Mic::DataColumn::Y};
+  QVector<const void*> triangleArrays;
+  for(int column : triangleColumns)
+  {
+    if(nullptr == triColumns[column])
+    {
+      return false;
+    }
+    triangleArrays.push_back(triColumns[column]);
+  }
+  size_t numScratchColumns = 0;
+  for(int column : cellColumns)
+  {
+    numScratchColumns += (nullptr == gridColumns[column]) ? 1 : 0;
+  }
+  size_t numPoints = static_cast<size_t>(xDim) * static_cast<size_t>(yDim);
+  MicColumnArena cellArena;
+  if(!cellArena.layout(numScratchColumns, numPoints, true))
+  {
+    return false;
+  }
 
-  float xA = 0.0f, xB = 0.0f, xC = 0.0f, yA = 0.0f, yB = 0.0f, yC = 0.0f;
-  int point = 0;
-  float root3over2 = sqrtf(3.0f) / 2.0f;
-  int check1 = 0, check2 = 0, check3 = 0;
-  for(size_t i = 0; i < totalDataRows; ++i)
+  QVector<const void*> cellArrays;
+  size_t index = 0;
+  for(int column : cellColumns)
   {
-    xA = xVal[i] - xMin;
-    xB = xA + newEdgeLength;
-    xC = xA + (newEdgeLength / 2.0f);
-    if(up[i] == 1)
+    void* gridData = gridColumns[column];
+    if(nullptr == gridData)
     {
-      yA = yVal[i] - yMin;
-      yB = yA;
-      yC = yA + (root3over2 * newEdgeLength);
+      gridData = cellArena.getColumn(index);
+      index++;
+      if(column == Mic::DataColumn::X)
+      {
+        FillGridPositions(owners, xDim, yDim, xRes, yRes, xOrigin * 1000.0f, yOrigin * 1000.0f, static_cast<float*>(gridData), nullptr);
+      }
+      else if(column == Mic::DataColumn::Y)
+      {
+        FillGridPositions(owners, xDim, yDim, xRes, yRes, xOrigin * 1000.0f, yOrigin * 1000.0f, nullptr, static_cast<float*>(gridData));
+      }
+      else
+      {
+        GatherTypedColumn(column, triColumns[column], gridData, owners, numPoints);
+      }
     }
-    if(up[i] == 2)
+    cellArrays.push_back(gridData);
+  }
+  return writeCacheFile(contentHash, newEdgeLength, level, numTriangles, triangleArrays, cellArrays);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MicReader::readMicGeometry()
+{
+  QFile in(getFileName());
+  if(!in.open(QIODevice::ReadOnly))
+  {
+    QString msg = QObject::tr("Mic file could not be opened: %1").arg(getFileName());
+    setErrorMessage(msg);
+    setErrorCode(-113);
+    return -113;
+  }
+
+  int err = checkRegionOfInterest();
+  if(err < 0)
+  {
+    return err;
+  }
+
+  // An existing cache file has the exact dimensions. Only the size and time stamp
+  // are checked here, the content hash is verified when the file is read.
+  if(m_UseCacheFile && !m_RegionOfInterest.enabled)
+  {
+    QFileInfo fi(getFileName());
+    MicCacheFile cache(MicCacheFile::GenerateCacheFilePath(getFileName()));
+    if(cache.open(fi.absoluteFilePath(), fi.size(), fi.lastModified().toMSecsSinceEpoch()))
     {
-      yB = yVal[i] - yMin;
-      yC = yB;
-      yA = yB - (root3over2 * newEdgeLength);
+      const MicCacheHeader& header = cache.getHeader();
+      setGridDimensions(header.xDim, header.yDim, header.xRes, header.yRes);
+      edgeLength = header.edgeLength;
+      refinementLevel = header.level;
+      xOrigin = header.xOrigin;
+      yOrigin = header.yOrigin;
+      return 1;
     }
-    for(int j = int(xA / newEdgeLength); j < int(xB / newEdgeLength) + 1; j++)
+  }
+
+  // Read the First line in the file which is the edge length
+  bool ok = false;
+  float origEdgeLength = in.readLine().trimmed().toFloat(&ok);
+
+  // The first data row holds the level that every triangle in the file was refined to
+  QByteArray buf;
+  while(!in.atEnd() && buf.isEmpty())
+  {
+    buf = in.readLine();
+    if(MicDataParser::isBlank(buf.constData(), buf.constData() + buf.size()))
     {
-      for(int k = int(yA / newEdgeLength); k < int(yC / newEdgeLength) + 1; k++)
-      {
-        x = float(j) * newEdgeLength;
-        y = float(k) * newEdgeLength;
-        check1 = static_cast<int>((x - xB) * (yA - yB) - (xA - xB) * (y - yB));
-        check2 = static_cast<int>((x - xC) * (yB - yC) - (xB - xC) * (y - yC));
-        check3 = static_cast<int>((x - xA) * (yC - yA) - (xC - xA) * (y - yA));
-        if((check1 <= 0 && check2 <= 0 && check3 <= 0) || (check1 >= 0 && check2 >= 0 && check3 >= 0))
-        {
-          point = (k * xDim) + j;
-          m_Euler1[point] = EA1[i];
-          m_Euler2[point] = EA2[i];
-          m_Euler3[point] = EA3[i];
-          m_Conf[point] = confidence[i];
-          m_Phase[point] = phase[i];
-          m_X[point] = float(j) * xRes + xMinUM;
-          m_Y[point] = float(k) * yRes + yMinUM;
-        }
-      }
+      buf.clear();
     }
   }
+  if(buf.isEmpty())
+  {
+    QString msg = QObject::tr("Mic file does not contain any data rows: %1").arg(getFileName());
+    setErrorMessage(msg);
+    setErrorCode(-114);
+    return -114;
+  }
+  int level = parseLevel(buf.constData(), buf.constData() + buf.size());
+  float newEdgeLength = origEdgeLength / powf(2.0, float(level));
+  edgeLength = newEdgeLength;
+  refinementLevel = level;
 
-  return 0;
+  // The grid of a region of interest only depends on the region and the edge length
+  if(m_RegionOfInterest.enabled)
+  {
+    setGridGeometry(newEdgeLength, m_RegionOfInterest.xMin, m_RegionOfInterest.xMax, m_RegionOfInterest.yMin, m_RegionOfInterest.yMax);
+    return 1;
+  }
+
+  // Without scanning every row the extent of the data is not known, so the grid
+  // covers the hexagon of 6 initial triangles that holds all 6 * 4^level possible
+  // rows, padded the same way readMicFile() pads the extent of the actual data.
+  float halfHeight = origEdgeLength * sqrtf(3.0f) / 2.0f;
+  float padding = 2.0f * newEdgeLength;
+  setGridGeometry(newEdgeLength, -origEdgeLength - padding, origEdgeLength + padding, -halfHeight - padding, halfHeight + padding);
+
+  return 1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReader::setGridGeometry(float newEdgeLength, float xMin, float xMax, float yMin, float yMax)
+{
+  xOrigin = xMin;
+  yOrigin = yMin;
+  setGridDimensions(int((xMax - xMin) / newEdgeLength) + 1, int((yMax - yMin) / newEdgeLength) + 1, newEdgeLength * 1000.0f, newEdgeLength * 1000.0f);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReader::setGridDimensions(int xD, int yD, float xR, float yR)
+{
+  xDim = xD;
+  yDim = yD;
+  xRes = xR;
+  yRes = yR;
+
+  setXDim(xDim);
+  setYDim(yDim);
+  setXRes(xRes);
+  setYRes(yRes);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicReader::readCacheFile(quint64 contentHash)
+{
+  QFileInfo fi(getFileName());
+  MicCacheFile cache(MicCacheFile::GenerateCacheFilePath(getFileName()));
+  if(!cache.open(fi.absoluteFilePath(), fi.size(), fi.lastModified().toMSecsSinceEpoch()) || cache.getHeader().contentHash != contentHash)
+  {
+    return false;
+  }
+
+  const MicCacheHeader& header = cache.getHeader();
+  setGridDimensions(header.xDim, header.yDim, header.xRes, header.yRes);
+  edgeLength = header.edgeLength;
+  refinementLevel = header.level;
+  xOrigin = header.xOrigin;
+  yOrigin = header.yOrigin;
+  if(!m_ResampleToGrid)
+  {
+    initPointers(header.numTriangles, true);
+    size_t numBytes = header.numTriangles * 4;
+    CopyCacheArray(m_Euler1, cache.getTriangleArray(Mic::Cache::TriangleEuler1), numBytes);
+    CopyCacheArray(m_Euler2, cache.getTriangleArray(Mic::Cache::TriangleEuler2), numBytes);
+    CopyCacheArray(m_Euler3, cache.getTriangleArray(Mic::Cache::TriangleEuler3), numBytes);
+    CopyCacheArray(m_Conf, cache.getTriangleArray(Mic::Cache::TriangleConfidence), numBytes);
+    CopyCacheArray(m_Phase, cache.getTriangleArray(Mic::Cache::TrianglePhase), numBytes);
+    ::memcpy(m_Up, cache.getTriangleArray(Mic::Cache::TriangleUp), numBytes);
+    ::memcpy(m_X, cache.getTriangleArray(Mic::Cache::TriangleX), numBytes);
+    ::memcpy(m_Y, cache.getTriangleArray(Mic::Cache::TriangleY), numBytes);
+    std::fill(m_Level, m_Level + header.numTriangles, header.level);
+    buildLattice();
+    return true;
+  }
+  MicGridTarget allocated = allocateGridTarget();
+  initPointers(header.numCells, false, &allocated);
+
+  size_t numBytes = header.numCells * 4;
+  CopyCacheArray(m_Euler1, cache.getCellArray(Mic::Cache::CellEuler1), numBytes);
+  CopyCacheArray(m_Euler2, cache.getCellArray(Mic::Cache::CellEuler2), numBytes);
+  CopyCacheArray(m_Euler3, cache.getCellArray(Mic::Cache::CellEuler3), numBytes);
+  CopyCacheArray(m_Conf, cache.getCellArray(Mic::Cache::CellConfidence), numBytes);
+  CopyCacheArray(m_Phase, cache.getCellArray(Mic::Cache::CellPhase), numBytes);
+  CopyCacheArray(m_X, cache.getCellArray(Mic::Cache::CellX), numBytes);
+  CopyCacheArray(m_Y, cache.getCellArray(Mic::Cache::CellY), numBytes);
+
+  // The columns that the GridAllocator took go straight from the cache file into its arrays
+  const float* cellEuler1 = static_cast<const float*>(cache.getCellArray(Mic::Cache::CellEuler1));
+  const float* cellEuler2 = static_cast<const float*>(cache.getCellArray(Mic::Cache::CellEuler2));
+  const float* cellEuler3 = static_cast<const float*>(cache.getCellArray(Mic::Cache::CellEuler3));
+  const float* cellConf = static_cast<const float*>(cache.getCellArray(Mic::Cache::CellConfidence));
+  CopyCacheArray(allocated.phases, cache.getCellArray(Mic::Cache::CellPhase), numBytes);
+  if(nullptr != allocated.compactConfidences)
+  {
+    MicCompactCodec::encodeConfidences(cellConf, allocated.compactConfidences, header.numCells);
+  }
+  else
+  {
+    CopyCacheArray(allocated.confidences, cellConf, numBytes);
+  }
+  for(size_t point = 0; point < header.numCells; point++)
+  {
+    if(nullptr != allocated.compactEulerAngles)
+    {
+      allocated.compactEulerAngles[3 * point] = MicCompactCodec::encodeEulerAngle(cellEuler1[point]);
+      allocated.compactEulerAngles[3 * point + 1] = MicCompactCodec::encodeEulerAngle(cellEuler2[point]);
+      allocated.compactEulerAngles[3 * point + 2] = MicCompactCodec::encodeEulerAngle(cellEuler3[point]);
+    }
+    else if(nullptr != allocated.eulerAngles)
+    {
+      allocated.eulerAngles[3 * point] = cellEuler1[point];
+      allocated.eulerAngles[3 * point + 1] = cellEuler2[point];
+      allocated.eulerAngles[3 * point + 2] = cellEuler3[point];
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicReader::writeCacheFile(quint64 contentHash, float newEdgeLength, int level, size_t numTriangles, const QVector<const void*>& triangleArrays, const QVector<const void*>& cellArrays)
+{
+  QFileInfo fi(getFileName());
+  MicCacheHeader header;
+  header.micFileSize = fi.size();
+  header.micLastModified = fi.lastModified().toMSecsSinceEpoch();
+  header.contentHash = contentHash;
+  header.xDim = xDim;
+  header.yDim = yDim;
+  header.xRes = xRes;
+  header.yRes = yRes;
+  header.edgeLength = newEdgeLength;
+  header.level = level;
+  header.xOrigin = xOrigin;
+  header.yOrigin = yOrigin;
+  header.numTriangles = numTriangles;
+  header.numCells = static_cast<quint64>(xDim) * static_cast<quint64>(yDim);
+
+  // A cache file that can not be written (read only directory, full disk) only costs the next load some time
+  return MicCacheFile::WriteFile(MicCacheFile::GenerateCacheFilePath(getFileName()), header, fi.absoluteFilePath(), triangleArrays, cellArrays);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReader::buildLattice()
+{
+  // Files that are not on a regular lattice are supported, they keep their X, Y and Up columns
+  MicLattice::Pointer lattice(new MicLattice());
+  if(lattice->build(m_X, m_Y, m_Up, getNumberOfElements(), edgeLength))
+  {
+    m_Lattice = lattice;
+    m_X = nullptr;
+    m_Y = nullptr;
+    m_Up = nullptr;
+  }
+  // The table is the data of the reader from now on, so it gives back the rows that
+  // were dropped while parsing and the columns that the lattice replaced
+  shrinkColumns(getNumberOfElements());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReader::findGridOwners(const MicGridTarget& grid, const MicLattice* lattice, const float* triX, const float* triY, const int* triUp, size_t numTriangles, std::vector<int>& owners)
+{
+  size_t numPoints = (grid.xDim > 0 && grid.yDim > 0) ? static_cast<size_t>(grid.xDim) * static_cast<size_t>(grid.yDim) : 0;
+  owners.assign(numPoints, -1);
+  if(numPoints == 0 || numTriangles == 0)
+  {
+    return;
+  }
+
+  // The map of a lattice only depends on the grid and the cells, so the layers of a stack
+  // share it and every layer after the first only looks up its triangles
+  MicLattice placed;
+  if(nullptr == lattice && placed.build(triX, triY, triUp, numTriangles, edgeLength))
+  {
+    lattice = &placed;
+  }
+  if(nullptr != lattice)
+  {
+    MicCoverageMap::Pointer coverage = MicCoverageMap::Get(grid.xDim, grid.yDim, grid.spacing, grid.xOrigin, grid.yOrigin, *lattice, refinementLevel, m_ParallelParsing);
+    coverage->findOwners(*lattice, owners.data());
+    return;
+  }
+
+  MicTriangleRasterizer rasterizer(grid.xDim, grid.yDim, grid.spacing, grid.xOrigin, grid.yOrigin);
+  rasterizer.setParallel(m_ParallelParsing);
+  rasterizer.rasterize(triX, triY, triUp, numTriangles, edgeLength, owners.data());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReader::resampleOntoTarget(const float* triEuler1, const float* triEuler2, const float* triEuler3, const float* triConf, const int* triPhase, const int* triUp, const float* triX,
+                                   const float* triY, size_t numTriangles, float newEdgeLength)
+{
+  const MicGridTarget& target = *m_GridTarget;
+  std::vector<int> owners;
+  findGridOwners(target, nullptr, triX, triY, triUp, numTriangles, owners);
+  size_t numPoints = static_cast<size_t>(target.xDim) * static_cast<size_t>(target.yDim);
+  ScatterOntoTarget(target, owners.data(), numPoints, triEuler1, triEuler2, triEuler3, triConf, triPhase);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicReader::resampleTriangles(const MicGridTarget& target)
+{
+  if(m_ResampleToGrid)
+  {
+    return false;
+  }
+  // The lattice replaced the X, Y and Up columns of a file that is on one
+  size_t numTriangles = getNumberOfElements();
+  if(nullptr == m_Lattice.get() && numTriangles > 0 && (nullptr == m_X || nullptr == m_Y || nullptr == m_Up))
+  {
+    return false;
+  }
+
+  std::vector<int> owners;
+  findGridOwners(target, m_Lattice.get(), m_X, m_Y, m_Up, numTriangles, owners);
+  size_t numPoints = static_cast<size_t>(target.xDim) * static_cast<size_t>(target.yDim);
+  ScatterOntoTarget(target, owners.data(), numPoints, m_Euler1, m_Euler2, m_Euler3, m_Conf, m_Phase);
+  return true;
 }
 
 // -----------------------------------------------------------------------------
 //  Read the Matching Config file to the .mic file
 // -----------------------------------------------------------------------------
-void MicReader::parseHeaderLine(QByteArray& line)
+void MicReader::parseHeaderLine(const char* begin, const char* end)
 {
-  if(line[0] == '#')
+  if(begin == end || *begin == '#')
   {
     return;
   }
-  line = line.trimmed();
-  line = line.simplified();
-
-  // Split the lines based on 'space' delimiter
-  QList<QByteArray> tokens = line.split(' ');
-  QString key(tokens[0]);
-
-  EbsdHeaderEntry::Pointer p = m_HeaderMap[key];
-  if(nullptr == p.get())
-  {
-/*
-  std::cout << "---------------------------" << std::endl;
-  std::cout << "Could not find header entry for key'" << word << "'" << std::endl;
-  QString upper(word);
-  std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
-  std::cout << "#define ANG_" << upper << "     \"" << word << "\"" << std::endl;
-  std::cout << "const QString " << word << "(ANG_" << upper << ");" << std::endl;
-
-  std::cout << "angInstanceProperty(AngHeaderEntry<float>. float, " << word << "Ebsd::Ang::" << word << std::endl;
-  std::cout << "m_Headermap[Ebsd::Ang::" << word << "] = AngHeaderEntry<float>::NewEbsdHeaderEntry(Ebsd::Ang::" << word << ");" << std::endl;
-  */
-#if 0
-    std::cout << "<tr>\n    <td>" << word << "</td>\n    <td>" << "H5T_STRING" << "</td>\n";
-    std::cout << "    <td colspan=\"2\"> Contains value for the header entry " << word << "</td>\n</tr>" << std::endl;
-#endif
+
+  const char* key = MicDataParser::skipWhiteSpace(begin, end);
+  const char* keyEnd = key;
+  while(keyEnd < end && !MicDataParser::isWhiteSpace(*keyEnd))
+  {
+    ++keyEnd;
+  }
+
+  const MicHeaderKey* entry = FindHeaderKey(key, keyEnd - key);
+  if(nullptr == entry)
+  {
     return;
   }
 
-    int size = tokens[0].count();
-    line = line.mid(size);
-    p->parseValue(line); // Send the second part of the QByteArray, just the value part
-#if 0
-    std::cout << "<tr>\n    <td>" << p->getKey() << "</td>\n    <td>" << p->getHDFType() << "</td>\n";
-    std::cout << "    <td colspan=\"2\"> Contains value for the header entry " << p->getKey() << "</td>\n</tr>" << std::endl;
+  // The value is the rest of the line after the key
+  const char* ptr = keyEnd;
+  if(nullptr != entry->intValue)
+  {
+    int value = 0;
+    m_HeaderValues.*(entry->intValue) = MicDataParser::scanInt(ptr, end, value) ? value : 0;
+  }
+  else if(nullptr != entry->floatValue)
+  {
+    float value = 0.0f;
+    m_HeaderValues.*(entry->floatValue) = MicDataParser::scanFloat(ptr, end, value) ? value : 0.0f;
+  }
+  else
+  {
+    m_HeaderValues.*(entry->stringValue) = QString(QByteArray::fromRawData(ptr, static_cast<int>(end - ptr)).simplified());
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MicReader::parseMicBuffer(const char* begin, const char* end, float& origEdgeLength, size_t& totalDataRows)
+{
+  totalDataRows = 0;
+
+  // Read the First line in the file which is the edge length
+  const char* lineEnd = MicDataParser::findLineEnd(begin, end);
+  bool ok = false;
+  origEdgeLength = QByteArray::fromRawData(begin, static_cast<int>(lineEnd - begin)).trimmed().toFloat(&ok);
+
+  // Skip to the first line of actual data
+  const char* ptr = (lineEnd < end) ? lineEnd + 1 : end;
+  lineEnd = MicDataParser::findLineEnd(ptr, end);
+  while(ptr < end && MicDataParser::isBlank(ptr, lineEnd))
+  {
+    ptr = (lineEnd < end) ? lineEnd + 1 : end;
+    lineEnd = MicDataParser::findLineEnd(ptr, end);
+  }
+  if(ptr >= end)
+  {
+    QString msg = QObject::tr("Mic file does not contain any data rows: %1").arg(getFileName());
+    setErrorMessage(msg);
+    setErrorCode(-114);
+    return -114;
+  }
+
+  // The level of the first row determines the maximum number of rows in the file
+  int level = parseLevel(ptr, lineEnd);
+  size_t totalPossibleDataRows = static_cast<size_t>(6.0f * powf(4.0f, float(level)));
+  planRowFilter(origEdgeLength / powf(2.0f, float(level)));
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  size_t numChunks = std::min(static_cast<size_t>(end - ptr) / std::max(m_ParallelChunkSize, static_cast<size_t>(1)), static_cast<size_t>(4 * tbb::task_scheduler_init::default_num_threads()));
+  if(m_ParallelParsing && numChunks > 1)
+  {
+    // Count the rows in each newline aligned chunk so every chunk knows which row it starts at.
+    // With a bounding box only the rows inside it are counted, so only those are allocated.
+    std::vector<const char*> chunkBoundaries = MicDataParser::findChunkBoundaries(ptr, end, numChunks);
+    numChunks = chunkBoundaries.size() - 1;
+    std::vector<size_t> rowOffsets(numChunks, 0);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks), CountMicRowsImpl(chunkBoundaries, rowOffsets, m_ParseFilter), tbb::auto_partitioner());
+
+    size_t row = 0;
+    for(size_t i = 0; i < numChunks; i++)
+    {
+      size_t numRows = rowOffsets[i];
+      rowOffsets[i] = row;
+      row += numRows;
+    }
+    size_t numRows = std::min(row, totalPossibleDataRows);
+    initPointers(numRows, true);
+    planColumns();
+
+    std::vector<size_t> keptRows(numChunks, 0);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks), ParseMicRowsImpl(this, chunkBoundaries, rowOffsets, keptRows, numRows), tbb::auto_partitioner());
+
+    // Every chunk kept its rows at the start of its own range. Close the gaps between them.
+    totalDataRows = 0;
+    for(size_t i = 0; i < numChunks; i++)
+    {
+      if(totalDataRows != rowOffsets[i] && keptRows[i] > 0)
+      {
+        moveRows(rowOffsets[i], totalDataRows, keptRows[i]);
+      }
+      totalDataRows += keptRows[i];
+    }
+    return finishRows(numRows, totalDataRows);
+  }
 #endif
+
+  // Counting the lines is much cheaper than parsing them and lets the triangle table
+  // hold just the rows in the file instead of every row the level allows for. With a
+  // bounding box only the rows inside it are counted.
+  size_t numRows = 0;
+  if(m_ParseFilter.useBoundingBox)
+  {
+    numRows = MicDataParser::countRowsInBox(ptr, end, m_ParseFilter.xMin, m_ParseFilter.xMax, m_ParseFilter.yMin, m_ParseFilter.yMax);
+  }
+  else
+  {
+    numRows = MicDataParser::countRows(ptr, end);
+  }
+  numRows = std::min(numRows, totalPossibleDataRows);
+  initPointers(numRows, true);
+  planColumns();
+  totalDataRows = parseDataRows(ptr, end, 0, numRows);
+  return finishRows(numRows, totalDataRows);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReader::planRowFilter(float newEdgeLength)
+{
+  m_ParseFilter = m_RowFilter;
+  if(!m_RegionOfInterest.enabled)
+  {
+    return;
+  }
+
+  // The X and Y of a row are the left vertex of its triangle, which spans one edge length
+  // to the right and one triangle height up or down from there
+  float height = newEdgeLength * sqrtf(3.0f) / 2.0f;
+  float xMin = m_RegionOfInterest.xMin - newEdgeLength;
+  float xMax = m_RegionOfInterest.xMax;
+  float yMin = m_RegionOfInterest.yMin - height;
+  float yMax = m_RegionOfInterest.yMax + height;
+  if(m_ParseFilter.useBoundingBox)
+  {
+    xMin = std::max(xMin, m_ParseFilter.xMin);
+    xMax = std::min(xMax, m_ParseFilter.xMax);
+    yMin = std::max(yMin, m_ParseFilter.yMin);
+    yMax = std::min(yMax, m_ParseFilter.yMax);
+  }
+  m_ParseFilter.useBoundingBox = true;
+  m_ParseFilter.xMin = xMin;
+  m_ParseFilter.xMax = xMax;
+  m_ParseFilter.yMin = yMin;
+  m_ParseFilter.yMax = yMax;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MicReader::finishRows(size_t numRows, size_t numKeptRows)
+{
+  if(numKeptRows == 0)
+  {
+    QString msg = QObject::tr("None of the rows of the Mic file pass the row filter or reach into the region of interest: %1").arg(getFileName());
+    setErrorMessage(msg);
+    setErrorCode(-115);
+    return -115;
+  }
+  if(numKeptRows == numRows)
+  {
+    return 0;
+  }
+  // A triangle table that outlives the read gives back the dropped rows in buildLattice()
+  setNumberOfElements(numKeptRows);
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t MicReader::parseDataRows(const char* begin, const char* end, size_t firstRow, size_t endRow)
+{
+  size_t row = firstRow;
+  const char* ptr = begin;
+  while(ptr < end && row < endRow)
+  {
+    const char* lineEnd = MicDataParser::findLineEnd(ptr, end);
+    if(!MicDataParser::isBlank(ptr, lineEnd) && parseDataLine(ptr, lineEnd, row))
+    {
+      ++row;
+    }
+    ptr = (lineEnd < end) ? lineEnd + 1 : end;
+  }
+  return row - firstRow;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int MicReader::parseLevel(const char* begin, const char* end)
+{
+  // The level is the 5th column: x, y, z, up/down, level
+  float value = 0.0f;
+  int up = 0;
+  int level = 0;
+  const char* ptr = begin;
+  if(!(MicDataParser::scanFloat(ptr, end, value) && MicDataParser::scanFloat(ptr, end, value) && MicDataParser::scanFloat(ptr, end, value) && MicDataParser::scanInt(ptr, end, up) &&
+       MicDataParser::scanInt(ptr, end, level)))
+  {
+    level = 0;
+  }
+  return level;
 }
 
 // -----------------------------------------------------------------------------
 //  Read the data part of the Mic file
 // -----------------------------------------------------------------------------
-void MicReader::parseDataLine(QByteArray& line, size_t i)
-{
-  /* When reading the data there should be at least 8 cols of data. There may even
-   * be 10 columns of data. The column names should be the following:
-   * phi1
-   * phi
-   * phi2
-   * x pos
-   * y pos
-   * image quality
-   * confidence index
-   * phase
-   * SEM Signal
-   * Fit of Solution
-   *
-   * Some HEDM Mic files do NOT have all 10 columns. Assume these are lacking the last
-   * 2 columns and all the other columns are the same as above.
+bool MicReader::parseDataLine(const char* begin, const char* end, size_t i)
+{
+  /* Each data row has 19 columns:
+   * x pos, y pos, z pos (float)
+   * up/down, level, good (int)
+   * phi1, phi, phi2, confidence (float)
+   * 3 more float columns and 6 more int columns.
+   * The values are converted exactly as sscanf("%f") and sscanf("%d") did. Only the
+   * columns that planColumns() picked are converted, the others are skipped as plain
+   * tokens and nothing past the last picked column is looked at. The columns that only
+   * the parse filter needs are converted into the scratch values.
    */
-  float p1 = 0.0f, p = 0.0f, p2 = 0.0f, x = -1.0f, y = -1.0f, z = -1.0f, conf = -1.0f, junk1, junk2, junk3;
-  int up = 0, level = 0, good = 0, junk4, junk5, junk6, junk7, junk8, junk9;
-  size_t offset = 0;
-  size_t featuresRead = 0;
-  featuresRead = sscanf(line.data(), "%f %f %f %d %d %d %f %f %f %f %f %f %f %d %d %d %d %d %d", &x, &y, &z, &up, &level, &good, &p1, &p, &p2, &conf, &junk1, &junk2, &junk3, &junk4, &junk5, &junk6,
-                        &junk7, &junk8, &junk9);
-  if(featuresRead != 19)
+  float scratchFloats[Mic::DataColumn::Count];
+  int scratchInts[Mic::DataColumn::Count];
+  const char* ptr = begin;
+  int column = 0;
+  for(; column < m_NumParsedColumns; column++)
+  {
+    bool isFloat = (Mic::DataColumn::Types[column] == 'f');
+    void* target = m_ColumnTargets[column];
+    if(nullptr != target)
+    {
+      target = isFloat ? static_cast<void*>(static_cast<float*>(target) + i) : static_cast<void*>(static_cast<int*>(target) + i);
+    }
+    else if(m_FilterColumns[column])
+    {
+      target = isFloat ? static_cast<void*>(scratchFloats + column) : static_cast<void*>(scratchInts + column);
+    }
+
+    bool ok = false;
+    if(nullptr == target)
+    {
+      ok = MicDataParser::skipToken(ptr, end);
+    }
+    else if(isFloat)
+    {
+      ok = MicDataParser::scanFloat(ptr, end, *static_cast<float*>(target));
+    }
+    else
+    {
+      ok = MicDataParser::scanInt(ptr, end, *static_cast<int*>(target));
+    }
+    if(!ok)
+    {
+      break;
+    }
+  }
+  if(column < m_NumParsedColumns)
   {
     qDebug() << "MicReader Error: Not enough columns were read for row " << i;
+    // Positions and the confidence of a short row read as -1, everything else as 0
+    for(; column < m_NumParsedColumns; column++)
+    {
+      bool negative = (column <= Mic::DataColumn::Z || column == Mic::DataColumn::Confidence);
+      scratchFloats[column] = negative ? -1.0f : 0.0f;
+      scratchInts[column] = 0;
+      void* target = m_ColumnTargets[column];
+      if(nullptr == target)
+      {
+        continue;
+      }
+      if(Mic::DataColumn::Types[column] == 'f')
+      {
+        static_cast<float*>(target)[i] = scratchFloats[column];
+      }
+      else
+      {
+        static_cast<int*>(target)[i] = 0;
+      }
+    }
   }
-  offset = i;
 
-  if(good > 0)
+  if(m_ParseFilter.isActive())
   {
-    good = 1;
+    float confidence = (nullptr != m_Conf) ? m_Conf[i] : scratchFloats[Mic::DataColumn::Confidence];
+    int good = (nullptr != m_Phase) ? m_Phase[i] : scratchInts[Mic::DataColumn::Good];
+    float x = (nullptr != m_X) ? m_X[i] : scratchFloats[Mic::DataColumn::X];
+    float y = (nullptr != m_Y) ? m_Y[i] : scratchFloats[Mic::DataColumn::Y];
+    if(m_ParseFilter.useMinConfidence && confidence < m_ParseFilter.minConfidence)
+    {
+      return false;
+    }
+    if(m_ParseFilter.goodOnly && good <= 0)
+    {
+      return false;
+    }
+    if(m_ParseFilter.useBoundingBox && (x < m_ParseFilter.xMin || x > m_ParseFilter.xMax || y < m_ParseFilter.yMin || y > m_ParseFilter.yMax))
+    {
+      return false;
+    }
   }
-  else
+
+  if(nullptr != m_Phase)
   {
-    good = 0;
+    m_Phase[i] = (m_Phase[i] > 0) ? 1 : 0;
   }
-
-  m_Euler1[offset] = p1;
-  m_Euler2[offset] = p;
-  m_Euler3[offset] = p2;
-  m_Conf[offset] = conf;
-  m_Phase[offset] = good;
-  m_Level[offset] = level;
-  m_Up[offset] = up;
-  m_X[offset] = x;
-  m_Y[offset] = y;
+  return true;
 }
 
 // -----------------------------------------------------------------------------
@@ -753,3 +2025,93 @@ float MicReader::getYStep()
 {
   return getYRes();
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float MicReader::getEdgeLength()
+{
+  return edgeLength;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicLattice::Pointer MicReader::getLattice()
+{
+  return m_Lattice;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicReader::getCacheFileWritten() const
+{
+  return m_CacheFileWritten;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float MicReader::getXOrigin()
+{
+  return xOrigin;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float MicReader::getYOrigin()
+{
+  return yOrigin;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReader::setGridTarget(const MicGridTarget* target)
+{
+  m_GridTarget = target;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const MicGridTarget* MicReader::getGridTarget() const
+{
+  return m_GridTarget;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReader::setGridAllocator(const GridAllocator& allocator)
+{
+  m_GridAllocator = allocator;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const MicReader::GridAllocator& MicReader::getGridAllocator() const
+{
+  return m_GridAllocator;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicGridTarget MicReader::allocateGridTarget()
+{
+  MicGridTarget target;
+  target.xDim = xDim;
+  target.yDim = yDim;
+  target.spacing = edgeLength;
+  target.xOrigin = xOrigin;
+  target.yOrigin = yOrigin;
+  if(m_GridAllocator && nullptr == m_GridTarget)
+  {
+    m_GridAllocator(target);
+  }
+  return target;
+}
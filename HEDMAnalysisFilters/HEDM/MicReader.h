@@ -35,8 +35,12 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include <QtCore/QString>
 #include <QtCore/QMap>
+#include <QtCore/QSet>
 
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/EbsdSetGetMacros.h"
@@ -44,11 +48,107 @@
 #include "EbsdLib/EbsdReader.h"
 
 
+#include "MicColumnArena.h"
+#include "MicCompactCodec.h"
 #include "MicConstants.h"
-#include "MicHeaderEntry.h"
+#include "MicLattice.h"
 #include "MicPhase.h"
 
+class QIODevice;
+
+/**
+ * @brief Plain storage for the .config header values of a MicReader. There is one
+ * member for each entry in MIC_HEADER_ENTRIES.
+ */
+struct MicHeaderValues
+{
+#define MIC_HEADER_VALUE(type, prpty) type prpty = type();
+  MIC_HEADER_ENTRIES(MIC_HEADER_VALUE)
+#undef MIC_HEADER_VALUE
+};
 
+/**
+ * @brief A grid owned by the caller, for example one slice of a 3D volume, that
+ * MicReader::readFile() resamples the triangles onto instead of allocating a grid of
+ * its own. Grid points that no triangle covers are not written.
+ */
+struct MicGridTarget
+{
+  int xDim = 0;
+  int yDim = 0;
+  float spacing = 0.0f; // Distance between grid points in the units of the .mic file
+  float xOrigin = 0.0f; // Position of grid point (0, 0) in the units of the .mic file
+  float yOrigin = 0.0f;
+  float* eulerAngles = nullptr; // 3 values per grid point
+  int* phases = nullptr;
+  float* confidences = nullptr;
+  // MicCompactCodec codes that are written instead of eulerAngles and confidences when set
+  uint16_t* compactEulerAngles = nullptr; // 3 codes per grid point
+  uint8_t* compactConfidences = nullptr;
+};
+
+/**
+ * @brief Rows of the .mic file that MicReader::readFile() drops while it parses the
+ * file. A dropped row is never stored or resampled, so the grid only covers the rows
+ * that are kept. Every test is off by default.
+ */
+struct MicRowFilter
+{
+  bool useMinConfidence = false;
+  float minConfidence = 0.0f; // Rows whose confidence is below this value are dropped
+  bool goodOnly = false;      // Rows whose good flag (the Phase array) is 0 are dropped
+  bool useBoundingBox = false;
+  float xMin = 0.0f; // Rows whose X and Y columns are outside of the box are dropped,
+  float xMax = 0.0f; // in the units of the .mic file
+  float yMin = 0.0f;
+  float yMax = 0.0f;
+
+  bool isActive() const
+  {
+    return useMinConfidence || goodOnly || useBoundingBox;
+  }
+
+  bool operator==(const MicRowFilter& other) const
+  {
+    return useMinConfidence == other.useMinConfidence && minConfidence == other.minConfidence && goodOnly == other.goodOnly && useBoundingBox == other.useBoundingBox &&
+           xMin == other.xMin && xMax == other.xMax && yMin == other.yMin && yMax == other.yMax;
+  }
+
+  bool operator!=(const MicRowFilter& other) const
+  {
+    return !(*this == other);
+  }
+};
+
+/**
+ * @brief A rectangle of the sample, in the units of the .mic file, that
+ * MicReader::readFile() restricts the read to. Only the rows whose triangles reach
+ * into the rectangle are kept and the grid spans the rectangle instead of the extent
+ * of the data, so a small window of a large layer is cheap to resample.
+ */
+struct MicRegionOfInterest
+{
+  bool enabled = false;
+  float xMin = 0.0f;
+  float xMax = 0.0f;
+  float yMin = 0.0f;
+  float yMax = 0.0f;
+
+  bool isValid() const
+  {
+    return xMin <= xMax && yMin <= yMax;
+  }
+
+  bool operator==(const MicRegionOfInterest& other) const
+  {
+    return enabled == other.enabled && xMin == other.xMin && xMax == other.xMax && yMin == other.yMin && yMax == other.yMax;
+  }
+
+  bool operator!=(const MicRegionOfInterest& other) const
+  {
+    return !(*this == other);
+  }
+};
 
 /**
 * @class MicReader MicReader.h EbsdLib/HEDM/MicReader.h
@@ -64,79 +164,125 @@ class MicReader : public EbsdReader
     MicReader();
     ~MicReader() override;
 
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, InfileBasename, Mic::InfileBasename)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, InfileSerialLength, Mic::InfileSerialLength)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, OutfileBasename, Mic::OutfileBasename)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, OutfileSerialLength, Mic::OutfileSerialLength)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, OutStructureBasename, Mic::OutStructureBasename)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, BCPeakDetectorOffset, Mic::BCPeakDetectorOffset)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, InFileType, Mic::InFileType)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, OutfileExtension, Mic::OutfileExtension)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, InfileExtesnion, Mic::InfileExtesnion)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, BeamEnergyWidth, Mic::BeamEnergyWidth)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, BeamDirection, Mic::BeamDirection)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, BeamDeflectionChiLaue, Mic::BeamDeflectionChiLaue)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, BeamHeight, Mic::BeamHeight)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, BeamEnergy, Mic::BeamEnergy)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, DetectorFilename, Mic::DetectorFilename)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, OptimizationConstrainFilename, Mic::OptimizationConstrainFilename)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, EtaLimit, Mic::EtaLimit)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, SampleFilename, Mic::SampleFilename)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, StructureFilename, Mic::StructureFilename)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, RotationRangeFilename, Mic::RotationRangeFilename)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, FundamentalZoneFilename, Mic::FundamentalZoneFilename)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, SampleSymmetry, Mic::SampleSymmetry)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, MinAmplitudeFraction, Mic::MinAmplitudeFraction)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, MaxQ, Mic::MaxQ)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, MaxInitSideLength, Mic::MaxInitSideLength)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, MinSideLength, Mic::MinSideLength)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, LocalOrientationGridRadius, Mic::LocalOrientationGridRadius)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, MinLocalResolution, Mic::MinLocalResolution)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, MaxLocalResolution, Mic::MaxLocalResolution)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, MaxAcceptedCost, Mic::MaxAcceptedCost)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, MaxConvergenceCost, Mic::MaxConvergenceCost)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, MaxMCSteps, Mic::MaxMCSteps)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, MCRadiusScaleFactor, Mic::MCRadiusScaleFactor)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, SuccessiveRestarts, Mic::SuccessiveRestarts)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, SecondsBetweenSave, Mic::SecondsBetweenSave)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, NumParameterOptimizationSteps, Mic::NumParameterOptimizationSteps)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, NumElementToOptimizePerPE, Mic::NumElementToOptimizePerPE)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, OptimizationFilename, Mic::OptimizationFilename)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, DetectionLimitFilename, Mic::DetectionLimitFilename)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, ParameterMCInitTemperature, Mic::ParameterMCInitTemperature)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, OrientationSearchMethod, Mic::OrientationSearchMethod)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, CoolingFraction, Mic::CoolingFraction)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, ThermalizeFraction, Mic::ThermalizeFraction)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, ParameterRefinements, Mic::ParameterRefinements)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, NumDetectors, Mic::NumDetectors)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, DetectorSpacing, Mic::DetectorSpacing)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, DetectorSpacingDeviation, Mic::DetectorSpacingDeviation)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, DetectorOrientationDeviationInEuler, Mic::DetectorOrientationDeviationInEuler)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, DetectorOrientationDeviationInSO3, Mic::DetectorOrientationDeviationInSO3)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, ParamMCMaxLocalRestarts, Mic::ParamMCMaxLocalRestarts)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, ParamMCMaxGlobalRestarts, Mic::ParamMCMaxGlobalRestarts)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, ParamMCNumGlobalSearchElements, Mic::ParamMCNumGlobalSearchElements)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, ConstrainedOptimization, Mic::ConstrainedOptimization)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, SearchVolumeReductionFactor, Mic::SearchVolumeReductionFactor)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, FileNumStart, Mic::FileNumStart)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, FileNumEnd, Mic::FileNumEnd)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, SampleLocation, Mic::SampleLocation)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, SampleOrientation, Mic::SampleOrientation)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, EnableStrain, Mic::EnableStrain)
-    EBSDHEADER_INSTANCE_PROPERTY(MicStringHeaderEntry, QString, SampleCenter, Mic::SampleCenter)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, SampleRadius, Mic::SampleRadius)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, MaxDeepeningHitRatio, Mic::MaxDeepeningHitRatio)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, ConsistencyError, Mic::ConsistencyError)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, BraggFilterTolerance, Mic::BraggFilterTolerance)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, MinAccelerationThreshold, Mic::MinAccelerationThreshold)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, MaxDiscreteCandidates, Mic::MaxDiscreteCandidates)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, XDim, Mic::XDim)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<int>, int, YDim, Mic::YDim)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, XRes, Mic::XRes)
-    EBSDHEADER_INSTANCE_PROPERTY(MicHeaderEntry<float>, float, YRes, Mic::YRes)
+    /**
+     * @brief A get and set method for every value in MIC_HEADER_ENTRIES, for example
+     * getXDim() and setXDim(). The values are stored in a plain MicHeaderValues struct.
+     */
+#define MIC_HEADER_PROPERTY(type, prpty)                                                                                                                                                               \
+  void set##prpty(const type& value)                                                                                                                                                                   \
+  {                                                                                                                                                                                                    \
+    m_HeaderValues.prpty = value;                                                                                                                                                                      \
+  }                                                                                                                                                                                                    \
+  type get##prpty() const                                                                                                                                                                              \
+  {                                                                                                                                                                                                    \
+    return m_HeaderValues.prpty;                                                                                                                                                                       \
+  }
+    MIC_HEADER_ENTRIES(MIC_HEADER_PROPERTY)
+#undef MIC_HEADER_PROPERTY
 
     EBSD_INSTANCE_PROPERTY(QVector<MicPhase::Pointer>, PhaseVector)
 
+    /**
+     * @brief When true (the default) large .mic files are split into newline aligned
+     * chunks that are parsed on separate threads and the triangles are resampled onto
+     * the grid in bands of rows on separate threads. This only has an effect when the
+     * plugin is built with SIMPL_USE_PARALLEL_ALGORITHMS.
+     */
+    EBSD_INSTANCE_PROPERTY(bool, ParallelParsing)
+
+    /**
+     * @brief The default ParallelChunkSize, the smallest amount of row data that is worth
+     * handing to a separate thread
+     */
+    static const size_t k_DefaultParallelChunkSize = 256 * 1024;
+
+    /**
+     * @brief The smallest number of bytes of data rows that one chunk of a parallel parse
+     * holds. Files with less than twice as many bytes of rows are parsed on one thread.
+     */
+    EBSD_INSTANCE_PROPERTY(size_t, ParallelChunkSize)
+
+    /**
+     * @brief The default DeviceReadTimeout, in milliseconds
+     */
+    static const int k_DefaultDeviceReadTimeout = 30000;
+
+    /**
+     * @brief The milliseconds readDevice() waits for more data from a device that is not
+     * at its end before it gives up and reports the read as stalled
+     */
+    EBSD_INSTANCE_PROPERTY(int, DeviceReadTimeout)
+
+    /**
+     * @brief When true the parsed triangle table and the rasterized grid are written
+     * to a binary .miccache file next to the .mic file. Later reads of the same,
+     * unchanged .mic file load the grid from that file instead of parsing the text.
+     * The .config and .dat files are always read.
+     */
+    EBSD_INSTANCE_PROPERTY(bool, UseCacheFile)
+
+    /**
+     * @brief When true (the default) readFile() resamples the triangles onto a regular
+     * grid. When false the data arrays hold the triangle table as it is in the .mic
+     * file, one element per triangle. The triangles are placed on a MicLattice, see
+     * getLattice(), and the X, Y and Up arrays are released because the lattice holds
+     * the same information. If the triangles are not on a regular lattice there is no
+     * lattice and X, Y and Up are kept, with X and Y the left vertex of each triangle
+     * in the units of the file.
+     */
+    EBSD_INSTANCE_PROPERTY(bool, ResampleToGrid)
+
+    /**
+     * @brief When set readFile() resamples the triangles onto the given grid and the
+     * reader itself holds no data arrays afterwards. The target must stay valid until
+     * readFile() returns. The cache file is not used while a target is set.
+     */
+    void setGridTarget(const MicGridTarget* target);
+    const MicGridTarget* getGridTarget() const;
+
+    /**
+     * @brief Hands out the memory that readFile() resamples onto when the reader lays out
+     * a grid of its own, see setGridAllocator()
+     */
+    using GridAllocator = std::function<void(MicGridTarget& target)>;
+
+    /**
+     * @brief When set and ResampleToGrid is true readFile() calls the allocator once the
+     * grid is known, with the dimensions, spacing and origin of the target filled in. The
+     * allocator points arrays of the target at zero filled memory of the caller that holds
+     * xDim * yDim grid points and stays valid until readFile() returns. Those arrays are
+     * written while the triangles are resampled and the reader does not hold the matching
+     * columns. Arrays that are left nullptr are held by the reader as usual. Not used while
+     * a GridTarget is set.
+     */
+    void setGridAllocator(const GridAllocator& allocator);
+    const GridAllocator& getGridAllocator() const;
+
+    /**
+     * @brief The rows that readFile() drops while parsing. The cache file is not used
+     * while the filter is active.
+     */
+    EBSD_INSTANCE_PROPERTY(MicRowFilter, RowFilter)
+
+    /**
+     * @brief The part of the sample that readFile() reads. While it is enabled the grid
+     * spans the region, readHeaderOnly() reports the exact dimensions of that grid and the
+     * cache file is not used. A GridTarget still sets the grid, only the rows are culled.
+     */
+    EBSD_INSTANCE_PROPERTY(MicRegionOfInterest, RegionOfInterest)
+
+    /**
+     * @brief When true the arenas that hold the arrays are marked for transparent huge
+     * pages, see MicColumnArena::setUseHugePages(). Off by default.
+     */
+    EBSD_INSTANCE_PROPERTY(bool, UseHugePages)
+
+    /**
+     * @brief The arrays live in MicColumnArena blocks that the reader owns and reuses for
+     * the next readFile(). They must not be freed or passed to the set*Pointer() methods,
+     * which free the array they replace. Subclasses hand out arena columns with
+     * setColumnData() instead.
+     */
     EBSD_POINTER_PROPERTY(Euler1, Euler1, float)
     EBSD_POINTER_PROPERTY(Euler2, Euler2, float)
     EBSD_POINTER_PROPERTY(Euler3, Euler3, float)
@@ -147,6 +293,29 @@ class MicReader : public EbsdReader
     EBSD_POINTER_PROPERTY(Level, Level, int)
     EBSD_POINTER_PROPERTY(Up, Up, int)
 
+    /**
+     * @brief Sets the names of the arrays to read out of the file. The columns of a row
+     * that no array needs are skipped without being converted and nothing is allocated
+     * for them. Besides the arrays above the Z column and the unnamed columns
+     * Mic::Column11 to Mic::Column19 can be read, see getPointerByName(). The X, Y, Up and
+     * Level columns of the triangle table are always read because they place the triangles.
+     * @param names
+     */
+    void setArraysToRead(QSet<QString> names);
+
+    /**
+     * @brief When true (the default) Euler1, Euler2, Euler3, Confidence, Phase, X and Y are
+     * read whatever setArraysToRead() was given. The other columns are only read when
+     * they are named.
+     * @param b
+     */
+    void readAllArrays(bool b);
+
+    /**
+     * @brief Returns true if readFile() produces the array with the given name
+     */
+    bool isArrayRead(const QString& name) const;
+
     /**
      * @brief Returns the pointer to the data for a given feature
      * @param featureName The name of the feature to return the pointer to.
@@ -167,7 +336,31 @@ class MicReader : public EbsdReader
     int readFile() override;
 
     /**
-    * @brief Reads ONLY the header portion of the HEDM .Mic file
+    * @brief Reads the .mic rows from a block of memory instead of the file. The .config and
+    * .dat files next to FileName are read when a FileName is set, otherwise the header and
+    * phases stay empty. The cache file is not used.
+    * @param data Start of the .mic contents
+    * @param size Number of bytes of .mic contents
+    * @return Zero/Positive on Success - Negative on error.
+    */
+    int readBuffer(const char* data, size_t size);
+
+    /**
+    * @brief Reads the .mic rows from an open device such as stdin, a pipe or a socket. The
+    * device is read until atEnd() and the contents are then parsed like readBuffer() does.
+    * Waiting longer than DeviceReadTimeout for more data is an error.
+    * @param device An open, readable device
+    * @return Zero/Positive on Success - Negative on error.
+    */
+    int readDevice(QIODevice* device);
+
+    /**
+    * @brief Reads ONLY the header portion of the HEDM .Mic file. This is the matching
+    * .config and .dat files, so the phases are the same as after readFile(), plus the
+    * edge length and level from the first rows of the .mic file, which is enough to
+    * know the grid resolution. Because the data rows are not read
+    * the X and Y dimensions cover every triangle the .mic file could hold and may be
+    * larger than the dimensions that readFile() produces.
     * @return 1 on success
     */
     int readHeaderOnly() override;
@@ -179,38 +372,328 @@ class MicReader : public EbsdReader
     float getXStep();
     float getYStep();
 
+    /**
+     * @brief Returns the edge length of the triangles in the units of the .mic file
+     * after readHeaderOnly() or readFile() has been called
+     */
+    float getEdgeLength();
+
+    /**
+     * @brief Returns the position of grid point (0, 0) in the units of the .mic file
+     * after readHeaderOnly() or readFile() has been called
+     */
+    float getXOrigin();
+    float getYOrigin();
+
+    /**
+     * @brief Returns the lattice of the triangles after readFile() was called with
+     * ResampleToGrid turned off, or an empty pointer
+     */
+    MicLattice::Pointer getLattice();
+
+    /**
+     * @brief Returns whether the last readFile() wrote the .miccache file. A cache file
+     * that can not be written, for example in a read only directory, does not fail the
+     * read, the next read of the .mic file parses it again.
+     */
+    bool getCacheFileWritten() const;
+
+    /**
+     * @brief Resamples the triangle table that readFile() read with ResampleToGrid turned
+     * off onto a grid of the caller, the same way readFile() resamples onto a GridTarget.
+     * The reader is not changed, so a reader that MicReaderCache shares can resample onto
+     * any number of grids. getXDimension(), getYDimension(), getEdgeLength() and the origin
+     * describe the grid that readFile() would have produced.
+     * @param target The grid and the arrays that are written. Grid points that no triangle
+     * covers are not written.
+     * @return false if the reader holds no triangle table
+     */
+    bool resampleTriangles(const MicGridTarget& target);
+
+    /**
+     * @brief Returns the number of bytes held by the data arrays of this reader,
+     * including the memory that is kept for the next readFile()
+     */
+    size_t getDataSize();
+
+    /**
+     * @brief Frees the memory that the reader only keeps so the next readFile() can
+     * reuse it, for example the triangle table after it was resampled. Call this on a
+     * reader whose data is kept around but that will not read another file.
+     */
+    void releaseScratchMemory();
+
   protected:
-    /** @brief 'free's the allocated memory and sets the pointer to nullptr
+    /** @brief Sets every array pointer to nullptr. The memory stays in the arenas
+     * for the next read.
      */
     void deletePointers();
 
+    /**
+     * @brief Returns the array of the column or nullptr if it is not read
+     * @param column A Mic::DataColumn::Index
+     */
+    void* getColumnData(int column);
+
+    /**
+     * @brief Replaces the array of the column without freeing the previous one. This is how
+     * columns of an arena the reader owns are handed out, see the note on the arrays above.
+     * @param column A Mic::DataColumn::Index
+     */
+    void setColumnData(int column, void* data);
+
   private:
+    MicHeaderValues m_HeaderValues;
     MicPhase::Pointer   m_CurrentPhase;
+    MicLattice::Pointer m_Lattice;
+    const MicGridTarget* m_GridTarget;
+    GridAllocator m_GridAllocator;
+    QSet<QString> m_ArrayNames;
+    bool m_ReadAllArrays;
+    bool m_CacheFileWritten;
+
+    // The arrays of the columns that have no named pointer property (Z, Column11 to
+    // Column19), indexed by Mic::DataColumn::Index. The other entries stay nullptr.
+    void* m_ExtraColumns[Mic::DataColumn::Count];
+
+    // Where parseDataLine() stores each column of a row or nullptr to skip the column.
+    // Only the first m_NumParsedColumns columns of a row are looked at.
+    void* m_ColumnTargets[Mic::DataColumn::Count];
+    int m_NumParsedColumns;
+    // The RowFilter combined with the bounding box of the RegionOfInterest
+    MicRowFilter m_ParseFilter;
+    // The triangle table and the grid each live in one arena. m_DataArena is the one
+    // that holds the current arrays or nullptr.
+    MicColumnArena m_TableArena;
+    MicColumnArena m_GridArena;
+    MicColumnArena* m_DataArena;
+    // The columns that the parse filter looks at
+    bool m_FilterColumns[Mic::DataColumn::Count];
 
     int xDim;
     int yDim;
     float xRes;
     float yRes;
+    float edgeLength;
+    int refinementLevel;
+    float xOrigin;
+    float yOrigin;
 
     int readMicFile();
 
+    /**
+     * @brief Reads the header files that sit next to the .mic file
+     * @return Zero/Positive on Success - Negative on error.
+     */
+    int readHeaderFiles();
+
+    /**
+     * @brief Parses and lays out .mic contents that did not come from the file
+     * @return Zero/Positive on Success - Negative on error.
+     */
+    int readMicContents(const char* begin, const char* end);
+
+    /**
+     * @brief Sets the error and returns -116 if the region of interest is enabled but empty
+     */
+    int checkRegionOfInterest();
+
+    /**
+     * @brief Lays out the parsed rows as triangles or resamples them onto the grid and
+     * writes the cache file if asked to.
+     * @param origEdgeLength The edge length of the initial triangle
+     * @param totalDataRows The number of data rows that were parsed
+     * @param writeCache Whether the cache file is written
+     * @param contentHash The hash of the .mic contents stored in the cache file
+     * @return Zero/Positive on Success - Negative on error.
+     */
+    int processRows(float origEdgeLength, size_t totalDataRows, bool writeCache, quint64 contentHash);
+
     int readDatFile();
 
-    /** @brief Parses the value from a single line of the header section of the HEDM .Mic file
-    * @param line The line to parse
+    /**
+     * @brief Reads the .config file that sits next to the .mic file into the header entries
+     * @return Zero/Positive on Success - Negative on error.
+     */
+    int readConfigFile();
+
+    /**
+     * @brief Sets the grid dimensions and resolution from the edge length and level found
+     * in the first rows of the .mic file without reading the rest of the file.
+     * @return Zero/Positive on Success - Negative on error.
+     */
+    int readMicGeometry();
+
+    /**
+     * @brief Sets the XDim, YDim, XRes and YRes header values and the origin for a grid that spans the given extent
+     * @param newEdgeLength The edge length of the triangles, which is also the grid spacing
+     */
+    void setGridGeometry(float newEdgeLength, float xMin, float xMax, float yMin, float yMax);
+
+    /**
+     * @brief Sets the XDim, YDim, XRes and YRes header values
+     */
+    void setGridDimensions(int xD, int yD, float xR, float yR);
+
+    /**
+     * @brief Loads the grid, or the triangle table if ResampleToGrid is false, from the cache
+     * file of the .mic file if the cache file is up to date
+     * @param contentHash The MicCacheFile::HashContent() of the .mic file
+     * @return true if the data was loaded from the cache file
+     */
+    bool readCacheFile(quint64 contentHash);
+
+    /**
+     * @brief Writes the triangle table and the rasterized grid to the cache file of the .mic file
+     * @param contentHash The MicCacheFile::HashContent() of the .mic file
+     * @param newEdgeLength The edge length of the triangles
+     * @param level The level of the triangles
+     * @param numTriangles The number of rows in the triangle table
+     * @param triangleArrays The triangle table in Mic::Cache::TriangleArray order
+     * @param cellArrays The grid in Mic::Cache::CellArray order
+     * @return false if the cache file could not be written
+     */
+    bool writeCacheFile(quint64 contentHash, float newEdgeLength, int level, size_t numTriangles, const QVector<const void*>& triangleArrays, const QVector<const void*>& cellArrays);
+
+    /**
+     * @brief Writes the cache file from the triangle table and the grid that the owners
+     * map the table onto. Grid columns that are nullptr are rasterized into scratch memory.
+     * Nothing is written unless the table holds every array of the cache file.
+     * @param contentHash The MicCacheFile::HashContent() of the .mic file
+     * @param newEdgeLength The edge length of the triangles
+     * @param level The level of the triangles
+     * @param numTriangles The number of rows in the triangle table
+     * @param triColumns The triangle table, one entry per Mic::DataColumn::Index
+     * @param gridColumns The grid columns the reader holds, one entry per Mic::DataColumn::Index
+     * @param owners The triangle that covers each grid point or -1, see findGridOwners()
+     * @return false if nothing was written
+     */
+    bool writeGridCacheFile(quint64 contentHash, float newEdgeLength, int level, size_t numTriangles, void* const* triColumns, void* const* gridColumns, const int* owners);
+
+    /**
+     * @brief Places the triangles in the data arrays on a MicLattice and releases the X, Y
+     * and Up arrays if that succeeds. The table is then packed into a block that just fits it.
+     */
+    void buildLattice();
+
+    /**
+     * @brief Returns the grid that the reader lays out with the arrays that the GridAllocator
+     * hands out for it. The arrays are nullptr if there is no GridAllocator.
+     */
+    MicGridTarget allocateGridTarget();
+
+    /**
+     * @brief Finds the triangle that covers each point of a grid. Triangles on a regular
+     * lattice go through the MicCoverageMap of the lattice, which the layers of a stack
+     * share, the others are rasterized for this file alone.
+     * @param grid The grid. Only its dimensions, spacing and origin are used.
+     * @param lattice The lattice of the triangles or nullptr to place them on one here
+     * @param triX X coordinate of the left vertex of each triangle, unused with a lattice
+     * @param triY Y coordinate of the left vertex of each triangle, unused with a lattice
+     * @param triUp 1 if the triangle points up, 2 if it points down, unused with a lattice
+     * @param numTriangles Number of triangles
+     * @param owners One value per grid point (out). The index of the covering triangle or -1.
+     */
+    void findGridOwners(const MicGridTarget& grid, const MicLattice* lattice, const float* triX, const float* triY, const int* triUp, size_t numTriangles, std::vector<int>& owners);
+
+    /**
+     * @brief Resamples the triangle table onto the GridTarget
+     */
+    void resampleOntoTarget(const float* triEuler1, const float* triEuler2, const float* triEuler3, const float* triConf, const int* triPhase, const int* triUp, const float* triX, const float* triY,
+                            size_t numTriangles, float newEdgeLength);
+
+    /**
+     * @brief Returns the level column of a data row or zero if the row could not be parsed
+     * @param begin Start of the row
+     * @param end One past the end of the row
+     */
+    static int parseLevel(const char* begin, const char* end);
+
+    /**
+     * @brief Parses the edge length and all the data rows of a .mic file that is held
+     * in a contiguous block of memory (typically the memory mapped file).
+     * @param begin Start of the file contents
+     * @param end One past the end of the file contents
+     * @param origEdgeLength The edge length of the initial triangle (out)
+     * @param totalDataRows The number of data rows that were parsed (out)
+     * @return Zero/Positive on Success - Negative on error.
+     */
+    int parseMicBuffer(const char* begin, const char* end, float& origEdgeLength, size_t& totalDataRows);
+
+    /**
+     * @brief Combines the RowFilter with the RegionOfInterest into the filter that the rows
+     * are parsed with. A row is kept by the region if the bounding box of its triangle
+     * overlaps the region.
+     * @param newEdgeLength The edge length of the triangles
+     */
+    void planRowFilter(float newEdgeLength);
+
+    /** @brief Parses the value from a single line of the .config file. The key is looked
+    * up in a compile time table so nothing is allocated unless the value is a string.
+    * @param begin Start of the line
+    * @param end One past the last character of the line
     */
-    void parseHeaderLine(QByteArray& line);
+    void parseHeaderLine(const char* begin, const char* end);
 
-    /** @brief Parses the data from a line of data from the HEDM .Mic file
-      * @param line The line of data to parse
+    /** @brief Parses the data from a line of data from the HEDM .Mic file. The line is
+      * tokenized in place so no memory is allocated.
+      * @param begin Start of the line
+      * @param end One past the last character of the line
+      * @param i The row index to store the values at
+      * @return false if the RowFilter or the RegionOfInterest drops the row. The row index may then be reused.
       */
-    void parseDataLine(QByteArray& line, size_t i);
+    bool parseDataLine(const char* begin, const char* end, size_t i);
+
+    /**
+     * @brief Parses every non blank line in [begin, end) into consecutive rows starting
+     * at firstRow. Rows that are dropped do not take up a row index. Parsing stops once
+     * the kept rows reach endRow.
+     * @param begin Start of the first line
+     * @param end One past the end of the last line
+     * @param firstRow The row index that the first line is stored at
+     * @param endRow One past the last row index that may be written
+     * @return The number of rows that were kept
+     */
+    size_t parseDataRows(const char* begin, const char* end, size_t firstRow, size_t endRow);
+
+    /**
+     * @brief Updates the number of elements once the rows are parsed
+     * @param numRows The number of rows the arrays were allocated for
+     * @param numKeptRows The number of rows that were kept
+     * @return Zero/Positive on Success - Negative if no row was kept
+     */
+    int finishRows(size_t numRows, size_t numKeptRows);
+
+    /**
+     * @brief Moves rows of every array to a lower row index, used to close the gaps that
+     * the RowFilter leaves between the chunks that were parsed in parallel
+     */
+    void moveRows(size_t from, size_t to, size_t count);
 
     /**
-     * @brief initPointers
+     * @brief Moves the first numRows rows of every array of the triangle table into
+     * a block that just fits them
+     */
+    void shrinkColumns(size_t numRows);
+
+    friend class ParseMicRowsImpl;
+
+    /**
+     * @brief Lays out the arrays that are read, see isArrayRead(), in the table or the
+     * grid arena. The grid arrays are zero filled, the rows of the table are not because
+     * the parser writes every column it allocates.
      * @param numElements
+     * @param triangleTable True for the parsed triangle table, which also needs the X, Y,
+     * Up and Level columns, false for the grid
+     * @param callerGrid Memory of the caller that already holds some of the grid columns or
+     * nullptr. Those columns are not laid out.
+     */
+    void initPointers(size_t numElements, bool triangleTable, const MicGridTarget* callerGrid = nullptr);
+
+    /**
+     * @brief Points the parse targets at the arrays of the triangle table
      */
-    void initPointers(size_t numElements);
+    void planColumns();
 
   public:
     MicReader(const MicReader&) = delete;            // Copy Constructor Not Implemented
@@ -0,0 +1,206 @@
+/* ============================================================================
+ * Copyright (c) 2010, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2010, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "MicReaderCache.h"
+
+#include <algorithm>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
+
+#include "MicReader.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicReaderCache::MicReaderCache()
+: m_MemoryBudget(k_DefaultMemoryBudget)
+, m_MemoryUsage(0)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicReaderCache::~MicReaderCache() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicReaderCache* MicReaderCache::Instance()
+{
+  static MicReaderCache instance;
+  return &instance;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::shared_ptr<MicReader> MicReaderCache::find(const QString& filePath)
+{
+  QFileInfo fi(filePath);
+  QString absolutePath = fi.absoluteFilePath();
+  qint64 fileSize = fi.size();
+  qint64 lastModified = fi.lastModified().toMSecsSinceEpoch();
+
+  QMutexLocker locker(&m_Mutex);
+  for(std::list<Entry>::iterator iter = m_Entries.begin(); iter != m_Entries.end(); ++iter)
+  {
+    if(iter->filePath != absolutePath)
+    {
+      continue;
+    }
+    if(iter->fileSize != fileSize || iter->lastModified != lastModified)
+    {
+      // The file changed since it was read so the entry is of no use any more
+      m_MemoryUsage -= iter->numBytes;
+      m_Entries.erase(iter);
+      return std::shared_ptr<MicReader>();
+    }
+    m_Entries.splice(m_Entries.begin(), m_Entries, iter);
+    return m_Entries.front().reader;
+  }
+  return std::shared_ptr<MicReader>();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReaderCache::insert(const QString& filePath, const std::shared_ptr<MicReader>& reader)
+{
+  QFileInfo fi(filePath);
+  Entry entry;
+  entry.filePath = fi.absoluteFilePath();
+  entry.fileSize = fi.size();
+  entry.lastModified = fi.lastModified().toMSecsSinceEpoch();
+  entry.numBytes = reader->getDataSize();
+  entry.reader = reader;
+
+  QMutexLocker locker(&m_Mutex);
+  for(std::list<Entry>::iterator iter = m_Entries.begin(); iter != m_Entries.end(); ++iter)
+  {
+    if(iter->filePath == entry.filePath)
+    {
+      m_MemoryUsage -= iter->numBytes;
+      m_Entries.erase(iter);
+      break;
+    }
+  }
+  if(entry.numBytes > m_MemoryBudget)
+  {
+    return;
+  }
+  m_MemoryUsage += entry.numBytes;
+  m_Entries.push_front(entry);
+  evict();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReaderCache::remove(const QString& filePath)
+{
+  QString absolutePath = QFileInfo(filePath).absoluteFilePath();
+
+  QMutexLocker locker(&m_Mutex);
+  for(std::list<Entry>::iterator iter = m_Entries.begin(); iter != m_Entries.end(); ++iter)
+  {
+    if(iter->filePath == absolutePath)
+    {
+      m_MemoryUsage -= iter->numBytes;
+      m_Entries.erase(iter);
+      return;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReaderCache::clear()
+{
+  QMutexLocker locker(&m_Mutex);
+  m_Entries.clear();
+  m_MemoryUsage = 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReaderCache::setMemoryBudget(size_t numBytes)
+{
+  QMutexLocker locker(&m_Mutex);
+  m_MemoryBudget = numBytes;
+  evict();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReaderCache::growMemoryBudget(size_t numBytes)
+{
+  QMutexLocker locker(&m_Mutex);
+  m_MemoryBudget = std::max(m_MemoryBudget, numBytes);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t MicReaderCache::getMemoryBudget()
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_MemoryBudget;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t MicReaderCache::getMemoryUsage()
+{
+  QMutexLocker locker(&m_Mutex);
+  return m_MemoryUsage;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicReaderCache::evict()
+{
+  while(m_MemoryUsage > m_MemoryBudget && !m_Entries.empty())
+  {
+    m_MemoryUsage -= m_Entries.back().numBytes;
+    m_Entries.pop_back();
+  }
+}
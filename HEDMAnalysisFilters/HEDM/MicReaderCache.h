@@ -0,0 +1,151 @@
+/* ============================================================================
+ * Copyright (c) 2010, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2010, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+class MicReader;
+
+/**
+ * @class MicReaderCache MicReaderCache.h HEDMAnalysisFilters/HEDM/MicReaderCache.h
+ * @brief A process wide cache of fully read .mic files. Each entry is a MicReader
+ * that readFile() was called on and is keyed by the absolute path, size and
+ * modification time of the .mic file, so an entry is never returned once the file
+ * has changed on disk. The entries are shared between every filter in the process
+ * and must be treated as read only. When the data arrays of all the entries take
+ * more than the memory budget the least recently used entries are dropped.
+ *
+ * All the methods are thread safe.
+ *
+ * @date Oct 2026
+ * @version 1.0
+ */
+class MicReaderCache
+{
+  public:
+    virtual ~MicReaderCache();
+
+    /**
+     * @brief Returns the process wide cache
+     */
+    static MicReaderCache* Instance();
+
+    /**
+     * @brief The default memory budget of 512 MiB
+     */
+    static const size_t k_DefaultMemoryBudget = 512ULL * 1024ULL * 1024ULL;
+
+    /**
+     * @brief Returns the reader for the given .mic file and marks it as the most recently used
+     * @param filePath Path to the .mic file
+     * @return The reader or an empty pointer if the file is not cached or has changed
+     */
+    std::shared_ptr<MicReader> find(const QString& filePath);
+
+    /**
+     * @brief Adds a reader that has read the given .mic file, replacing any older entry for
+     * the same file. Readers larger than the memory budget are not cached.
+     * @param filePath Path to the .mic file
+     * @param reader The reader. It must not be modified after it has been inserted.
+     */
+    void insert(const QString& filePath, const std::shared_ptr<MicReader>& reader);
+
+    /**
+     * @brief Removes the entry for the given .mic file
+     * @param filePath Path to the .mic file
+     */
+    void remove(const QString& filePath);
+
+    /**
+     * @brief Removes every entry
+     */
+    void clear();
+
+    /**
+     * @brief Sets the number of bytes that the data arrays of all the entries may take.
+     * A budget of zero disables the cache. This is a setting of the application, filters
+     * only ever grow the budget with growMemoryBudget().
+     */
+    void setMemoryBudget(size_t numBytes);
+    size_t getMemoryBudget();
+
+    /**
+     * @brief Raises the memory budget to numBytes if it is smaller, so no entry is evicted.
+     * ReadMicData calls this with its SharedCacheSize parameter every time it executes, the
+     * budget is therefore the largest size any filter of the session asked for.
+     */
+    void growMemoryBudget(size_t numBytes);
+
+    /**
+     * @brief Returns the number of bytes that the data arrays of all the entries take
+     */
+    size_t getMemoryUsage();
+
+  protected:
+    MicReaderCache();
+
+  private:
+    struct Entry
+    {
+      QString filePath;
+      qint64 fileSize;
+      qint64 lastModified;
+      size_t numBytes;
+      std::shared_ptr<MicReader> reader;
+    };
+
+    QMutex m_Mutex;
+    std::list<Entry> m_Entries; // Most recently used first
+    size_t m_MemoryBudget;
+    size_t m_MemoryUsage;
+
+    /**
+     * @brief Drops the least recently used entries until the memory usage fits the budget.
+     * The caller must hold the mutex.
+     */
+    void evict();
+
+  public:
+    MicReaderCache(const MicReaderCache&) = delete;            // Copy Constructor Not Implemented
+    MicReaderCache(MicReaderCache&&) = delete;                 // Move Constructor Not Implemented
+    MicReaderCache& operator=(const MicReaderCache&) = delete; // Copy Assignment Not Implemented
+    MicReaderCache& operator=(MicReaderCache&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,153 @@
+/* ============================================================================
+ * Copyright (c) 2010, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2010, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "MicTriangleMesh.h"
+
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+#include <QtCore/QtGlobal>
+
+#include "MicLattice.h"
+
+namespace
+{
+const size_t k_NoVertex = std::numeric_limits<size_t>::max();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicTriangleMesh::MicTriangleMesh() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicTriangleMesh::~MicTriangleMesh() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicTriangleMesh::build(const MicLattice& lattice)
+{
+  size_t numTriangles = lattice.getNumberOfTriangles();
+  m_Vertices.clear();
+  m_Triangles.assign(3 * numTriangles, 0);
+  if(numTriangles == 0)
+  {
+    return;
+  }
+
+  float halfEdge = lattice.getEdgeLength() / 2.0f;
+  float height = lattice.getEdgeLength() * sqrtf(3.0f) / 2.0f;
+
+  // Vertex (u, v) sits at the bottom left corner of column u and row v, so the vertices
+  // span one more row and two more columns than the triangles. Dense lattices get a
+  // table over all the vertex positions, sparse ones a hash map.
+  qint64 stride = lattice.getNumberOfColumns() + 2;
+  qint64 numLatticePoints = stride * (lattice.getNumberOfRows() + 1);
+  bool dense = static_cast<quint64>(numLatticePoints) <= 4 * static_cast<quint64>(numTriangles) + 1024;
+  std::vector<size_t> table(dense ? static_cast<size_t>(numLatticePoints) : 0, k_NoVertex);
+  std::unordered_map<qint64, size_t> map;
+  if(!dense)
+  {
+    map.reserve(numTriangles);
+  }
+  m_Vertices.reserve(3 * (numTriangles / 2 + 2));
+
+  auto vertexIndex = [&](qint64 u, qint64 v) {
+    size_t* index = nullptr;
+    if(dense)
+    {
+      index = &table[static_cast<size_t>(v * stride + u)];
+    }
+    else
+    {
+      index = &map.emplace(v * stride + u, k_NoVertex).first->second;
+    }
+    if(*index == k_NoVertex)
+    {
+      *index = m_Vertices.size() / 3;
+      m_Vertices.push_back(lattice.getXOrigin() + static_cast<float>(u) * halfEdge);
+      m_Vertices.push_back(lattice.getYOrigin() + static_cast<float>(v) * height);
+      m_Vertices.push_back(0.0f);
+    }
+    return *index;
+  };
+
+  size_t* triangle = m_Triangles.data();
+  for(size_t i = 0; i < numTriangles; i++, triangle += 3)
+  {
+    qint64 u = lattice.getColumn(i);
+    qint64 v = lattice.getRow(i);
+    if(lattice.isUp(i))
+    {
+      triangle[0] = vertexIndex(u, v);
+      triangle[1] = vertexIndex(u + 2, v);
+      triangle[2] = vertexIndex(u + 1, v + 1);
+    }
+    else
+    {
+      triangle[0] = vertexIndex(u, v + 1);
+      triangle[1] = vertexIndex(u + 1, v);
+      triangle[2] = vertexIndex(u + 2, v + 1);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t MicTriangleMesh::getNumberOfVertices() const
+{
+  return m_Vertices.size() / 3;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const float* MicTriangleMesh::getVertices() const
+{
+  return m_Vertices.data();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const size_t* MicTriangleMesh::getTriangles() const
+{
+  return m_Triangles.data();
+}
@@ -0,0 +1,93 @@
+/* ============================================================================
+ * Copyright (c) 2010, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2010, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+class MicLattice;
+
+/**
+ * @class MicTriangleMesh MicTriangleMesh.h HEDMAnalysisFilters/HEDM/MicTriangleMesh.h
+ * @brief Turns the triangle table of a .mic file into a triangle mesh with shared vertices.
+ *
+ * The vertices are identified by their integer coordinates on the MicLattice of
+ * the triangles instead of by comparing floating point positions, which makes the
+ * vertices that neighboring triangles share exactly the same vertex and puts every
+ * vertex exactly on the lattice. The triangles keep the order of the table and are
+ * wound counter clockwise.
+ *
+ * @date Oct 2026
+ * @version 1.0
+ */
+class MicTriangleMesh
+{
+  public:
+    MicTriangleMesh();
+    virtual ~MicTriangleMesh();
+
+    /**
+     * @brief Builds the vertices and triangles of the mesh
+     * @param lattice The lattice of the triangles
+     */
+    void build(const MicLattice& lattice);
+
+    /**
+     * @brief Returns the number of distinct vertices
+     */
+    size_t getNumberOfVertices() const;
+
+    /**
+     * @brief Returns the X, Y and Z coordinate of each vertex. Z is always zero.
+     */
+    const float* getVertices() const;
+
+    /**
+     * @brief Returns the indices of the 3 vertices of each triangle
+     */
+    const size_t* getTriangles() const;
+
+  private:
+    std::vector<float> m_Vertices;
+    std::vector<size_t> m_Triangles;
+
+  public:
+    MicTriangleMesh(const MicTriangleMesh&) = delete;            // Copy Constructor Not Implemented
+    MicTriangleMesh(MicTriangleMesh&&) = delete;                 // Move Constructor Not Implemented
+    MicTriangleMesh& operator=(const MicTriangleMesh&) = delete; // Copy Assignment Not Implemented
+    MicTriangleMesh& operator=(MicTriangleMesh&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,266 @@
+/* ============================================================================
+ * Copyright (c) 2010, Michael A. Jackson (BlueQuartz Software)
+ * Copyright (c) 2010, Dr. Michael A. Groeber (US Air Force Research Laboratories
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+ * BlueQuartz Software nor the names of its contributors may be used to endorse
+ * or promote products derived from this software without specific prior written
+ * permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *  This code was written under United States Air Force Contract number
+ *                           FA8650-07-D-5800
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "MicTriangleRasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+namespace
+{
+const float k_Root3 = 1.73205080757f;
+}
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+namespace
+{
+// Number of grid rows that one task rasterizes
+const int k_RowsPerBand = 32;
+// Fewer triangles than this are not worth the binning pass
+const size_t k_MinParallelTriangles = 16384;
+}
+
+/**
+ * @brief The RasterizeMicBandsImpl class rasterizes the triangles that touch each band
+ * of grid rows, clipped to the rows of the band
+ */
+class RasterizeMicBandsImpl
+{
+  const MicTriangleRasterizer* m_Rasterizer;
+  const float* m_TriX;
+  const float* m_TriY;
+  const int* m_TriUp;
+  float m_EdgeLength;
+  const std::vector<size_t>& m_BandOffsets;
+  const std::vector<size_t>& m_BandTriangles;
+  int* m_Owners;
+
+public:
+  RasterizeMicBandsImpl(const MicTriangleRasterizer* rasterizer, const float* triX, const float* triY, const int* triUp, float edgeLength, const std::vector<size_t>& bandOffsets,
+                        const std::vector<size_t>& bandTriangles, int* owners)
+  : m_Rasterizer(rasterizer)
+  , m_TriX(triX)
+  , m_TriY(triY)
+  , m_TriUp(triUp)
+  , m_EdgeLength(edgeLength)
+  , m_BandOffsets(bandOffsets)
+  , m_BandTriangles(bandTriangles)
+  , m_Owners(owners)
+  {
+  }
+  virtual ~RasterizeMicBandsImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t b = start; b < end; b++)
+    {
+      int kBegin = static_cast<int>(b) * k_RowsPerBand;
+      int kEnd = std::min(kBegin + k_RowsPerBand, m_Rasterizer->m_YDim);
+      for(size_t t = m_BandOffsets[b]; t < m_BandOffsets[b + 1]; t++)
+      {
+        m_Rasterizer->rasterizeTriangle(m_BandTriangles[t], m_TriX, m_TriY, m_TriUp, m_EdgeLength, kBegin, kEnd, m_Owners);
+      }
+    }
+  }
+
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+};
+#endif
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicTriangleRasterizer::MicTriangleRasterizer(int xDim, int yDim, float spacing, float xOrigin, float yOrigin)
+: m_XDim(xDim)
+, m_YDim(yDim)
+, m_Spacing(spacing)
+, m_XOrigin(xOrigin)
+, m_YOrigin(yOrigin)
+, m_Parallel(true)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MicTriangleRasterizer::~MicTriangleRasterizer() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicTriangleRasterizer::setParallel(bool parallel)
+{
+  m_Parallel = parallel;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MicTriangleRasterizer::getParallel() const
+{
+  return m_Parallel;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicTriangleRasterizer::FindRows(float v, int up, float height, int& kBegin, int& kEnd)
+{
+  // Up triangles cover [v, v + height) and down triangles [v - height, v)
+  float yLow = (up == 1) ? v : v - height;
+  kBegin = static_cast<int>(std::ceil(yLow));
+  kEnd = static_cast<int>(std::ceil(yLow + height));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicTriangleRasterizer::rasterizeTriangle(size_t i, const float* triX, const float* triY, const int* triUp, float edgeLength, int kBegin, int kEnd, int* owners) const
+{
+  int up = triUp[i];
+  if(up != 1 && up != 2)
+  {
+    return;
+  }
+
+  // Work in grid units so that grid point (j, k) is at (j, k)
+  float u = (triX[i] - m_XOrigin) / m_Spacing;
+  float v = (triY[i] - m_YOrigin) / m_Spacing;
+  float edge = edgeLength / m_Spacing;
+  float height = edge * k_Root3 / 2.0f;
+
+  int rowBegin = 0;
+  int rowEnd = 0;
+  FindRows(v, up, height, rowBegin, rowEnd);
+  rowBegin = std::max(rowBegin, kBegin);
+  rowEnd = std::min(rowEnd, kEnd);
+
+  for(int k = rowBegin; k < rowEnd; k++)
+  {
+    // Distance of the row from the horizontal edge, the span shrinks by 1/sqrt(3) of that on each side
+    float t = (up == 1) ? (static_cast<float>(k) - v) : (v - static_cast<float>(k));
+    float inset = t / k_Root3;
+    int jBegin = std::max(static_cast<int>(std::ceil(u + inset)), 0);
+    int jEnd = std::min(static_cast<int>(std::ceil(u + edge - inset)), m_XDim);
+    int* row = owners + static_cast<size_t>(k) * m_XDim;
+    for(int j = jBegin; j < jEnd; j++)
+    {
+      row[j] = static_cast<int>(i);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MicTriangleRasterizer::rasterize(const float* triX, const float* triY, const int* triUp, size_t numTriangles, float edgeLength, int* owners) const
+{
+  if(m_XDim <= 0 || m_YDim <= 0)
+  {
+    return;
+  }
+  std::fill(owners, owners + static_cast<size_t>(m_XDim) * m_YDim, -1);
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  if(m_Parallel && numTriangles >= k_MinParallelTriangles)
+  {
+    // Sort the triangles into the bands of rows they touch. Each band keeps its
+    // triangles in index order so the band sees the same overwrites as a serial pass.
+    size_t numBands = static_cast<size_t>((m_YDim + k_RowsPerBand - 1) / k_RowsPerBand);
+    float height = edgeLength / m_Spacing * k_Root3 / 2.0f;
+    std::vector<size_t> bandOffsets(numBands + 1, 0);
+    auto findBands = [&](size_t i, int& bBegin, int& bEnd) {
+      int kBegin = 0;
+      int kEnd = 0;
+      FindRows((triY[i] - m_YOrigin) / m_Spacing, triUp[i], height, kBegin, kEnd);
+      kBegin = std::max(kBegin, 0);
+      kEnd = std::min(kEnd, m_YDim);
+      bBegin = kBegin / k_RowsPerBand;
+      bEnd = (kEnd + k_RowsPerBand - 1) / k_RowsPerBand;
+      return kBegin < kEnd;
+    };
+
+    int bBegin = 0;
+    int bEnd = 0;
+    for(size_t i = 0; i < numTriangles; i++)
+    {
+      if(findBands(i, bBegin, bEnd))
+      {
+        for(int b = bBegin; b < bEnd; b++)
+        {
+          bandOffsets[b + 1]++;
+        }
+      }
+    }
+    for(size_t b = 0; b < numBands; b++)
+    {
+      bandOffsets[b + 1] += bandOffsets[b];
+    }
+
+    std::vector<size_t> bandTriangles(bandOffsets[numBands]);
+    std::vector<size_t> nextSlot(bandOffsets.begin(), bandOffsets.end() - 1);
+    for(size_t i = 0; i < numTriangles; i++)
+    {
+      if(findBands(i, bBegin, bEnd))
+      {
+        for(int b = bBegin; b < bEnd; b++)
+        {
+          bandTriangles[nextSlot[b]++] = i;
+        }
+      }
+    }
+
+    tbb::task_scheduler_init init;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBands), RasterizeMicBandsImpl(this, triX, triY, triUp, edgeLength, bandOffsets, bandTriangles, owners), tbb::auto_partitioner());
+    return;
+  }
+#endif
+
+  for(size_t i = 0; i < numTriangles; i++)
+  {
+    rasterizeTriangle(i, triX, triY, triUp, edgeLength, 0, m_YDim, owners);
+  }
+}
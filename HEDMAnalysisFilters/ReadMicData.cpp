@@ -35,6 +35,7 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ReadMicData.h"
 
+#include <algorithm>
 #include <limits>
 #include <sstream>
 #include <vector>
@@ -42,16 +43,26 @@
 #include <QtCore/QFileInfo>
 
 #include "EbsdLib/EbsdLib.h"
+#include "HEDMAnalysisFilters/HEDM/MicCompactCodec.h"
 #include "HEDMAnalysisFilters/HEDM/MicFields.h"
 #include "HEDMAnalysisFilters/HEDM/MicReader.h"
+#include "HEDMAnalysisFilters/HEDM/MicReaderCache.h"
+#include "HEDMAnalysisFilters/HEDM/MicTriangleMesh.h"
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/FloatFilterParameter.h"
+#include "SIMPLib/FilterParameters/FloatVec2FilterParameter.h"
 #include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
 
 #include "HEDMAnalysis/HEDMAnalysisConstants.h"
 
@@ -59,6 +70,7 @@ enum createdPathID : RenameDataPath::DataID_t
 {
   AttributeMatrixID21 = 21,
   AttributeMatrixID22 = 22,
+  AttributeMatrixID23 = 23,
 
   DataArrayID31 = 31,
   DataArrayID32 = 32,
@@ -67,6 +79,27 @@ enum createdPathID : RenameDataPath::DataID_t
   DataContainerID = 1
 };
 
+namespace
+{
+/**
+ * @brief Converts the region of interest of the filter, which is in microns like the
+ * spacing of the Image Geometry, to the millimeters of the .mic file
+ */
+MicRegionOfInterest MicRegion(bool useRegion, const FloatVec2Type& minimum, const FloatVec2Type& maximum)
+{
+  MicRegionOfInterest region;
+  region.enabled = useRegion;
+  if(useRegion)
+  {
+    region.xMin = minimum[0] / 1000.0f;
+    region.xMax = maximum[0] / 1000.0f;
+    region.yMin = minimum[1] / 1000.0f;
+    region.yMax = maximum[1] / 1000.0f;
+  }
+  return region;
+}
+} // namespace
+
 /* ############## Start Private Implementation ############################### */
 // -----------------------------------------------------------------------------
 //
@@ -105,6 +138,15 @@ ReadMicData::ReadMicData()
 , m_PhaseNameArrayName("")
 , m_MaterialNameArrayName(SIMPL::EnsembleData::PhaseName)
 , m_InputFile("")
+, m_UseCacheFile(false)
+, m_SharedCacheSize(static_cast<int>(MicReaderCache::k_DefaultMemoryBudget / (1024ULL * 1024ULL)))
+, m_OutputGeometryType(MIC_IMAGE_GEOMETRY)
+, m_FaceAttributeMatrixName(SIMPL::Defaults::FaceAttributeMatrixName)
+, m_UseConfidenceThreshold(false)
+, m_ConfidenceThreshold(0.0f)
+, m_GoodTrianglesOnly(false)
+, m_UseRegionOfInterest(false)
+, m_UseCompactArrays(false)
 , m_CellEulerAnglesArrayName(SIMPL::CellData::EulerAngles)
 , m_CellPhasesArrayName(SIMPL::CellData::Phases)
 , m_CrystalStructuresArrayName(SIMPL::EnsembleData::CrystalStructures)
@@ -134,9 +176,37 @@ void ReadMicData::setupFilterParameters()
 {
   FilterParameterVectorType parameters;
   parameters.push_back(SIMPL_NEW_INPUT_FILE_FP("Input File", InputFile, FilterParameter::Parameter, ReadMicData, "*.mic"));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Cache File", UseCacheFile, FilterParameter::Parameter, ReadMicData));
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Shared Memory Cache (MB)", SharedCacheSize, FilterParameter::Parameter, ReadMicData));
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("Output Geometry");
+    parameter->setPropertyName("OutputGeometryType");
+    parameter->setSetterCallback(SIMPL_BIND_SETTER(ReadMicData, this, OutputGeometryType));
+    parameter->setGetterCallback(SIMPL_BIND_GETTER(ReadMicData, this, OutputGeometryType));
+    QVector<QString> choices;
+    choices.push_back("Image (Resampled)");
+    choices.push_back("Triangle");
+    parameter->setChoices(choices);
+    parameter->setCategory(FilterParameter::Parameter);
+    parameters.push_back(parameter);
+  }
+  QStringList linkedProps("ConfidenceThreshold");
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Drop Triangles Below Confidence", UseConfidenceThreshold, FilterParameter::Parameter, ReadMicData, linkedProps));
+  parameters.push_back(SIMPL_NEW_FLOAT_FP("Minimum Confidence", ConfidenceThreshold, FilterParameter::Parameter, ReadMicData));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Good Triangles Only", GoodTrianglesOnly, FilterParameter::Parameter, ReadMicData));
+  QStringList regionProps;
+  regionProps << "RegionMinimum"
+              << "RegionMaximum";
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Read Region of Interest", UseRegionOfInterest, FilterParameter::Parameter, ReadMicData, regionProps));
+  parameters.push_back(SIMPL_NEW_FLOAT_VEC2_FP("Region Minimum (Microns)", RegionMinimum, FilterParameter::Parameter, ReadMicData));
+  parameters.push_back(SIMPL_NEW_FLOAT_VEC2_FP("Region Maximum (Microns)", RegionMaximum, FilterParameter::Parameter, ReadMicData));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Compact Euler Angles and Confidence", UseCompactArrays, FilterParameter::Parameter, ReadMicData));
   parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Data Container", DataContainerName, FilterParameter::CreatedArray, ReadMicData));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::CreatedArray));
   parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Cell Attribute Matrix", CellAttributeMatrixName, DataContainerName, FilterParameter::CreatedArray, ReadMicData));
+  parameters.push_back(SeparatorFilterParameter::New("Face Data", FilterParameter::CreatedArray));
+  parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Face Attribute Matrix", FaceAttributeMatrixName, DataContainerName, FilterParameter::CreatedArray, ReadMicData));
   parameters.push_back(SeparatorFilterParameter::New("Cell Ensemble Data", FilterParameter::CreatedArray));
   parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Cell Ensemble Attribute Matrix", CellEnsembleAttributeMatrixName, DataContainerName, FilterParameter::CreatedArray, ReadMicData));
   setFilterParameters(parameters);
@@ -152,6 +222,17 @@ void ReadMicData::readFilterParameters(AbstractFilterParametersReader* reader, i
   setCellAttributeMatrixName(reader->readString("CellAttributeMatrixName", getCellAttributeMatrixName()));
   setCellEnsembleAttributeMatrixName(reader->readString("CellEnsembleAttributeMatrixName", getCellEnsembleAttributeMatrixName()));
   setInputFile(reader->readString("InputFile", getInputFile()));
+  setUseCacheFile(reader->readValue("UseCacheFile", getUseCacheFile()));
+  setSharedCacheSize(reader->readValue("SharedCacheSize", getSharedCacheSize()));
+  setOutputGeometryType(reader->readValue("OutputGeometryType", getOutputGeometryType()));
+  setFaceAttributeMatrixName(reader->readString("FaceAttributeMatrixName", getFaceAttributeMatrixName()));
+  setUseConfidenceThreshold(reader->readValue("UseConfidenceThreshold", getUseConfidenceThreshold()));
+  setConfidenceThreshold(reader->readValue("ConfidenceThreshold", getConfidenceThreshold()));
+  setGoodTrianglesOnly(reader->readValue("GoodTrianglesOnly", getGoodTrianglesOnly()));
+  setUseRegionOfInterest(reader->readValue("UseRegionOfInterest", getUseRegionOfInterest()));
+  setRegionMinimum(reader->readFloatVec2("RegionMinimum", getRegionMinimum()));
+  setRegionMaximum(reader->readFloatVec2("RegionMaximum", getRegionMaximum()));
+  setUseCompactArrays(reader->readValue("UseCompactArrays", getUseCompactArrays()));
   reader->closeFilterGroup();
 }
 
@@ -163,6 +244,7 @@ void ReadMicData::flushCache()
   setInputFile_Cache("");
   setTimeStamp_Cache(QDateTime());
   setData(Mic_Private_Data());
+  MicReaderCache::Instance()->remove(m_InputFile);
 }
 
 // -----------------------------------------------------------------------------
@@ -176,13 +258,25 @@ void ReadMicData::populateMicData(MicReader* reader, DataContainer::Pointer m, Q
   {
     setInputFile_Cache(""); // We need something to trigger the file read below
   }
+  QVector<float> regionOfInterest;
+  if(m_UseRegionOfInterest)
+  {
+    regionOfInterest = {m_RegionMinimum[0], m_RegionMaximum[0], m_RegionMinimum[1], m_RegionMaximum[1]};
+  }
   // Drop into this if statement if we need to read from a file
-  if(m_InputFile != getInputFile_Cache() || !getTimeStamp_Cache().isValid() || getTimeStamp_Cache() < timeStamp)
+  if(m_InputFile != getInputFile_Cache() || !getTimeStamp_Cache().isValid() || getTimeStamp_Cache() < timeStamp || getData().regionOfInterest != regionOfInterest)
   {
     int zDim = 1;
     float zStep = 1.0, xOrigin = 0.0f, yOrigin = 0.0f, zOrigin = 0.0f;
+    if(m_UseRegionOfInterest)
+    {
+      xOrigin = m_RegionMinimum[0];
+      yOrigin = m_RegionMinimum[1];
+    }
 
     reader->setFileName(m_InputFile);
+    reader->setUseCacheFile(m_UseCacheFile);
+    reader->setRegionOfInterest(MicRegion(m_UseRegionOfInterest, m_RegionMinimum, m_RegionMaximum));
 
     if(flag == MIC_HEADER_ONLY)
     {
@@ -223,6 +317,7 @@ void ReadMicData::populateMicData(MicReader* reader, DataContainer::Pointer m, Q
       data.origin[1] = yOrigin;
       data.origin[2] = zOrigin;
       data.phases = reader->getPhaseVector();
+      data.regionOfInterest = regionOfInterest;
       setData(data);
 
       setInputFile_Cache(m_InputFile);
@@ -238,13 +333,15 @@ void ReadMicData::populateMicData(MicReader* reader, DataContainer::Pointer m, Q
   }
 
   // Read from cache
+  ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
+  if(nullptr != image.get())
   {
     dims[0] = getData().dims[0];
     dims[1] = getData().dims[1];
     dims[2] = getData().dims[2];
-    m->getGeometryAs<ImageGeom>()->setDimensions(dims[0], dims[1], dims[2]);
-    m->getGeometryAs<ImageGeom>()->setSpacing(getData().resolution);
-    m->getGeometryAs<ImageGeom>()->setOrigin(getData().origin);
+    image->setDimensions(dims[0], dims[1], dims[2]);
+    image->setSpacing(getData().resolution);
+    image->setOrigin(getData().origin);
   }
 
   if(flag == MIC_FULL_FILE)
@@ -278,12 +375,50 @@ void ReadMicData::dataCheck()
     return;
   }
 
-  // Create the Image Geometry
-  ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
-  m->setGeometry(image);
+  if(m_OutputGeometryType != MIC_IMAGE_GEOMETRY && m_OutputGeometryType != MIC_TRIANGLE_GEOMETRY)
+  {
+    QString ss = QObject::tr("The output geometry type %1 is not valid").arg(m_OutputGeometryType);
+    setErrorCondition(-389, ss);
+    return;
+  }
 
+  if(m_UseRegionOfInterest && (m_RegionMinimum[0] > m_RegionMaximum[0] || m_RegionMinimum[1] > m_RegionMaximum[1]))
+  {
+    QString ss = QObject::tr("The minimum of the region of interest must not be larger than its maximum");
+    setErrorCondition(-392, ss);
+    return;
+  }
+
+  if(m_SharedCacheSize < 0)
+  {
+    QString ss = QObject::tr("The size of the shared memory cache must not be negative");
+    setErrorCondition(-394, ss);
+    return;
+  }
+
+  // The Euler angles, phases and confidence are either Cell data of an Image Geometry or Face
+  // data of a Triangle Geometry. The number of triangles is only known once the file is read.
+  QString attrMatName = getCellAttributeMatrixName();
   QVector<size_t> tDims(3, 0);
-  AttributeMatrix::Pointer cellAttrMat = m->createNonPrereqAttributeMatrix(this, getCellAttributeMatrixName(), tDims, AttributeMatrix::Type::Cell, AttributeMatrixID21);
+  AttributeMatrix::Pointer cellAttrMat;
+  if(m_OutputGeometryType == MIC_TRIANGLE_GEOMETRY)
+  {
+    SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(0, !getInPreflight());
+    TriangleGeom::Pointer triangleGeom = TriangleGeom::CreateGeometry(0, vertices, SIMPL::Geometry::TriangleGeometry, !getInPreflight());
+    m->setGeometry(triangleGeom);
+
+    attrMatName = getFaceAttributeMatrixName();
+    tDims.resize(1);
+    cellAttrMat = m->createNonPrereqAttributeMatrix(this, attrMatName, tDims, AttributeMatrix::Type::Face, AttributeMatrixID23);
+  }
+  else
+  {
+    // Create the Image Geometry
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    m->setGeometry(image);
+
+    cellAttrMat = m->createNonPrereqAttributeMatrix(this, attrMatName, tDims, AttributeMatrix::Type::Cell, AttributeMatrixID21);
+  }
   if(getErrorCode() < 0)
   {
     return;
@@ -322,7 +457,10 @@ void ReadMicData::dataCheck()
       populateMicData(reader, m, dims, MIC_HEADER_ONLY);
 
       // Update the size of the Cell Attribute Matrix now that the dimensions of the volume are known
-      cellAttrMat->resizeAttributeArrays(dims);
+      if(m_OutputGeometryType == MIC_IMAGE_GEOMETRY)
+      {
+        cellAttrMat->resizeAttributeArrays(dims);
+      }
       MicFields micfeatures;
       names = micfeatures.getFilterFeatures<QVector<QString>>();
       QVector<size_t> dims(1, 1);
@@ -332,6 +470,10 @@ void ReadMicData::dataCheck()
         {
           cellAttrMat->createAndAddAttributeArray<DataArray<int32_t>, AbstractFilter, int32_t>(this, names[i], 0, dims);
         }
+        else if(m_UseCompactArrays && names[i] == Mic::Confidence)
+        {
+          cellAttrMat->createAndAddAttributeArray<DataArray<uint8_t>, AbstractFilter, uint8_t>(this, Mic::CompactConfidence, 0, dims);
+        }
         else if(reader->getPointerType(names[i]) == Ebsd::Float)
         {
           cellAttrMat->createAndAddAttributeArray<DataArray<float>, AbstractFilter, float>(this, names[i], 0, dims);
@@ -348,15 +490,28 @@ void ReadMicData::dataCheck()
     }
 
     QVector<size_t> dim(1, 3);
-    tempPath.update(getDataContainerName().getDataContainerName(), getCellAttributeMatrixName(), getCellEulerAnglesArrayName());
-    m_CellEulerAnglesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(
-        this, tempPath, 0, dim);                     /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
-    if(nullptr != m_CellEulerAnglesPtr.lock())       /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    if(m_UseCompactArrays)
     {
-      m_CellEulerAngles = m_CellEulerAnglesPtr.lock()->getPointer(0);
-    } /* Now assign the raw pointer to data from the DataArray<T> object */
+      tempPath.update(getDataContainerName().getDataContainerName(), attrMatName, Mic::CompactEulerAngles);
+      m_CellCompactEulerAnglesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<uint16_t>, AbstractFilter, uint16_t>(
+          this, tempPath, 0, dim);                     /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+      if(nullptr != m_CellCompactEulerAnglesPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+      {
+        m_CellCompactEulerAngles = m_CellCompactEulerAnglesPtr.lock()->getPointer(0);
+      } /* Now assign the raw pointer to data from the DataArray<T> object */
+    }
+    else
+    {
+      tempPath.update(getDataContainerName().getDataContainerName(), attrMatName, getCellEulerAnglesArrayName());
+      m_CellEulerAnglesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(
+          this, tempPath, 0, dim);                     /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+      if(nullptr != m_CellEulerAnglesPtr.lock())       /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+      {
+        m_CellEulerAngles = m_CellEulerAnglesPtr.lock()->getPointer(0);
+      } /* Now assign the raw pointer to data from the DataArray<T> object */
+    }
     dim[0] = 1;
-    tempPath.update(getDataContainerName().getDataContainerName(), getCellAttributeMatrixName(), getCellPhasesArrayName());
+    tempPath.update(getDataContainerName().getDataContainerName(), attrMatName, getCellPhasesArrayName());
     m_CellPhasesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter, int32_t>(
         this, tempPath, 0, dim);                /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
     if(nullptr != m_CellPhasesPtr.lock())       /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
@@ -437,35 +592,74 @@ void ReadMicData::execute()
 void ReadMicData::readMicFile()
 {
   int err = 0;
-  std::shared_ptr<MicReader> reader(new MicReader());
-  reader->setFileName(m_InputFile);
-  err = reader->readFile();
-  if(err < 0)
+  // Reuse the data if this file was already read by any filter in this session. The
+  // cached reader is shared so nothing below may write into its arrays. A cached reader
+  // that was read with other row filters or another region of interest is replaced.
+  bool resampleToGrid = (m_OutputGeometryType == MIC_IMAGE_GEOMETRY);
+  MicRowFilter rowFilter;
+  rowFilter.useMinConfidence = m_UseConfidenceThreshold;
+  rowFilter.minConfidence = m_ConfidenceThreshold;
+  rowFilter.goodOnly = m_GoodTrianglesOnly;
+  MicRegionOfInterest region = MicRegion(m_UseRegionOfInterest, m_RegionMinimum, m_RegionMaximum);
+  // The budget is shared by every filter of the session, so a filter only ever grows it.
+  // A size of zero keeps the file of this filter out of the cache and leaves the others alone.
+  MicReaderCache::Instance()->growMemoryBudget(static_cast<size_t>(m_SharedCacheSize) * 1024ULL * 1024ULL);
+  std::shared_ptr<MicReader> reader = MicReaderCache::Instance()->find(m_InputFile);
+  if(nullptr == reader.get() || reader->getRowFilter() != rowFilter || reader->getRegionOfInterest() != region)
   {
-    setErrorCondition(err, reader->getErrorMessage());
+    reader.reset(new MicReader());
+    reader->setFileName(m_InputFile);
+    reader->setUseCacheFile(m_UseCacheFile);
+    // Both output geometries are made from the triangle table, which is much smaller than
+    // the grid, so the table is what the reader holds and what is kept for later filters
+    reader->setResampleToGrid(false);
+    reader->setRowFilter(rowFilter);
+    reader->setRegionOfInterest(region);
+    // Only the columns that end up in the data container are converted
+    QSet<QString> arrayNames;
+    arrayNames << Mic::Euler1 << Mic::Euler2 << Mic::Euler3 << Mic::Phase;
+    MicFields micFields;
+    for(const QString& name : micFields.getFilterFeatures<QVector<QString>>())
+    {
+      arrayNames.insert(name);
+    }
+    reader->readAllArrays(false);
+    reader->setArraysToRead(arrayNames);
+
+    err = reader->readFile();
+    if(err < 0)
+    {
+      setErrorCondition(err, reader->getErrorMessage());
+      return;
+    }
+    // The reader is kept but never reads another file, so it holds on to its data only
+    reader->releaseScratchMemory();
+    if(m_SharedCacheSize > 0)
+    {
+      MicReaderCache::Instance()->insert(m_InputFile, reader);
+    }
+  }
+  if(!resampleToGrid)
+  {
+    createTriangleGeometry(reader.get());
     return;
   }
+
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
   AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(getCellAttributeMatrixName());
 
-  int64_t dims[3];
-  dims[0] = reader->getXDimension();
-  dims[1] = reader->getYDimension();
-  dims[2] = 1; // We are reading a single slice
-  m->getGeometryAs<ImageGeom>()->setDimensions(dims[0], dims[1], dims[2]);
+  // The .mic file is in mm while the Image Geometry is in microns
+  m->getGeometryAs<ImageGeom>()->setDimensions(reader->getXDimension(), reader->getYDimension(), 1); // We are reading a single slice
   m->getGeometryAs<ImageGeom>()->setSpacing(FloatVec3Type(reader->getXStep(), reader->getYStep(), 1.0));
-  m->getGeometryAs<ImageGeom>()->setOrigin(FloatVec3Type(0.0f, 0.0f, 0.0f));
+  m->getGeometryAs<ImageGeom>()->setOrigin(FloatVec3Type(reader->getXOrigin() * 1000.0f, reader->getYOrigin() * 1000.0f, 0.0f));
+  if(m_UseRegionOfInterest)
+  {
+    // The region itself is the origin, without the rounding of the conversion to mm and back
+    m->getGeometryAs<ImageGeom>()->setOrigin(FloatVec3Type(m_RegionMinimum[0], m_RegionMinimum[1], 0.0f));
+  }
 
   err = loadMaterialInfo(reader.get());
 
-  float* f1 = nullptr;
-  float* f2 = nullptr;
-  float* f3 = nullptr;
-  int* phasePtr = nullptr;
-
-  FloatArrayType::Pointer fArray = FloatArrayType::NullPointer();
-  Int32ArrayType::Pointer iArray = Int32ArrayType::NullPointer();
-  size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
   // Prepare the Cell Attribute Matrix with the correct number of tuples based on the total points being read from the file.
   QVector<size_t> tDims(3, 0);
   tDims[0] = m->getGeometryAs<ImageGeom>()->getXPoints();
@@ -473,71 +667,184 @@ void ReadMicData::readMicFile()
   tDims[2] = m->getGeometryAs<ImageGeom>()->getZPoints();
   cellAttrMat->resizeAttributeArrays(tDims);
 
-  float x, y;
-  float xMin = 10000000;
-  float yMin = 10000000;
-  f1 = reinterpret_cast<float*>(reader->getPointerByName(Mic::X));
-  f2 = reinterpret_cast<float*>(reader->getPointerByName(Mic::Y));
+  // The triangles are resampled straight into the arrays of the Cell Attribute Matrix, so
+  // the grid is never held by the reader and copied afterwards
+  size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
+  MicGridTarget target;
+  target.xDim = reader->getXDimension();
+  target.yDim = reader->getYDimension();
+  target.spacing = reader->getEdgeLength();
+  target.xOrigin = reader->getXOrigin();
+  target.yOrigin = reader->getYOrigin();
+  QVector<IDataArray::Pointer> micArrays = createMicArrays(totalPoints, target);
+  if(micArrays.isEmpty())
+  {
+    QString ss = QObject::tr("The arrays for the %1 elements of the .mic file could not be allocated").arg(totalPoints);
+    setErrorCondition(-391, ss);
+    return;
+  }
+  if(!reader->resampleTriangles(target))
+  {
+    QString ss = QObject::tr("The triangles of the .mic file could not be resampled: '%1'").arg(getInputFile());
+    setErrorCondition(-395, ss);
+    return;
+  }
+
+  // Grid points that no triangle covers belong to the first phase, like in copyMicArrays()
   for(size_t i = 0; i < totalPoints; i++)
   {
-    x = f1[i];
-    y = f2[i];
-    if(x < xMin)
-    {
-      xMin = x;
-    }
-    if(y < yMin)
+    if(target.phases[i] < 1)
     {
-      yMin = y;
+      target.phases[i] = 1;
     }
   }
-  m->getGeometryAs<ImageGeom>()->setOrigin(FloatVec3Type(xMin, yMin, 0.0));
+  for(const IDataArray::Pointer& array : micArrays)
+  {
+    cellAttrMat->insertOrAssign(array);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadMicData::createTriangleGeometry(MicReader* reader)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  AttributeMatrix::Pointer faceAttrMat = m->getAttributeMatrix(getFaceAttributeMatrixName());
+
+  MicLattice::Pointer lattice = reader->getLattice();
+  if(nullptr == lattice.get())
+  {
+    QString ss = QObject::tr("The triangles in the .mic file are not on a regular lattice: '%1'").arg(getInputFile());
+    setErrorCondition(-390, ss);
+    return;
+  }
+  size_t numTriangles = lattice->getNumberOfTriangles();
+  MicTriangleMesh mesh;
+  mesh.build(*lattice);
+
+  // The .mic file is in mm while the Image Geometry and the vertices are in microns
+  size_t numVertices = mesh.getNumberOfVertices();
+  SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(numVertices);
+  const float* meshVertices = mesh.getVertices();
+  float* vertex = vertices->getPointer(0);
+  for(size_t i = 0; i < 3 * numVertices; i++)
+  {
+    vertex[i] = meshVertices[i] * 1000.0f;
+  }
+
+  TriangleGeom::Pointer triangleGeom = TriangleGeom::CreateGeometry(numTriangles, vertices, SIMPL::Geometry::TriangleGeometry);
+  const size_t* meshTriangles = mesh.getTriangles();
+  std::copy(meshTriangles, meshTriangles + 3 * numTriangles, triangleGeom->getTriangles()->getPointer(0));
+  m->setGeometry(triangleGeom);
+
+  loadMaterialInfo(reader);
+
+  QVector<size_t> tDims(1, numTriangles);
+  faceAttrMat->resizeAttributeArrays(tDims);
+  copyMicArrays(reader, faceAttrMat);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadMicData::copyMicArrays(MicReader* reader, AttributeMatrix::Pointer attrMat)
+{
+  size_t totalPoints = attrMat->getNumberOfTuples();
+  MicGridTarget target;
+  QVector<IDataArray::Pointer> arrays = createMicArrays(totalPoints, target);
+  if(arrays.isEmpty())
+  {
+    QString ss = QObject::tr("The arrays for the %1 elements of the .mic file could not be allocated").arg(totalPoints);
+    setErrorCondition(-391, ss);
+    return;
+  }
 
+  //  radianconversion = M_PI / 180.0;
+  float* f1 = reinterpret_cast<float*>(reader->getPointerByName(Mic::Euler1));
+  float* f2 = reinterpret_cast<float*>(reader->getPointerByName(Mic::Euler2));
+  float* f3 = reinterpret_cast<float*>(reader->getPointerByName(Mic::Euler3));
+  for(size_t i = 0; i < totalPoints; i++)
   {
-    phasePtr = reinterpret_cast<int*>(reader->getPointerByName(Mic::Phase));
-    for(size_t i = 0; i < totalPoints; i++)
+    if(nullptr != target.compactEulerAngles)
     {
-      if(phasePtr[i] < 1)
-      {
-        phasePtr[i] = 1;
-      }
+      target.compactEulerAngles[3 * i] = MicCompactCodec::encodeEulerAngle(f1[i]);
+      target.compactEulerAngles[3 * i + 1] = MicCompactCodec::encodeEulerAngle(f2[i]);
+      target.compactEulerAngles[3 * i + 2] = MicCompactCodec::encodeEulerAngle(f3[i]);
     }
-    iArray = Int32ArrayType::CreateArray(totalPoints, SIMPL::CellData::Phases);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMat->insertOrAssign(iArray);
+    else
+    {
+      target.eulerAngles[3 * i] = f1[i];
+      target.eulerAngles[3 * i + 1] = f2[i];
+      target.eulerAngles[3 * i + 2] = f3[i];
+    }
+  }
+
+  int* phasePtr = reinterpret_cast<int*>(reader->getPointerByName(Mic::Phase));
+  for(size_t i = 0; i < totalPoints; i++)
+  {
+    target.phases[i] = (phasePtr[i] < 1) ? 1 : phasePtr[i];
   }
 
+  f1 = reinterpret_cast<float*>(reader->getPointerByName(Mic::Confidence));
+  if(nullptr != target.compactConfidences)
+  {
+    MicCompactCodec::encodeConfidences(f1, target.compactConfidences, totalPoints);
+  }
+  else
+  {
+    ::memcpy(target.confidences, f1, sizeof(float) * totalPoints);
+  }
+
+  for(const IDataArray::Pointer& array : arrays)
+  {
+    attrMat->insertOrAssign(array);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<IDataArray::Pointer> ReadMicData::createMicArrays(size_t numTuples, MicGridTarget& target)
+{
   QVector<size_t> compDims(1, 3); // Initially set this up for the Euler Angle 1x3
+  QVector<IDataArray::Pointer> arrays;
+  if(m_UseCompactArrays)
   {
-    //  radianconversion = M_PI / 180.0;
-    f1 = reinterpret_cast<float*>(reader->getPointerByName(Mic::Euler1));
-    f2 = reinterpret_cast<float*>(reader->getPointerByName(Mic::Euler2));
-    f3 = reinterpret_cast<float*>(reader->getPointerByName(Mic::Euler3));
-    fArray = FloatArrayType::CreateArray(totalPoints, compDims, SIMPL::CellData::EulerAngles);
-    float* cellEulerAngles = fArray->getPointer(0);
-    for(size_t i = 0; i < totalPoints; i++)
+    UInt16ArrayType::Pointer eulerAngles = UInt16ArrayType::CreateArray(numTuples, compDims, Mic::CompactEulerAngles);
+    compDims[0] = 1;
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(numTuples, compDims, SIMPL::CellData::Phases);
+    UInt8ArrayType::Pointer confidences = UInt8ArrayType::CreateArray(numTuples, compDims, Mic::CompactConfidence);
+    if(nullptr == eulerAngles.get() || nullptr == phases.get() || nullptr == confidences.get())
     {
-      cellEulerAngles[3 * i] = f1[i];
-      cellEulerAngles[3 * i + 1] = f2[i];
-      cellEulerAngles[3 * i + 2] = f3[i];
+      return arrays;
     }
-    cellAttrMat->insertOrAssign(fArray);
+    eulerAngles->initializeWithZeros();
+    phases->initializeWithZeros();
+    confidences->initializeWithZeros();
+    target.compactEulerAngles = eulerAngles->getPointer(0);
+    target.phases = phases->getPointer(0);
+    target.compactConfidences = confidences->getPointer(0);
+    arrays << eulerAngles << phases << confidences;
+    return arrays;
   }
 
+  FloatArrayType::Pointer eulerAngles = FloatArrayType::CreateArray(numTuples, compDims, SIMPL::CellData::EulerAngles);
   compDims[0] = 1; // Now reset the size of the first dimension to 1
+  Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(numTuples, compDims, SIMPL::CellData::Phases);
+  FloatArrayType::Pointer confidences = FloatArrayType::CreateArray(numTuples, compDims, Mic::Confidence);
+  if(nullptr == eulerAngles.get() || nullptr == phases.get() || nullptr == confidences.get())
   {
-    phasePtr = reinterpret_cast<int*>(reader->getPointerByName(Mic::Phase));
-    iArray = Int32ArrayType::CreateArray(totalPoints, compDims, SIMPL::CellData::Phases);
-    ::memcpy(iArray->getPointer(0), phasePtr, sizeof(int32_t) * totalPoints);
-    cellAttrMat->insertOrAssign(iArray);
-  }
-
-  {
-    f1 = reinterpret_cast<float*>(reader->getPointerByName(Mic::Confidence));
-    fArray = FloatArrayType::CreateArray(totalPoints, compDims, Mic::Confidence);
-    ::memcpy(fArray->getPointer(0), f1, sizeof(float) * totalPoints);
-    cellAttrMat->insertOrAssign(fArray);
+    return arrays;
   }
+  eulerAngles->initializeWithZeros();
+  phases->initializeWithZeros();
+  confidences->initializeWithZeros();
+  target.eulerAngles = eulerAngles->getPointer(0);
+  target.phases = phases->getPointer(0);
+  target.confidences = confidences->getPointer(0);
+  arrays << eulerAngles << phases << confidences;
+  return arrays;
 }
 
 // -----------------------------------------------------------------------------
@@ -627,14 +934,12 @@ int ReadMicData::loadMaterialInfo(MicReader* reader)
     int phaseID = phases[i]->getPhaseIndex();
     crystalStructures->setValue(phaseID, phases[i]->determineLaueGroup());
     materialNames->setValue(phaseID, phases[i]->getMaterialName());
+    // The phase of the .config file has no lattice constants, the one of the .dat file that follows it has
     QVector<float> lc = phases[i]->getLatticeConstants();
-
-    latticeConstants->setComponent(phaseID, 0, lc[0]);
-    latticeConstants->setComponent(phaseID, 1, lc[1]);
-    latticeConstants->setComponent(phaseID, 2, lc[2]);
-    latticeConstants->setComponent(phaseID, 3, lc[3]);
-    latticeConstants->setComponent(phaseID, 4, lc[4]);
-    latticeConstants->setComponent(phaseID, 5, lc[5]);
+    for(int c = 0; c < 6; c++)
+    {
+      latticeConstants->setComponent(phaseID, c, (c < lc.size()) ? lc[c] : 0.0f);
+    }
   }
   DataContainer::Pointer vdc = getDataContainerArray()->getDataContainer(getDataContainerName());
   if(nullptr == vdc)
@@ -51,6 +51,7 @@
 #include "HEDMAnalysis/HEDMAnalysisConstants.h"
 
 class MicReader;
+struct MicGridTarget;
 
 struct Mic_Private_Data
 {
@@ -58,6 +59,7 @@ struct Mic_Private_Data
   FloatVec3Type resolution;
   FloatVec3Type origin;
   QVector<MicPhase::Pointer> phases;
+  QVector<float> regionOfInterest; // xMin, xMax, yMin, yMax the dims were read for, empty for the whole file
 };
 
 enum MIC_READ_FLAG
@@ -66,6 +68,12 @@ enum MIC_READ_FLAG
   MIC_HEADER_ONLY
 };
 
+enum MIC_OUTPUT_GEOMETRY
+{
+  MIC_IMAGE_GEOMETRY,
+  MIC_TRIANGLE_GEOMETRY
+};
+
 // our PIMPL private class
 class ReadMicDataPrivate;
 
@@ -87,6 +95,17 @@ class HEDMAnalysis_EXPORT ReadMicData : public AbstractFilter
     PYB11_PROPERTY(QString CellAttributeMatrixName READ getCellAttributeMatrixName WRITE setCellAttributeMatrixName)
     PYB11_PROPERTY(bool FileWasRead READ getFileWasRead WRITE setFileWasRead)
     PYB11_PROPERTY(QString InputFile READ getInputFile WRITE setInputFile)
+    PYB11_PROPERTY(bool UseCacheFile READ getUseCacheFile WRITE setUseCacheFile)
+    PYB11_PROPERTY(int SharedCacheSize READ getSharedCacheSize WRITE setSharedCacheSize)
+    PYB11_PROPERTY(int OutputGeometryType READ getOutputGeometryType WRITE setOutputGeometryType)
+    PYB11_PROPERTY(QString FaceAttributeMatrixName READ getFaceAttributeMatrixName WRITE setFaceAttributeMatrixName)
+    PYB11_PROPERTY(bool UseConfidenceThreshold READ getUseConfidenceThreshold WRITE setUseConfidenceThreshold)
+    PYB11_PROPERTY(float ConfidenceThreshold READ getConfidenceThreshold WRITE setConfidenceThreshold)
+    PYB11_PROPERTY(bool GoodTrianglesOnly READ getGoodTrianglesOnly WRITE setGoodTrianglesOnly)
+    PYB11_PROPERTY(bool UseRegionOfInterest READ getUseRegionOfInterest WRITE setUseRegionOfInterest)
+    PYB11_PROPERTY(FloatVec2Type RegionMinimum READ getRegionMinimum WRITE setRegionMinimum)
+    PYB11_PROPERTY(FloatVec2Type RegionMaximum READ getRegionMaximum WRITE setRegionMaximum)
+    PYB11_PROPERTY(bool UseCompactArrays READ getUseCompactArrays WRITE setUseCompactArrays)
     Q_DECLARE_PRIVATE(ReadMicData)
 
   public:
@@ -114,6 +133,64 @@ class HEDMAnalysis_EXPORT ReadMicData : public AbstractFilter
     SIMPL_FILTER_PARAMETER(QString, InputFile)
     Q_PROPERTY(QString InputFile READ getInputFile WRITE setInputFile)
 
+    SIMPL_FILTER_PARAMETER(bool, UseCacheFile)
+    Q_PROPERTY(bool UseCacheFile READ getUseCacheFile WRITE setUseCacheFile)
+
+    /**
+     * @brief The memory budget in MiB that this filter asks of the MicReaderCache that keeps the
+     * .mic files read in this session. The cache is shared by every filter, so execute() only
+     * ever grows its budget. Zero keeps the file of this filter out of the cache.
+     */
+    SIMPL_FILTER_PARAMETER(int, SharedCacheSize)
+    Q_PROPERTY(int SharedCacheSize READ getSharedCacheSize WRITE setSharedCacheSize)
+
+    /**
+     * @brief 0 resamples the triangles onto an Image Geometry, 1 creates a Triangle
+     * Geometry with one face per triangle of the .mic file
+     */
+    SIMPL_FILTER_PARAMETER(int, OutputGeometryType)
+    Q_PROPERTY(int OutputGeometryType READ getOutputGeometryType WRITE setOutputGeometryType)
+
+    SIMPL_FILTER_PARAMETER(QString, FaceAttributeMatrixName)
+    Q_PROPERTY(QString FaceAttributeMatrixName READ getFaceAttributeMatrixName WRITE setFaceAttributeMatrixName)
+
+    /**
+     * @brief Rows of the .mic file whose confidence is below ConfidenceThreshold are
+     * dropped while the file is parsed
+     */
+    SIMPL_FILTER_PARAMETER(bool, UseConfidenceThreshold)
+    Q_PROPERTY(bool UseConfidenceThreshold READ getUseConfidenceThreshold WRITE setUseConfidenceThreshold)
+
+    SIMPL_FILTER_PARAMETER(float, ConfidenceThreshold)
+    Q_PROPERTY(float ConfidenceThreshold READ getConfidenceThreshold WRITE setConfidenceThreshold)
+
+    /**
+     * @brief Rows of the .mic file that are not flagged as good are dropped while the file is parsed
+     */
+    SIMPL_FILTER_PARAMETER(bool, GoodTrianglesOnly)
+    Q_PROPERTY(bool GoodTrianglesOnly READ getGoodTrianglesOnly WRITE setGoodTrianglesOnly)
+
+    /**
+     * @brief Only the rectangle from RegionMinimum to RegionMaximum, in microns, is read.
+     * The Image Geometry spans just that rectangle.
+     */
+    SIMPL_FILTER_PARAMETER(bool, UseRegionOfInterest)
+    Q_PROPERTY(bool UseRegionOfInterest READ getUseRegionOfInterest WRITE setUseRegionOfInterest)
+
+    SIMPL_FILTER_PARAMETER(FloatVec2Type, RegionMinimum)
+    Q_PROPERTY(FloatVec2Type RegionMinimum READ getRegionMinimum WRITE setRegionMinimum)
+
+    SIMPL_FILTER_PARAMETER(FloatVec2Type, RegionMaximum)
+    Q_PROPERTY(FloatVec2Type RegionMaximum READ getRegionMaximum WRITE setRegionMaximum)
+
+    /**
+     * @brief When true the Euler angles are stored as 16 bit and the confidence as 8 bit
+     * MicCompactCodec codes in the Mic::CompactEulerAngles and Mic::CompactConfidence
+     * arrays instead of the float arrays
+     */
+    SIMPL_FILTER_PARAMETER(bool, UseCompactArrays)
+    Q_PROPERTY(bool UseCompactArrays READ getUseCompactArrays WRITE setUseCompactArrays)
+
     SIMPL_INSTANCE_PROPERTY(QString, CellEulerAnglesArrayName)
     SIMPL_INSTANCE_PROPERTY(QString, CellPhasesArrayName)
     SIMPL_INSTANCE_PROPERTY(QString, CrystalStructuresArrayName)
@@ -224,11 +301,34 @@ class HEDMAnalysis_EXPORT ReadMicData : public AbstractFilter
      */
     void populateMicData(MicReader* reader, DataContainer::Pointer m, QVector<size_t> dims, MIC_READ_FLAG = MIC_FULL_FILE);
 
+    /**
+     * @brief Creates the Triangle Geometry from the triangle table of the reader
+     * @param reader A reader that read the file with ResampleToGrid turned off
+     */
+    void createTriangleGeometry(MicReader* reader);
+
+    /**
+     * @brief Copies the Euler angles, phases and confidence of the reader into the attribute matrix
+     * @param reader The reader that read the file
+     * @param attrMat The Cell or Face attribute matrix, already resized to the number of elements of the reader
+     */
+    void copyMicArrays(MicReader* reader, AttributeMatrix::Pointer attrMat);
+
+    /**
+     * @brief Creates the zero filled Euler angle, phase and confidence arrays, compact ones if
+     * UseCompactArrays is set, and points the matching arrays of the target at them
+     * @param numTuples The number of elements
+     * @param target The target whose array pointers are set
+     * @return The arrays or an empty vector, and a target without arrays, if one could not be allocated
+     */
+    QVector<IDataArray::Pointer> createMicArrays(size_t numTuples, MicGridTarget& target);
+
   private:
     QScopedPointer<ReadMicDataPrivate> const d_ptr;
 
     DEFINE_DATAARRAY_VARIABLE(int32_t, CellPhases)
     DEFINE_DATAARRAY_VARIABLE(float, CellEulerAngles)
+    DEFINE_DATAARRAY_VARIABLE(uint16_t, CellCompactEulerAngles)
     DEFINE_DATAARRAY_VARIABLE(uint32_t, CrystalStructures)
     DEFINE_DATAARRAY_VARIABLE(float, LatticeConstants)
 
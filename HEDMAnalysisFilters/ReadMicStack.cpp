@@ -0,0 +1,620 @@
+/* ============================================================================
+* Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+* Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+* BlueQuartz Software nor the names of its contributors may be used to endorse
+* or promote products derived from this software without specific prior written
+* permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+*  This code was written under United States Air Force Contract number
+*                           FA8650-07-D-5800
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "ReadMicStack.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+#include <QtCore/QFileInfo>
+
+#include "EbsdLib/EbsdLib.h"
+#include "HEDMAnalysisFilters/HEDM/MicConstants.h"
+#include "HEDMAnalysisFilters/HEDM/MicReader.h"
+
+#include "SIMPLib/DataArrays/StringDataArray.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/DataContainerCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/FloatFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/FilePathGenerator.h"
+
+#include "HEDMAnalysis/HEDMAnalysisConstants.h"
+
+enum createdPathID : RenameDataPath::DataID_t
+{
+  AttributeMatrixID21 = 21,
+  AttributeMatrixID22 = 22,
+
+  DataArrayID31 = 31,
+  DataArrayID32 = 32,
+  DataArrayID33 = 33,
+  DataArrayID34 = 34,
+  DataArrayID35 = 35,
+
+  DataContainerID = 1
+};
+
+namespace
+{
+/**
+ * @brief Returns whether two layers have the same phases. The ensemble arrays are filled
+ * from the phases of the first layer, so they only describe a stack whose layers agree.
+ */
+bool SamePhases(const QVector<MicPhase::Pointer>& phases, const QVector<MicPhase::Pointer>& otherPhases)
+{
+  if(phases.size() != otherPhases.size())
+  {
+    return false;
+  }
+  for(int i = 0; i < phases.size(); i++)
+  {
+    const MicPhase::Pointer& phase = phases[i];
+    const MicPhase::Pointer& other = otherPhases[i];
+    if(phase->getPhaseIndex() != other->getPhaseIndex() || phase->getSymmetry() != other->getSymmetry() || phase->getLatticeConstants() != other->getLatticeConstants() ||
+       phase->getBasisAtoms() != other->getBasisAtoms() || phase->getZandCoordinates() != other->getZandCoordinates())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+/**
+ * @brief Reads a range of layers of the stack, each one into its own slice of the cell arrays.
+ * The layers of a range share one MicReader so its arenas are allocated once per range.
+ */
+class ReadMicLayersImpl
+{
+  ReadMicStack* m_Filter;
+
+public:
+  ReadMicLayersImpl(ReadMicStack* filter)
+  : m_Filter(filter)
+  {
+  }
+  virtual ~ReadMicLayersImpl() = default;
+
+  void convert(size_t start, size_t end) const
+  {
+    MicReader reader;
+    reader.setUseHugePages(true);
+    for(size_t layer = start; layer < end && !m_Filter->getCancel(); layer++)
+    {
+      m_Filter->readLayer(layer, reader);
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ReadMicStack::ReadMicStack()
+: m_ZSpacing(1.0f)
+, m_UseCompactArrays(false)
+, m_DataContainerName(SIMPL::Defaults::ImageDataContainerName)
+, m_CellAttributeMatrixName(SIMPL::Defaults::CellAttributeMatrixName)
+, m_CellEnsembleAttributeMatrixName(SIMPL::Defaults::CellEnsembleAttributeMatrixName)
+, m_CellEulerAnglesArrayName(SIMPL::CellData::EulerAngles)
+, m_CellPhasesArrayName(SIMPL::CellData::Phases)
+, m_CellConfidenceArrayName(Mic::Confidence)
+, m_CrystalStructuresArrayName(SIMPL::EnsembleData::CrystalStructures)
+, m_LatticeConstantsArrayName(SIMPL::EnsembleData::LatticeConstants)
+, m_MaterialNameArrayName(SIMPL::EnsembleData::PhaseName)
+{
+  m_InputFileListInfo.StartIndex = 0;
+  m_InputFileListInfo.EndIndex = 0;
+  m_InputFileListInfo.IncrementIndex = 1;
+  m_InputFileListInfo.PaddingDigits = 0;
+  m_InputFileListInfo.Ordering = 0;
+  m_InputFileListInfo.FileExtension = Mic::FileExt;
+  m_InputFileListInfo.FilePrefix = "";
+  m_InputFileListInfo.FileSuffix = "";
+  m_InputFileListInfo.InputPath = "";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ReadMicStack::~ReadMicStack() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadMicStack::setupFilterParameters()
+{
+  FilterParameterVectorType parameters;
+  parameters.push_back(SIMPL_NEW_FILELISTINFO_FP("Input File List", InputFileListInfo, FilterParameter::Parameter, ReadMicStack));
+  parameters.push_back(SIMPL_NEW_FLOAT_FP("Z Spacing", ZSpacing, FilterParameter::Parameter, ReadMicStack));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Compact Euler Angles and Confidence", UseCompactArrays, FilterParameter::Parameter, ReadMicStack));
+  parameters.push_back(SIMPL_NEW_DC_CREATION_FP("Data Container", DataContainerName, FilterParameter::CreatedArray, ReadMicStack));
+  parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::CreatedArray));
+  parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Cell Attribute Matrix", CellAttributeMatrixName, DataContainerName, FilterParameter::CreatedArray, ReadMicStack));
+  parameters.push_back(SeparatorFilterParameter::New("Cell Ensemble Data", FilterParameter::CreatedArray));
+  parameters.push_back(SIMPL_NEW_AM_WITH_LINKED_DC_FP("Cell Ensemble Attribute Matrix", CellEnsembleAttributeMatrixName, DataContainerName, FilterParameter::CreatedArray, ReadMicStack));
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadMicStack::readFilterParameters(AbstractFilterParametersReader* reader, int index)
+{
+  reader->openFilterGroup(this, index);
+  setInputFileListInfo(reader->readFileListInfo("InputFileListInfo", getInputFileListInfo()));
+  setZSpacing(reader->readValue("ZSpacing", getZSpacing()));
+  setUseCompactArrays(reader->readValue("UseCompactArrays", getUseCompactArrays()));
+  setDataContainerName(reader->readDataArrayPath("DataContainerName", getDataContainerName()));
+  setCellAttributeMatrixName(reader->readString("CellAttributeMatrixName", getCellAttributeMatrixName()));
+  setCellEnsembleAttributeMatrixName(reader->readString("CellEnsembleAttributeMatrixName", getCellEnsembleAttributeMatrixName()));
+  reader->closeFilterGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadMicStack::initialize()
+{
+  m_XPoints = 0;
+  m_YPoints = 0;
+  m_Spacing = 0.0f;
+  m_XOrigin = 0.0f;
+  m_YOrigin = 0.0f;
+  m_FileList.clear();
+  m_Phases.clear();
+  m_LayerErrorCodes.clear();
+  m_LayerErrorMessages.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadMicStack::dataCheck()
+{
+  DataArrayPath tempPath;
+  clearErrorCode();
+  clearWarningCode();
+  initialize();
+
+  DataContainer::Pointer m = getDataContainerArray()->createNonPrereqDataContainer<AbstractFilter>(this, getDataContainerName(), DataContainerID);
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+  m->setGeometry(image);
+
+  if(m_ZSpacing <= 0.0f)
+  {
+    QString ss = QObject::tr("The Z spacing must be greater than zero");
+    setErrorCondition(-12, ss);
+    return;
+  }
+
+  bool hasMissingFiles = false;
+  bool orderAscending = false;
+
+  if(m_InputFileListInfo.Ordering == 0)
+  {
+    orderAscending = true;
+  }
+  else if(m_InputFileListInfo.Ordering == 1)
+  {
+    orderAscending = false;
+  }
+
+  // Now generate all the file names the user is asking for
+  m_FileList = FilePathGenerator::GenerateFileList(m_InputFileListInfo.StartIndex, m_InputFileListInfo.EndIndex, m_InputFileListInfo.IncrementIndex, hasMissingFiles, orderAscending,
+                                                   m_InputFileListInfo.InputPath, m_InputFileListInfo.FilePrefix, m_InputFileListInfo.FileSuffix, m_InputFileListInfo.FileExtension,
+                                                   m_InputFileListInfo.PaddingDigits);
+  if(m_FileList.empty())
+  {
+    QString ss = QObject::tr("No files have been selected for import. Have you set the input directory?");
+    setErrorCondition(-11, ss);
+    return;
+  }
+
+  // The headers give the edge length and the hexagon that can hold the triangles of
+  // each layer. The volume uses the finest edge length as its spacing and covers the
+  // hexagons of all the layers, so every layer is resampled onto the same XY grid.
+  float xMin = std::numeric_limits<float>::max();
+  float yMin = std::numeric_limits<float>::max();
+  float xMax = std::numeric_limits<float>::lowest();
+  float yMax = std::numeric_limits<float>::lowest();
+  float spacing = std::numeric_limits<float>::max();
+  for(int layer = 0; layer < m_FileList.size(); layer++)
+  {
+    const QString& filePath = m_FileList[layer];
+    QFileInfo fi(filePath);
+    if(!fi.exists())
+    {
+      QString ss = QObject::tr("The input file does not exist: '%1'").arg(filePath);
+      setErrorCondition(-388, ss);
+      return;
+    }
+
+    MicReader reader;
+    reader.setFileName(filePath);
+    int err = reader.readHeaderOnly();
+    if(err < 0)
+    {
+      setErrorCondition(err, reader.getErrorMessage());
+      setErrorCondition(getErrorCode(), QObject::tr("MicReader could not read the header of '%1'").arg(filePath));
+      return;
+    }
+    float edgeLength = reader.getEdgeLength();
+    xMin = std::min(xMin, reader.getXOrigin());
+    yMin = std::min(yMin, reader.getYOrigin());
+    xMax = std::max(xMax, reader.getXOrigin() + edgeLength * static_cast<float>(reader.getXDimension() - 1));
+    yMax = std::max(yMax, reader.getYOrigin() + edgeLength * static_cast<float>(reader.getYDimension() - 1));
+    spacing = std::min(spacing, edgeLength);
+    if(layer == 0)
+    {
+      m_Phases = reader.getPhaseVector();
+    }
+    else if(!SamePhases(m_Phases, reader.getPhaseVector()))
+    {
+      QString ss = QObject::tr("The phases of layer %1 '%2' differ from the phases of the first layer '%3'. All the layers must have the same .config and .dat files.")
+                       .arg(layer)
+                       .arg(filePath)
+                       .arg(m_FileList[0]);
+      setErrorCondition(-393, ss);
+      return;
+    }
+  }
+  m_Spacing = spacing;
+  m_XOrigin = xMin;
+  m_YOrigin = yMin;
+  // An extent is rarely a multiple of the spacing, so the grid is rounded up to reach the far
+  // edge of every layer. The rounding error of an extent that is a multiple does not add a point.
+  m_XPoints = static_cast<int>(std::ceil((xMax - xMin) / spacing - 0.001f)) + 1;
+  m_YPoints = static_cast<int>(std::ceil((yMax - yMin) / spacing - 0.001f)) + 1;
+
+  // The .mic files are in millimeters and the volume in microns
+  image->setDimensions(m_XPoints, m_YPoints, m_FileList.size());
+  image->setSpacing(FloatVec3Type(spacing * 1000.0f, spacing * 1000.0f, m_ZSpacing));
+  image->setOrigin(FloatVec3Type(xMin * 1000.0f, yMin * 1000.0f, 0.0f));
+
+  QVector<size_t> tDims(3, 0);
+  tDims[0] = m_XPoints;
+  tDims[1] = m_YPoints;
+  tDims[2] = m_FileList.size();
+  m->createNonPrereqAttributeMatrix(this, getCellAttributeMatrixName(), tDims, AttributeMatrix::Type::Cell, AttributeMatrixID21);
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+  tDims.resize(1);
+  tDims[0] = m_Phases.size() + 1;
+  AttributeMatrix::Pointer cellEnsembleAttrMat = m->createNonPrereqAttributeMatrix(this, getCellEnsembleAttributeMatrixName(), tDims, AttributeMatrix::Type::CellEnsemble, AttributeMatrixID22);
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  // The compact arrays have names of their own so that filters that expect the float arrays do not find the codes
+  m_CellEulerAngles = nullptr;
+  m_CellConfidence = nullptr;
+  m_CellCompactEulerAngles = nullptr;
+  m_CellCompactConfidence = nullptr;
+  QVector<size_t> dim(1, 3);
+  if(m_UseCompactArrays)
+  {
+    tempPath.update(getDataContainerName().getDataContainerName(), getCellAttributeMatrixName(), Mic::CompactEulerAngles);
+    m_CellCompactEulerAnglesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<uint16_t>, AbstractFilter, uint16_t>(
+        this, tempPath, 0, dim, "", DataArrayID31);     /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if(nullptr != m_CellCompactEulerAnglesPtr.lock())   /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    {
+      m_CellCompactEulerAngles = m_CellCompactEulerAnglesPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+  }
+  else
+  {
+    tempPath.update(getDataContainerName().getDataContainerName(), getCellAttributeMatrixName(), getCellEulerAnglesArrayName());
+    m_CellEulerAnglesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(
+        this, tempPath, 0, dim, "", DataArrayID31);  /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if(nullptr != m_CellEulerAnglesPtr.lock())       /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    {
+      m_CellEulerAngles = m_CellEulerAnglesPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+  }
+  dim[0] = 1;
+  tempPath.update(getDataContainerName().getDataContainerName(), getCellAttributeMatrixName(), getCellPhasesArrayName());
+  m_CellPhasesPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter, int32_t>(
+      this, tempPath, 0, dim, "", DataArrayID32); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_CellPhasesPtr.lock())           /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_CellPhases = m_CellPhasesPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+  if(m_UseCompactArrays)
+  {
+    tempPath.update(getDataContainerName().getDataContainerName(), getCellAttributeMatrixName(), Mic::CompactConfidence);
+    m_CellCompactConfidencePtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<uint8_t>, AbstractFilter, uint8_t>(
+        this, tempPath, 0, dim, "", DataArrayID33);  /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if(nullptr != m_CellCompactConfidencePtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    {
+      m_CellCompactConfidence = m_CellCompactConfidencePtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+  }
+  else
+  {
+    tempPath.update(getDataContainerName().getDataContainerName(), getCellAttributeMatrixName(), getCellConfidenceArrayName());
+    m_CellConfidencePtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(
+        this, tempPath, 0, dim, "", DataArrayID33); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if(nullptr != m_CellConfidencePtr.lock())       /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    {
+      m_CellConfidence = m_CellConfidencePtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+  }
+
+  tempPath.update(getDataContainerName().getDataContainerName(), getCellEnsembleAttributeMatrixName(), getCrystalStructuresArrayName());
+  m_CrystalStructuresPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<uint32_t>, AbstractFilter, uint32_t>(this, tempPath, Ebsd::CrystalStructure::UnknownCrystalStructure, dim,
+                                                                                                                                "", DataArrayID34);
+  if(nullptr != m_CrystalStructuresPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_CrystalStructures = m_CrystalStructuresPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+  dim[0] = 6;
+  tempPath.update(getDataContainerName().getDataContainerName(), getCellEnsembleAttributeMatrixName(), getLatticeConstantsArrayName());
+  m_LatticeConstantsPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<float>, AbstractFilter, float>(
+      this, tempPath, 0.0, dim, "", DataArrayID35); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_LatticeConstantsPtr.lock())       /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_LatticeConstants = m_LatticeConstantsPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+
+  StringDataArray::Pointer materialNames = StringDataArray::CreateArray(cellEnsembleAttrMat->getNumberOfTuples(), getMaterialNameArrayName());
+  cellEnsembleAttrMat->insertOrAssign(materialNames);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadMicStack::preflight()
+{
+  setInPreflight(true);
+  emit preflightAboutToExecute();
+  emit updateFilterParameters(this);
+  dataCheck();
+  emit preflightExecuted();
+  setInPreflight(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadMicStack::execute()
+{
+  clearErrorCode();
+  clearWarningCode();
+
+  dataCheck();
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  size_t numLayers = static_cast<size_t>(m_FileList.size());
+  m_LayerErrorCodes.assign(numLayers, 0);
+  m_LayerErrorMessages.assign(numLayers, QString());
+
+  notifyStatusMessage(QObject::tr("Reading %1 layers").arg(numLayers));
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::task_scheduler_init init;
+  bool doParallel = true;
+  if(doParallel)
+  {
+    // Ranges of several layers let each thread reuse its reader. Every thread still gets a few ranges to balance the load.
+    size_t grainSize = std::max(static_cast<size_t>(1), numLayers / (4 * static_cast<size_t>(tbb::task_scheduler_init::default_num_threads())));
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numLayers, grainSize), ReadMicLayersImpl(this), tbb::simple_partitioner());
+  }
+  else
+#endif
+  {
+    MicReader reader;
+    reader.setUseHugePages(true);
+    for(size_t layer = 0; layer < numLayers && !getCancel(); layer++)
+    {
+      readLayer(layer, reader);
+    }
+  }
+  if(getCancel())
+  {
+    return;
+  }
+
+  for(size_t layer = 0; layer < numLayers; layer++)
+  {
+    if(m_LayerErrorCodes[layer] < 0)
+    {
+      setErrorCondition(m_LayerErrorCodes[layer], m_LayerErrorMessages[layer]);
+      return;
+    }
+  }
+
+  loadMaterialInfo();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ReadMicStack::readLayer(size_t layer, MicReader& reader)
+{
+  size_t sliceSize = static_cast<size_t>(m_XPoints) * static_cast<size_t>(m_YPoints);
+  size_t offset = layer * sliceSize;
+
+  MicGridTarget target;
+  target.xDim = m_XPoints;
+  target.yDim = m_YPoints;
+  target.spacing = m_Spacing;
+  target.xOrigin = m_XOrigin;
+  target.yOrigin = m_YOrigin;
+  target.phases = m_CellPhases + offset;
+  if(m_UseCompactArrays)
+  {
+    target.compactEulerAngles = m_CellCompactEulerAngles + 3 * offset;
+    target.compactConfidences = m_CellCompactConfidence + offset;
+  }
+  else
+  {
+    target.eulerAngles = m_CellEulerAngles + 3 * offset;
+    target.confidences = m_CellConfidence + offset;
+  }
+
+  reader.setFileName(m_FileList[static_cast<int>(layer)]);
+  reader.setGridTarget(&target);
+  reader.readAllArrays(false);
+  reader.setArraysToRead(QSet<QString>({Mic::Euler1, Mic::Euler2, Mic::Euler3, Mic::Phase, Mic::Confidence}));
+  int err = reader.readFile();
+  if(err < 0)
+  {
+    m_LayerErrorCodes[layer] = err;
+    m_LayerErrorMessages[layer] = QObject::tr("Layer %1 '%2': %3").arg(layer).arg(m_FileList[static_cast<int>(layer)]).arg(reader.getErrorMessage());
+    return err;
+  }
+
+  // Grid points outside of the triangles are assigned to the first phase, the same as ReadMicData does
+  int32_t* phases = m_CellPhases + offset;
+  for(size_t i = 0; i < sliceSize; i++)
+  {
+    if(phases[i] < 1)
+    {
+      phases[i] = 1;
+    }
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadMicStack::loadMaterialInfo()
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+  AttributeMatrix::Pointer cellEnsembleAttrMat = m->getAttributeMatrix(getCellEnsembleAttributeMatrixName());
+  StringDataArray::Pointer materialNames = cellEnsembleAttrMat->getAttributeArrayAs<StringDataArray>(getMaterialNameArrayName());
+
+  // Initialize the zero'th element to unknowns. The other elements will
+  // be filled in based on values from the first layer
+  m_CrystalStructures[0] = Ebsd::CrystalStructure::UnknownCrystalStructure;
+  materialNames->setValue(0, "Invalid Phase");
+  std::fill(m_LatticeConstants, m_LatticeConstants + 6, 0.0f);
+
+  for(int i = 0; i < m_Phases.size(); i++)
+  {
+    int phaseID = m_Phases[i]->getPhaseIndex();
+    m_CrystalStructures[phaseID] = m_Phases[i]->determineLaueGroup();
+    materialNames->setValue(phaseID, m_Phases[i]->getMaterialName());
+    // The phase of the .config file has no lattice constants, the one of the .dat file that follows it has
+    QVector<float> lc = m_Phases[i]->getLatticeConstants();
+    for(int c = 0; c < lc.size() && c < 6; c++)
+    {
+      m_LatticeConstants[6 * phaseID + c] = lc[c];
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer ReadMicStack::newFilterInstance(bool copyFilterParameters) const
+{
+  ReadMicStack::Pointer filter = ReadMicStack::New();
+  if(copyFilterParameters)
+  {
+    filter->setFilterParameters(getFilterParameters());
+    copyFilterParameterInstanceVariables(filter.get());
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString ReadMicStack::getCompiledLibraryName() const
+{
+  return HEDMAnalysisConstants::HEDMAnalysisBaseName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString ReadMicStack::getGroupName() const
+{
+  return SIMPL::FilterGroups::Unsupported;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QUuid ReadMicStack::getUuid()
+{
+  return QUuid("{3d6b7872-0df5-5cab-8db0-079ae686531e}");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString ReadMicStack::getSubGroupName() const
+{
+  return SIMPL::FilterSubGroups::InputFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString ReadMicStack::getHumanLabel() const
+{
+  return "Import HEDM Stack (.mic)";
+}
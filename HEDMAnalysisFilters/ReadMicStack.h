@@ -0,0 +1,228 @@
+/* ============================================================================
+* Copyright (c) 2012 Michael A. Jackson (BlueQuartz Software)
+* Copyright (c) 2012 Dr. Michael A. Groeber (US Air Force Research Laboratories)
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of Michael A. Groeber, Michael A. Jackson, the US Air Force,
+* BlueQuartz Software nor the names of its contributors may be used to endorse
+* or promote products derived from this software without specific prior written
+* permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+*  This code was written under United States Air Force Contract number
+*                           FA8650-07-D-5800
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#pragma once
+
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/FilterParameters/FileListInfoFilterParameter.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/SIMPLib.h"
+
+#include "HEDMAnalysisFilters/HEDM/MicPhase.h"
+
+#include "HEDMAnalysis/HEDMAnalysisConstants.h"
+
+class MicReader;
+
+#include "HEDMAnalysis/HEDMAnalysisDLLExport.h"
+
+/**
+ * @class ReadMicStack ReadMicStack.h HEDMAnalysisFilters/ReadMicStack.h
+ * @brief Reads a stack of HEDM .mic files, one per layer of the sample, into a single
+ * 3D Image Geometry. All the layers are resampled onto one XY grid that covers every
+ * layer. The layers are read on separate threads and each one is resampled straight
+ * into its slice of the cell arrays.
+ * @date Oct 2026
+ * @version 1.0
+ */
+class HEDMAnalysis_EXPORT ReadMicStack : public AbstractFilter
+{
+    Q_OBJECT
+    PYB11_CREATE_BINDINGS(ReadMicStack SUPERCLASS AbstractFilter)
+    PYB11_PROPERTY(FileListInfo_t InputFileListInfo READ getInputFileListInfo WRITE setInputFileListInfo)
+    PYB11_PROPERTY(float ZSpacing READ getZSpacing WRITE setZSpacing)
+    PYB11_PROPERTY(bool UseCompactArrays READ getUseCompactArrays WRITE setUseCompactArrays)
+    PYB11_PROPERTY(DataArrayPath DataContainerName READ getDataContainerName WRITE setDataContainerName)
+    PYB11_PROPERTY(QString CellAttributeMatrixName READ getCellAttributeMatrixName WRITE setCellAttributeMatrixName)
+    PYB11_PROPERTY(QString CellEnsembleAttributeMatrixName READ getCellEnsembleAttributeMatrixName WRITE setCellEnsembleAttributeMatrixName)
+
+  public:
+    SIMPL_SHARED_POINTERS(ReadMicStack)
+    SIMPL_FILTER_NEW_MACRO(ReadMicStack)
+    SIMPL_TYPE_MACRO_SUPER_OVERRIDE(ReadMicStack, AbstractFilter)
+
+    ~ReadMicStack() override;
+
+    SIMPL_FILTER_PARAMETER(FileListInfo_t, InputFileListInfo)
+    Q_PROPERTY(FileListInfo_t InputFileListInfo READ getInputFileListInfo WRITE setInputFileListInfo)
+
+    SIMPL_FILTER_PARAMETER(float, ZSpacing)
+    Q_PROPERTY(float ZSpacing READ getZSpacing WRITE setZSpacing)
+
+    /**
+     * @brief When true the Euler angles are stored as 16 bit and the confidence as 8 bit
+     * MicCompactCodec codes in the Mic::CompactEulerAngles and Mic::CompactConfidence
+     * arrays instead of the float arrays
+     */
+    SIMPL_FILTER_PARAMETER(bool, UseCompactArrays)
+    Q_PROPERTY(bool UseCompactArrays READ getUseCompactArrays WRITE setUseCompactArrays)
+
+    SIMPL_FILTER_PARAMETER(DataArrayPath, DataContainerName)
+    Q_PROPERTY(DataArrayPath DataContainerName READ getDataContainerName WRITE setDataContainerName)
+
+    SIMPL_FILTER_PARAMETER(QString, CellAttributeMatrixName)
+    Q_PROPERTY(QString CellAttributeMatrixName READ getCellAttributeMatrixName WRITE setCellAttributeMatrixName)
+
+    SIMPL_FILTER_PARAMETER(QString, CellEnsembleAttributeMatrixName)
+    Q_PROPERTY(QString CellEnsembleAttributeMatrixName READ getCellEnsembleAttributeMatrixName WRITE setCellEnsembleAttributeMatrixName)
+
+    SIMPL_INSTANCE_PROPERTY(QString, CellEulerAnglesArrayName)
+    SIMPL_INSTANCE_PROPERTY(QString, CellPhasesArrayName)
+    SIMPL_INSTANCE_PROPERTY(QString, CellConfidenceArrayName)
+    SIMPL_INSTANCE_PROPERTY(QString, CrystalStructuresArrayName)
+    SIMPL_INSTANCE_PROPERTY(QString, LatticeConstantsArrayName)
+    SIMPL_INSTANCE_PROPERTY(QString, MaterialNameArrayName)
+
+    /**
+     * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
+     */
+    const QString getCompiledLibraryName() const override;
+
+    /**
+     * @brief newFilterInstance Reimplemented from @see AbstractFilter class
+     */
+    AbstractFilter::Pointer newFilterInstance(bool copyFilterParameters) const override;
+
+    /**
+     * @brief getGroupName Reimplemented from @see AbstractFilter class
+     */
+    const QString getGroupName() const override;
+
+    /**
+     * @brief getSubGroupName Reimplemented from @see AbstractFilter class
+     */
+    const QString getSubGroupName() const override;
+
+    /**
+     * @brief getUuid Return the unique identifier for this filter.
+     * @return A QUuid object.
+     */
+    const QUuid getUuid() override;
+
+    /**
+     * @brief getHumanLabel Reimplemented from @see AbstractFilter class
+     */
+    const QString getHumanLabel() const override;
+
+    /**
+     * @brief setupFilterParameters Reimplemented from @see AbstractFilter class
+     */
+    void setupFilterParameters() override;
+
+    /**
+     * @brief readFilterParameters Reimplemented from @see AbstractFilter class
+     */
+    void readFilterParameters(AbstractFilterParametersReader* reader, int index) override;
+
+    /**
+     * @brief execute Reimplemented from @see AbstractFilter class
+     */
+    void execute() override;
+
+    /**
+     * @brief preflight Reimplemented from @see AbstractFilter class
+     */
+    void preflight() override;
+
+  signals:
+    void updateFilterParameters(AbstractFilter* filter);
+    void parametersChanged();
+    void preflightAboutToExecute();
+    void preflightExecuted();
+
+  protected:
+    ReadMicStack();
+
+    /**
+     * @brief dataCheck Reads the headers of all the layers to find the grid and checks
+     * for the appropriate parameter values and availability of arrays
+     */
+    void dataCheck();
+
+    /**
+     * @brief Initializes all the private instance variables.
+     */
+    void initialize();
+
+    /**
+     * @brief Reads one layer into its slice of the cell arrays. This is called from
+     * several threads at once for different layers.
+     * @param layer The index of the layer, which is its Z index
+     * @param reader The reader of the calling thread, reused from layer to layer
+     * @return Zero/Positive on Success - Negative on error.
+     */
+    int readLayer(size_t layer, MicReader& reader);
+
+    /**
+     * @brief Fills the ensemble arrays from the phases of the first layer, which dataCheck()
+     * made sure every layer shares
+     */
+    void loadMaterialInfo();
+
+    friend class ReadMicLayersImpl;
+
+  private:
+    // The grid in the units of the .mic files that every layer is resampled onto
+    int m_XPoints = 0;
+    int m_YPoints = 0;
+    float m_Spacing = 0.0f;
+    float m_XOrigin = 0.0f;
+    float m_YOrigin = 0.0f;
+
+    QVector<QString> m_FileList;
+    QVector<MicPhase::Pointer> m_Phases;
+    std::vector<int> m_LayerErrorCodes;
+    std::vector<QString> m_LayerErrorMessages;
+
+    DEFINE_DATAARRAY_VARIABLE(float, CellEulerAngles)
+    DEFINE_DATAARRAY_VARIABLE(int32_t, CellPhases)
+    DEFINE_DATAARRAY_VARIABLE(float, CellConfidence)
+    DEFINE_DATAARRAY_VARIABLE(uint16_t, CellCompactEulerAngles)
+    DEFINE_DATAARRAY_VARIABLE(uint8_t, CellCompactConfidence)
+    DEFINE_DATAARRAY_VARIABLE(uint32_t, CrystalStructures)
+    DEFINE_DATAARRAY_VARIABLE(float, LatticeConstants)
+
+  public:
+    ReadMicStack(const ReadMicStack&) = delete;            // Copy Constructor Not Implemented
+    ReadMicStack(ReadMicStack&&) = delete;                 // Move Constructor Not Implemented
+    ReadMicStack& operator=(const ReadMicStack&) = delete; // Copy Assignment Not Implemented
+    ReadMicStack& operator=(ReadMicStack&&) = delete;      // Move Assignment Not Implemented
+};
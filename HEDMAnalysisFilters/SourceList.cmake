@@ -19,6 +19,7 @@ SIMPL_START_FILTER_GROUP(
 # List your public filters here
 set(_PublicFilters
   ReadMicData
+  ReadMicStack
   TesselateFarFieldGrains
 )
 
@@ -59,12 +60,30 @@ ADD_SIMPL_SUPPORT_HEADER(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/H5M
 ADD_SIMPL_SUPPORT_SOURCE(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/H5MicReader.cpp)
 ADD_SIMPL_SUPPORT_HEADER(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/H5MicVolumeReader.h)
 ADD_SIMPL_SUPPORT_SOURCE(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/H5MicVolumeReader.cpp)
+ADD_SIMPL_SUPPORT_HEADER(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicCacheFile.h)
+ADD_SIMPL_SUPPORT_SOURCE(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicCacheFile.cpp)
+ADD_SIMPL_SUPPORT_HEADER(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicColumnArena.h)
+ADD_SIMPL_SUPPORT_SOURCE(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicColumnArena.cpp)
+ADD_SIMPL_SUPPORT_HEADER(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicCompactCodec.h)
+ADD_SIMPL_SUPPORT_SOURCE(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicCompactCodec.cpp)
+ADD_SIMPL_SUPPORT_HEADER(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicCoverageMap.h)
+ADD_SIMPL_SUPPORT_SOURCE(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicCoverageMap.cpp)
+ADD_SIMPL_SUPPORT_HEADER(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicDataParser.h)
+ADD_SIMPL_SUPPORT_SOURCE(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicDataParser.cpp)
 ADD_SIMPL_SUPPORT_HEADER(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicFields.h)
 ADD_SIMPL_SUPPORT_SOURCE(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicFields.cpp)
+ADD_SIMPL_SUPPORT_HEADER(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicLattice.h)
+ADD_SIMPL_SUPPORT_SOURCE(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicLattice.cpp)
 ADD_SIMPL_SUPPORT_HEADER(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicPhase.h)
 ADD_SIMPL_SUPPORT_SOURCE(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicPhase.cpp)
 ADD_SIMPL_SUPPORT_HEADER(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicReader.h)
 ADD_SIMPL_SUPPORT_SOURCE(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicReader.cpp)
+ADD_SIMPL_SUPPORT_HEADER(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicReaderCache.h)
+ADD_SIMPL_SUPPORT_SOURCE(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicReaderCache.cpp)
+ADD_SIMPL_SUPPORT_HEADER(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicTriangleMesh.h)
+ADD_SIMPL_SUPPORT_SOURCE(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicTriangleMesh.cpp)
+ADD_SIMPL_SUPPORT_HEADER(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicTriangleRasterizer.h)
+ADD_SIMPL_SUPPORT_SOURCE(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicTriangleRasterizer.cpp)
 ADD_SIMPL_SUPPORT_HEADER(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicHeaderEntry.h)
 ADD_SIMPL_SUPPORT_HEADER(${HEDMAnalysis_SOURCE_DIR} ${_filterGroupName} HEDM/MicConstants.h)
 
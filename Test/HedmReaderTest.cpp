@@ -34,11 +34,43 @@
 
 #include <string.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+
+#include "H5Support/QH5Utilities.h"
+
+#include "HEDMAnalysisFilters/HEDM/H5MicImporter.h"
+#include "HEDMAnalysisFilters/HEDM/H5MicReader.h"
+#include "HEDMAnalysisFilters/HEDM/H5MicVolumeReader.h"
+#include "HEDMAnalysisFilters/HEDM/MicCacheFile.h"
+#include "HEDMAnalysisFilters/HEDM/MicColumnArena.h"
+#include "HEDMAnalysisFilters/HEDM/MicCompactCodec.h"
+#include "HEDMAnalysisFilters/HEDM/MicCoverageMap.h"
+#include "HEDMAnalysisFilters/HEDM/MicDataParser.h"
+#include "HEDMAnalysisFilters/HEDM/MicLattice.h"
 #include "HEDMAnalysisFilters/HEDM/MicReader.h"
+#include "HEDMAnalysisFilters/HEDM/MicReaderCache.h"
+#include "HEDMAnalysisFilters/HEDM/MicTriangleMesh.h"
+#include "HEDMAnalysisFilters/HEDM/MicTriangleRasterizer.h"
+#include "HEDMAnalysisFilters/ReadMicData.h"
+#include "HEDMAnalysisFilters/ReadMicStack.h"
+
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "UnitTestSupport.hpp"
 
-#include "EbsdLib/Test/EbsdLibTestFileLocation.h"
+#include "HEDMAnalysisTestFileLocations.h"
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -59,12 +91,2147 @@ void TestHedmReader()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int main(int argc, char** argv)
+void RemoveMicFile(const QString& micFile)
+{
+  QString basePath = micFile.left(micFile.size() - 4);
+  QFile::remove(micFile);
+  QFile::remove(basePath + ".config");
+  QFile::remove(basePath + ".dat");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicConfigHeader()
+{
+  QString basePath = UnitTest::HedmReaderTest::MicFile.left(UnitTest::HedmReaderTest::MicFile.size() - 4);
+  QString micFile = UnitTest::TestTempDir + "/HedmConfigTest.mic";
+  QString configBasePath = micFile.left(micFile.size() - 4);
+  QFile::remove(micFile);
+  QFile::remove(configBasePath + ".dat");
+  DREAM3D_REQUIRE(QFile::copy(UnitTest::HedmReaderTest::MicFile, micFile));
+  DREAM3D_REQUIRE(QFile::copy(basePath + ".dat", configBasePath + ".dat"));
+
+  // Int, float and string keys, a key that only starts like a known key, an unknown key,
+  // a comment and a Windows line ending
+  QFile config(configBasePath + ".config");
+  DREAM3D_REQUIRE(config.open(QIODevice::WriteOnly));
+  config.write("# A comment line with a known key: MaxQ 99\n"
+               "MaxQ 12\n"
+               "MaxQExtra 99\n"
+               "NotAMicKey 1.5\n"
+               "BeamEnergy\t71.5\n"
+               "MinSideLength   0.25\r\n"
+               "SampleSymmetry   Cubic  \n"
+               "BeamDirection 1 0  0\r\n"
+               "NumDetectors -3\n");
+  config.close();
+
+  MicReader reader;
+  reader.setFileName(micFile);
+  int err = reader.readHeaderOnly();
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE_EQUAL(reader.getMaxQ(), 12);
+  DREAM3D_REQUIRE_EQUAL(reader.getNumDetectors(), -3);
+  DREAM3D_REQUIRE_EQUAL(reader.getBeamEnergy(), 71.5f);
+  DREAM3D_REQUIRE_EQUAL(reader.getMinSideLength(), 0.25f);
+  DREAM3D_REQUIRE(reader.getSampleSymmetry() == QString("Cubic"));
+  DREAM3D_REQUIRE(reader.getBeamDirection() == QString("1 0 0"));
+
+  // Keys that are not in the file keep their default values
+  DREAM3D_REQUIRE_EQUAL(reader.getEtaLimit(), 0);
+  DREAM3D_REQUIRE_EQUAL(reader.getBeamHeight(), 0.0f);
+  DREAM3D_REQUIRE(reader.getStructureFilename().isEmpty());
+
+  RemoveMicFile(micFile);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicDataParser()
+{
+  const char* rows[] = {"-0.0937500 0.1623798 0.0000000 1 8 1 130.470001 36.2811 286.559998 0.862069 0.0 0.0 0.0 0 0 0 0 0 0",
+                        "  1.5e-3\t-7.038531e-26 1e 2 -3 +4 0.1 0.2 0.3 1.00000005960464477539062 nan -inf 3.4028235e38 1 2 3 4 5 6\r",
+                        "0.5 0.25 0.125 1 2"};
+  for(const char* row : rows)
+  {
+    float fExpected[10] = {0.0f};
+    int iExpected[9] = {0};
+    int numRead = sscanf(row, "%f %f %f %d %d %d %f %f %f %f %f %f %f %d %d %d %d %d %d", &fExpected[0], &fExpected[1], &fExpected[2], &iExpected[0], &iExpected[1], &iExpected[2], &fExpected[3],
+                         &fExpected[4], &fExpected[5], &fExpected[6], &fExpected[7], &fExpected[8], &fExpected[9], &iExpected[3], &iExpected[4], &iExpected[5], &iExpected[6], &iExpected[7],
+                         &iExpected[8]);
+
+    float fValues[10] = {0.0f};
+    int iValues[9] = {0};
+    const char* ptr = row;
+    const char* end = row + strlen(row);
+    const char* columnTypes = "fffiiifffffffiiiiii";
+    int fIndex = 0;
+    int iIndex = 0;
+    int numParsed = 0;
+    for(const char* type = columnTypes; *type != '\0'; ++type)
+    {
+      bool ok = (*type == 'f') ? MicDataParser::scanFloat(ptr, end, fValues[fIndex++]) : MicDataParser::scanInt(ptr, end, iValues[iIndex++]);
+      if(!ok)
+      {
+        break;
+      }
+      numParsed++;
+    }
+    DREAM3D_REQUIRE_EQUAL(numParsed, numRead);
+    // Compare the bit patterns so that nan values compare equal
+    DREAM3D_REQUIRE(::memcmp(fValues, fExpected, sizeof(fValues)) == 0);
+    DREAM3D_REQUIRE(::memcmp(iValues, iExpected, sizeof(iValues)) == 0);
+  }
+
+  // Splitting the rows into chunks must not change which rows are found
+  const char* body = "1 2 3\n\n4 5 6\r\n   \n7 8 9\n10 11 12";
+  const char* bodyEnd = body + strlen(body);
+  DREAM3D_REQUIRE_EQUAL(MicDataParser::countRows(body, bodyEnd), 4);
+  for(size_t numChunks = 1; numChunks < 12; numChunks++)
+  {
+    std::vector<const char*> boundaries = MicDataParser::findChunkBoundaries(body, bodyEnd, numChunks);
+    DREAM3D_REQUIRE(boundaries.front() == body);
+    DREAM3D_REQUIRE(boundaries.back() == bodyEnd);
+    size_t numRows = 0;
+    for(size_t i = 0; i + 1 < boundaries.size(); i++)
+    {
+      DREAM3D_REQUIRE(boundaries[i] == body || boundaries[i][-1] == '\n');
+      numRows += MicDataParser::countRows(boundaries[i], boundaries[i + 1]);
+    }
+    DREAM3D_REQUIRE_EQUAL(numRows, 4);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicTriangleRasterizer()
+{
+  // One up and one down triangle that share the edge from (1, 0) to (0.5, h)
+  const float h = sqrtf(3.0f) / 2.0f;
+  std::vector<float> triX = {0.0f, 0.5f};
+  std::vector<float> triY = {0.0f, h};
+  std::vector<int> triUp = {1, 2};
+
+  // Sample every 0.1 so the points on the shared edge and the horizontal edges are hit
+  const int xDim = 31;
+  const int yDim = 12;
+  MicTriangleRasterizer rasterizer(xDim, yDim, 0.1f, -0.4f, -0.2f);
+  std::vector<int> owners(xDim * yDim);
+  rasterizer.rasterize(triX.data(), triY.data(), triUp.data(), triX.size(), 1.0f, owners.data());
+  for(int k = 0; k < yDim; k++)
+  {
+    for(int j = 0; j < xDim; j++)
+    {
+      float x = -0.4f + 0.1f * j;
+      float y = -0.2f + 0.1f * k;
+      int expected = -1;
+      if(y >= 0.0f && y < h)
+      {
+        float inset = y / sqrtf(3.0f);
+        if(x >= inset && x < 1.0f - inset)
+        {
+          expected = 0;
+        }
+        else if(x >= 1.0f - inset && x < 1.0f + inset)
+        {
+          expected = 1;
+        }
+      }
+      // Points within rounding distance of an edge may go either way
+      float d = std::min({std::fabs(y), std::fabs(y - h), std::fabs(x - y / sqrtf(3.0f)), std::fabs(x - (1.0f - y / sqrtf(3.0f))), std::fabs(x - (1.0f + y / sqrtf(3.0f)))});
+      if(d > 1.0e-4f)
+      {
+        DREAM3D_REQUIRE_EQUAL(owners[k * xDim + j], expected);
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicCoverageMap()
+{
+  // Two layers on one lattice with edge length 1. The second one lacks the bottom row, the
+  // left columns and a triangle in the middle, so its MicLattice has another origin.
+  const float h = sqrtf(3.0f) / 2.0f;
+  std::vector<float> layerX[2];
+  std::vector<float> layerY[2];
+  std::vector<int> layerUp[2];
+  for(int row = 0; row < 3; row++)
+  {
+    for(int column = 0; column < 6; column++)
+    {
+      bool up = ((row + column) % 2) == 0;
+      for(int layer = 0; layer < 2; layer++)
+      {
+        if(layer == 1 && (row == 0 || column < 2 || (row == 1 && column == 3)))
+        {
+          continue;
+        }
+        layerX[layer].push_back(0.5f * column);
+        layerY[layer].push_back(static_cast<float>(up ? row : row + 1) * h);
+        layerUp[layer].push_back(up ? 1 : 2);
+      }
+    }
+  }
+  MicLattice lattices[2];
+  for(int layer = 0; layer < 2; layer++)
+  {
+    DREAM3D_REQUIRE(lattices[layer].build(layerX[layer].data(), layerY[layer].data(), layerUp[layer].data(), layerX[layer].size(), 1.0f));
+  }
+
+  // Both layers get the same map
+  const int xDim = 37;
+  const int yDim = 29;
+  MicCoverageMap::ClearCache();
+  MicCoverageMap::Pointer first = MicCoverageMap::Get(xDim, yDim, 0.1f, -0.43f, -0.21f, lattices[0], 0, false);
+  MicCoverageMap::Pointer second = MicCoverageMap::Get(xDim, yDim, 0.1f, -0.43f, -0.21f, lattices[1], 0, true);
+  DREAM3D_REQUIRE(first == second);
+  DREAM3D_REQUIRE(first->getNumberOfSpans() < static_cast<size_t>(xDim * yDim));
+
+  // Each layer gets the triangles that rasterizing the layer on its own finds
+  for(int layer = 0; layer < 2; layer++)
+  {
+    std::vector<int> owners(xDim * yDim);
+    std::vector<int> expected(xDim * yDim);
+    DREAM3D_REQUIRE(first->findOwners(lattices[layer], owners.data()));
+    MicTriangleRasterizer rasterizer(xDim, yDim, 0.1f, -0.43f, -0.21f);
+    rasterizer.rasterize(layerX[layer].data(), layerY[layer].data(), layerUp[layer].data(), layerX[layer].size(), 1.0f, expected.data());
+    size_t numCovered = 0;
+    for(size_t point = 0; point < owners.size(); point++)
+    {
+      DREAM3D_REQUIRE_EQUAL(owners[point], expected[point]);
+      numCovered += (expected[point] >= 0) ? 1 : 0;
+    }
+    DREAM3D_REQUIRE(numCovered > 0);
+  }
+
+  // Another grid or level needs its own map
+  DREAM3D_REQUIRE(MicCoverageMap::Get(xDim, yDim, 0.1f, -0.33f, -0.21f, lattices[0], 0, false) != first);
+  DREAM3D_REQUIRE(MicCoverageMap::Get(xDim, yDim, 0.1f, -0.43f, -0.21f, lattices[0], 1, false) != first);
+
+  // So does a lattice that is moved by less than a cell or by half an edge, which swaps up and down triangles
+  for(float shift : {0.25f, 0.5f})
+  {
+    std::vector<float> shiftedX = layerX[0];
+    for(float& x : shiftedX)
+    {
+      x += shift;
+    }
+    MicLattice shifted;
+    DREAM3D_REQUIRE(shifted.build(shiftedX.data(), layerY[0].data(), layerUp[0].data(), shiftedX.size(), 1.0f));
+    std::vector<int> owners(xDim * yDim, 0);
+    DREAM3D_REQUIRE(!first->findOwners(shifted, owners.data()));
+    DREAM3D_REQUIRE(std::count(owners.begin(), owners.end(), -1) == xDim * yDim);
+    DREAM3D_REQUIRE(MicCoverageMap::Get(xDim, yDim, 0.1f, -0.43f, -0.21f, shifted, 0, false) != first);
+  }
+  MicCoverageMap::ClearCache();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicColumnArena()
+{
+  MicColumnArena arena;
+  DREAM3D_REQUIRE(arena.layout(3, 1001, true));
+  for(size_t i = 0; i < 3; i++)
+  {
+    float* column = static_cast<float*>(arena.getColumn(i));
+    DREAM3D_REQUIRE(column != nullptr);
+    DREAM3D_REQUIRE_EQUAL(reinterpret_cast<size_t>(column) % MicColumnArena::k_Alignment, 0);
+    DREAM3D_REQUIRE(std::all_of(column, column + 1001, [](float value) { return value == 0.0f; }));
+    std::fill(column, column + 1001, 1.0f);
+  }
+  DREAM3D_REQUIRE(arena.getColumn(3) == nullptr);
+
+  // A smaller layout reuses the block
+  void* block = arena.getColumn(0);
+  size_t capacity = arena.getCapacity();
+  DREAM3D_REQUIRE(arena.layout(2, 500, true));
+  DREAM3D_REQUIRE(arena.getColumn(0) == block);
+  DREAM3D_REQUIRE_EQUAL(arena.getCapacity(), capacity);
+  DREAM3D_REQUIRE_EQUAL(static_cast<float*>(arena.getColumn(1))[499], 0.0f);
+
+  arena.release();
+  DREAM3D_REQUIRE(arena.getColumn(0) == nullptr);
+  DREAM3D_REQUIRE_EQUAL(arena.getCapacity(), 0);
+
+  // A reader that reads again into its arenas gives the same values as a new reader
+  MicReader reader;
+  reader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  DREAM3D_REQUIRE(reader.readFile() >= 0);
+  reader.setResampleToGrid(false);
+  DREAM3D_REQUIRE(reader.readFile() >= 0);
+  reader.setResampleToGrid(true);
+  DREAM3D_REQUIRE(reader.readFile() >= 0);
+  MicReader newReader;
+  newReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  DREAM3D_REQUIRE(newReader.readFile() >= 0);
+  DREAM3D_REQUIRE_EQUAL(reader.getNumberOfElements(), newReader.getNumberOfElements());
+  size_t numPoints = newReader.getNumberOfElements();
+  DREAM3D_REQUIRE(std::equal(newReader.getEuler1Pointer(), newReader.getEuler1Pointer() + numPoints, reader.getEuler1Pointer()));
+  DREAM3D_REQUIRE(std::equal(newReader.getPhasePointer(), newReader.getPhasePointer() + numPoints, reader.getPhasePointer()));
+  DREAM3D_REQUIRE(std::equal(newReader.getXPointer(), newReader.getXPointer() + numPoints, reader.getXPointer()));
+
+  // Only the grid is kept once the scratch memory is released
+  reader.releaseScratchMemory();
+  DREAM3D_REQUIRE(reader.getDataSize() < newReader.getDataSize());
+  DREAM3D_REQUIRE(std::equal(newReader.getConfidencePointer(), newReader.getConfidencePointer() + numPoints, reader.getConfidencePointer()));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicLattice()
+{
+  // A strip of up, down, up triangles
+  const float h = sqrtf(3.0f) / 2.0f;
+  std::vector<float> triX = {0.0f, 0.5f, 1.0f};
+  std::vector<float> triY = {0.0f, h, 0.0f};
+  std::vector<int> triUp = {1, 2, 1};
+
+  MicLattice lattice;
+  DREAM3D_REQUIRE(lattice.build(triX.data(), triY.data(), triUp.data(), triX.size(), 1.0f));
+  for(size_t i = 0; i < 3; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(lattice.getColumn(i), static_cast<int>(i));
+    DREAM3D_REQUIRE_EQUAL(lattice.getRow(i), 1);
+    DREAM3D_REQUIRE(lattice.isUp(i) == (triUp[i] == 1));
+    float x = 0.0f;
+    float y = 0.0f;
+    lattice.getLeftVertex(i, x, y);
+    DREAM3D_REQUIRE(std::fabs(x - triX[i]) < 1.0e-6f && std::fabs(y - triY[i]) < 1.0e-6f);
+  }
+  qint64 neighbors[3];
+  lattice.findNeighbors(1, neighbors);
+  DREAM3D_REQUIRE(neighbors[0] == 0 && neighbors[1] == 2 && neighbors[2] == MicLattice::k_NoTriangle);
+  lattice.findNeighbors(0, neighbors);
+  DREAM3D_REQUIRE(neighbors[0] == MicLattice::k_NoTriangle && neighbors[1] == 1 && neighbors[2] == MicLattice::k_NoTriangle);
+
+  // The vertices along the common edges are shared
+  MicTriangleMesh mesh;
+  mesh.build(lattice);
+  DREAM3D_REQUIRE_EQUAL(mesh.getNumberOfVertices(), 5);
+  const size_t expected[9] = {0, 1, 2, 2, 1, 3, 1, 4, 3};
+  for(size_t i = 0; i < 9; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(mesh.getTriangles()[i], expected[i]);
+  }
+  const float* vertex = mesh.getVertices() + 3 * 3;
+  DREAM3D_REQUIRE(vertex[0] == 1.5f && std::fabs(vertex[1] - h) < 1.0e-6f && vertex[2] == 0.0f);
+
+  // A triangle that is shifted by a quarter of an edge is not on the lattice
+  triX[1] = 0.75f;
+  DREAM3D_REQUIRE(!lattice.build(triX.data(), triY.data(), triUp.data(), triX.size(), 1.0f));
+
+  // A reader keeps either the lattice or the X and Y columns. The neighbors on the lattice are mutual.
+  MicReader reader;
+  reader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  reader.setResampleToGrid(false);
+  int err = reader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  MicLattice::Pointer fileLattice = reader.getLattice();
+  DREAM3D_REQUIRE(fileLattice.get() != nullptr);
+  DREAM3D_REQUIRE(reader.getXPointer() == nullptr);
+  DREAM3D_REQUIRE_EQUAL(fileLattice->getNumberOfTriangles(), reader.getNumberOfElements());
+  size_t numNeighbors = 0;
+  for(size_t i = 0; i < fileLattice->getNumberOfTriangles(); i++)
+  {
+    fileLattice->findNeighbors(i, neighbors);
+    for(qint64 neighbor : neighbors)
+    {
+      if(neighbor != MicLattice::k_NoTriangle)
+      {
+        numNeighbors++;
+        qint64 back[3];
+        fileLattice->findNeighbors(static_cast<size_t>(neighbor), back);
+        DREAM3D_REQUIRE(back[0] == static_cast<qint64>(i) || back[1] == static_cast<qint64>(i) || back[2] == static_cast<qint64>(i));
+      }
+    }
+  }
+  // The test file is 16 rows of 32 triangles. Each row has 31 inner edges and the 16 down
+  // triangles of a row share their top edge with the row above, every edge counts twice.
+  DREAM3D_REQUIRE_EQUAL(numNeighbors, static_cast<size_t>(2 * (16 * 31 + 15 * 16)));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicColumnProjection()
+{
+  MicReader fullReader;
+  fullReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  fullReader.setResampleToGrid(false);
+  int err = fullReader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE(fullReader.getPointerByName(Mic::Z) == nullptr);
+
+  // Only the named columns are kept, including the ones that are not read by default
+  MicReader reader;
+  reader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  reader.setResampleToGrid(false);
+  reader.readAllArrays(false);
+  reader.setArraysToRead(QSet<QString>({Mic::Euler2, Mic::Z, Mic::Column19}));
+  err = reader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE_EQUAL(reader.getNumberOfElements(), fullReader.getNumberOfElements());
+  DREAM3D_REQUIRE(reader.getEuler1Pointer() == nullptr);
+  DREAM3D_REQUIRE(reader.getConfidencePointer() == nullptr);
+  DREAM3D_REQUIRE(reader.getPhasePointer() == nullptr);
+  DREAM3D_REQUIRE(reader.getPointerByName(Mic::Column11) == nullptr);
+  DREAM3D_REQUIRE(reader.getPointerType(Mic::Z) == Ebsd::Float);
+  DREAM3D_REQUIRE(reader.getPointerType(Mic::Column19) == Ebsd::Int32);
+  DREAM3D_REQUIRE(reader.getPointerByName(Mic::Z) != nullptr);
+  DREAM3D_REQUIRE(reader.getPointerByName(Mic::Column19) != nullptr);
+  for(size_t i = 0; i < reader.getNumberOfElements(); i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(reader.getEuler2Pointer()[i], fullReader.getEuler2Pointer()[i]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicRowFilter()
+{
+  MicReader fullReader;
+  fullReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  fullReader.setResampleToGrid(false);
+  int err = fullReader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  MicLattice::Pointer fullLattice = fullReader.getLattice();
+  DREAM3D_REQUIRE(nullptr != fullLattice.get());
+
+  MicRowFilter filter;
+  filter.useMinConfidence = true;
+  filter.minConfidence = 0.3f;
+  filter.goodOnly = true;
+  filter.useBoundingBox = true;
+  filter.xMin = -0.2f;
+  filter.xMax = 0.2f;
+  filter.yMin = -0.2f;
+  filter.yMax = 0.1f;
+
+  // The kept rows are the rows of the full read that pass every test, in file order
+  MicReader reader;
+  reader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  reader.setResampleToGrid(false);
+  reader.readAllArrays(false);
+  reader.setArraysToRead(QSet<QString>({Mic::Euler1}));
+  reader.setRowFilter(filter);
+  err = reader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE(reader.getConfidencePointer() == nullptr);
+
+  size_t kept = 0;
+  for(size_t i = 0; i < fullReader.getNumberOfElements(); i++)
+  {
+    // The lattice replaced the X and Y columns of the full read
+    float x = 0.0f;
+    float y = 0.0f;
+    fullLattice->getLeftVertex(i, x, y);
+    if(fullReader.getConfidencePointer()[i] < 0.3f || fullReader.getPhasePointer()[i] == 0 || x < -0.2f || x > 0.2f || y < -0.2f || y > 0.1f)
+    {
+      continue;
+    }
+    DREAM3D_REQUIRE(kept < reader.getNumberOfElements());
+    DREAM3D_REQUIRE_EQUAL(reader.getEuler1Pointer()[kept], fullReader.getEuler1Pointer()[i]);
+    kept++;
+  }
+  DREAM3D_REQUIRE(kept > 0 && kept < fullReader.getNumberOfElements());
+  DREAM3D_REQUIRE_EQUAL(reader.getNumberOfElements(), kept);
+
+  // A filter that drops every row is an error
+  filter.minConfidence = 2.0f;
+  reader.setRowFilter(filter);
+  DREAM3D_REQUIRE(reader.readFile() < 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RequireSameMicRead(MicReader& reader, MicReader& serialReader)
+{
+  size_t numElements = serialReader.getNumberOfElements();
+  DREAM3D_REQUIRE_EQUAL(reader.getNumberOfElements(), numElements);
+  DREAM3D_REQUIRE_EQUAL(reader.getXDimension(), serialReader.getXDimension());
+  DREAM3D_REQUIRE_EQUAL(reader.getYDimension(), serialReader.getYDimension());
+  for(size_t i = 0; i < numElements; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(reader.getEuler1Pointer()[i], serialReader.getEuler1Pointer()[i]);
+    DREAM3D_REQUIRE_EQUAL(reader.getEuler2Pointer()[i], serialReader.getEuler2Pointer()[i]);
+    DREAM3D_REQUIRE_EQUAL(reader.getEuler3Pointer()[i], serialReader.getEuler3Pointer()[i]);
+    DREAM3D_REQUIRE_EQUAL(reader.getConfidencePointer()[i], serialReader.getConfidencePointer()[i]);
+    DREAM3D_REQUIRE_EQUAL(reader.getPhasePointer()[i], serialReader.getPhasePointer()[i]);
+  }
+
+  MicLattice::Pointer lattice = reader.getLattice();
+  MicLattice::Pointer serialLattice = serialReader.getLattice();
+  DREAM3D_REQUIRE_EQUAL(lattice.get() == nullptr, serialLattice.get() == nullptr);
+  if(nullptr != serialLattice.get())
+  {
+    DREAM3D_REQUIRE_EQUAL(lattice->getNumberOfTriangles(), serialLattice->getNumberOfTriangles());
+    for(size_t i = 0; i < serialLattice->getNumberOfTriangles(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(lattice->getColumn(i), serialLattice->getColumn(i));
+      DREAM3D_REQUIRE_EQUAL(lattice->getRow(i), serialLattice->getRow(i));
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicParallelParse()
+{
+  MicRowFilter confidenceFilter;
+  confidenceFilter.useMinConfidence = true;
+  confidenceFilter.minConfidence = 0.3f;
+
+  MicRowFilter boxFilter;
+  boxFilter.useBoundingBox = true;
+  boxFilter.xMin = -0.2f;
+  boxFilter.xMax = 0.2f;
+  boxFilter.yMin = -0.2f;
+  boxFilter.yMax = 0.1f;
+
+  QFile in(UnitTest::HedmReaderTest::MicFile);
+  DREAM3D_REQUIRE(in.open(QIODevice::ReadOnly));
+  QByteArray contents = in.readAll();
+  in.close();
+
+  // Chunk sizes that are prime, so the chunk boundaries fall in the middle of rows and
+  // every chunk has to move its start to the next line
+  const size_t chunkSizes[] = {1000, 4093, 7919};
+  for(size_t chunkSize : chunkSizes)
+  {
+    DREAM3D_REQUIRE(static_cast<size_t>(contents.size()) > 2 * chunkSize);
+
+    for(int pass = 0; pass < 4; pass++)
+    {
+      MicReader serialReader;
+      serialReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+      serialReader.setParallelParsing(false);
+      MicReader reader;
+      reader.setFileName(UnitTest::HedmReaderTest::MicFile);
+      reader.setParallelChunkSize(chunkSize);
+
+      // The triangle table, the grid, and the triangle table with rows dropped by confidence and by position
+      if(pass != 1)
+      {
+        serialReader.setResampleToGrid(false);
+        reader.setResampleToGrid(false);
+      }
+      if(pass == 2)
+      {
+        serialReader.setRowFilter(confidenceFilter);
+        reader.setRowFilter(confidenceFilter);
+      }
+      else if(pass == 3)
+      {
+        serialReader.setRowFilter(boxFilter);
+        reader.setRowFilter(boxFilter);
+      }
+
+      DREAM3D_REQUIRE(serialReader.readFile() >= 0);
+      DREAM3D_REQUIRE(reader.readFile() >= 0);
+      RequireSameMicRead(reader, serialReader);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicGridTarget()
+{
+  MicReader gridReader;
+  gridReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  int err = gridReader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+
+  // Resampling onto a caller owned copy of the reader's own grid gives the same values
+  MicGridTarget target;
+  target.xDim = gridReader.getXDimension();
+  target.yDim = gridReader.getYDimension();
+  target.spacing = gridReader.getEdgeLength();
+  target.xOrigin = gridReader.getXOrigin();
+  target.yOrigin = gridReader.getYOrigin();
+  size_t numPoints = static_cast<size_t>(target.xDim) * static_cast<size_t>(target.yDim);
+  std::vector<float> eulerAngles(3 * numPoints, 0.0f);
+  std::vector<int> phases(numPoints, 0);
+  std::vector<float> confidences(numPoints, 0.0f);
+  target.eulerAngles = eulerAngles.data();
+  target.phases = phases.data();
+  target.confidences = confidences.data();
+
+  MicReader reader;
+  reader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  reader.setGridTarget(&target);
+  err = reader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE(reader.getConfidencePointer() == nullptr);
+
+  for(size_t point = 0; point < numPoints; point++)
+  {
+    DREAM3D_REQUIRE_EQUAL(eulerAngles[3 * point], gridReader.getEuler1Pointer()[point]);
+    DREAM3D_REQUIRE_EQUAL(eulerAngles[3 * point + 1], gridReader.getEuler2Pointer()[point]);
+    DREAM3D_REQUIRE_EQUAL(eulerAngles[3 * point + 2], gridReader.getEuler3Pointer()[point]);
+    DREAM3D_REQUIRE_EQUAL(phases[point], gridReader.getPhasePointer()[point]);
+    DREAM3D_REQUIRE_EQUAL(confidences[point], gridReader.getConfidencePointer()[point]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicGridAllocator()
+{
+  MicReader gridReader;
+  gridReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  int err = gridReader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+
+  // The reader asks for the memory of its own grid and resamples into it
+  std::vector<float> eulerAngles;
+  std::vector<int> phases;
+  MicGridTarget allocatedTarget;
+  MicReader reader;
+  reader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  reader.setGridAllocator([&](MicGridTarget& target) {
+    size_t numPoints = static_cast<size_t>(target.xDim) * static_cast<size_t>(target.yDim);
+    eulerAngles.assign(3 * numPoints, 0.0f);
+    phases.assign(numPoints, 0);
+    target.eulerAngles = eulerAngles.data();
+    target.phases = phases.data();
+    allocatedTarget = target;
+  });
+  err = reader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE_EQUAL(allocatedTarget.xDim, gridReader.getXDimension());
+  DREAM3D_REQUIRE_EQUAL(allocatedTarget.yDim, gridReader.getYDimension());
+  DREAM3D_REQUIRE_EQUAL(allocatedTarget.spacing, gridReader.getEdgeLength());
+  DREAM3D_REQUIRE_EQUAL(allocatedTarget.xOrigin, gridReader.getXOrigin());
+  DREAM3D_REQUIRE_EQUAL(allocatedTarget.yOrigin, gridReader.getYOrigin());
+
+  // The allocated columns are not held by the reader, the confidence was left to it
+  DREAM3D_REQUIRE(reader.getEuler1Pointer() == nullptr);
+  DREAM3D_REQUIRE(reader.getPhasePointer() == nullptr);
+  DREAM3D_REQUIRE(reader.getConfidencePointer() != nullptr);
+  DREAM3D_REQUIRE(reader.getXPointer() != nullptr);
+
+  size_t numPoints = static_cast<size_t>(gridReader.getXDimension()) * static_cast<size_t>(gridReader.getYDimension());
+  for(size_t point = 0; point < numPoints; point++)
+  {
+    DREAM3D_REQUIRE_EQUAL(eulerAngles[3 * point], gridReader.getEuler1Pointer()[point]);
+    DREAM3D_REQUIRE_EQUAL(eulerAngles[3 * point + 1], gridReader.getEuler2Pointer()[point]);
+    DREAM3D_REQUIRE_EQUAL(eulerAngles[3 * point + 2], gridReader.getEuler3Pointer()[point]);
+    DREAM3D_REQUIRE_EQUAL(phases[point], gridReader.getPhasePointer()[point]);
+    DREAM3D_REQUIRE_EQUAL(reader.getConfidencePointer()[point], gridReader.getConfidencePointer()[point]);
+    DREAM3D_REQUIRE_EQUAL(reader.getXPointer()[point], gridReader.getXPointer()[point]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicCompactCodec()
+{
+  // Every angle of a turn, and angles outside of it, decode to within half a step modulo 360
+  std::vector<float> degrees;
+  for(float angle = -720.0f; angle <= 720.0f; angle += 0.0137f)
+  {
+    degrees.push_back(angle);
+  }
+  std::vector<uint16_t> codes(degrees.size());
+  std::vector<float> decoded(degrees.size());
+  MicCompactCodec::encodeEulerAngles(degrees.data(), codes.data(), degrees.size());
+  MicCompactCodec::decodeEulerAngles(codes.data(), decoded.data(), codes.size());
+  for(size_t i = 0; i < degrees.size(); i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(codes[i], MicCompactCodec::encodeEulerAngle(degrees[i]));
+    // The float rounding of the angles themselves comes on top of half a step
+    double error = std::fabs(std::remainder(static_cast<double>(decoded[i]) - static_cast<double>(degrees[i]), 360.0));
+    DREAM3D_REQUIRE(error <= MicCompactCodec::k_EulerMaxError + 1.0E-4);
+  }
+  DREAM3D_REQUIRE_EQUAL(MicCompactCodec::encodeEulerAngle(0.0f), 0);
+  DREAM3D_REQUIRE_EQUAL(MicCompactCodec::encodeEulerAngle(360.0f), 0);
+  DREAM3D_REQUIRE_EQUAL(MicCompactCodec::encodeEulerAngle(-MicCompactCodec::k_EulerStep), 65535);
+
+  std::vector<float> confidences = {-0.5f, 0.0f, 0.1f, 0.5f, 0.999f, 1.0f, 1.5f};
+  std::vector<uint8_t> confidenceCodes(confidences.size());
+  std::vector<float> decodedConfidences(confidences.size());
+  MicCompactCodec::encodeConfidences(confidences.data(), confidenceCodes.data(), confidences.size());
+  MicCompactCodec::decodeConfidences(confidenceCodes.data(), decodedConfidences.data(), confidenceCodes.size());
+  for(size_t i = 0; i < confidences.size(); i++)
+  {
+    float clamped = std::min(std::max(confidences[i], 0.0f), 1.0f);
+    DREAM3D_REQUIRE(std::fabs(decodedConfidences[i] - clamped) <= MicCompactCodec::k_ConfidenceMaxError * 1.01f);
+  }
+  DREAM3D_REQUIRE_EQUAL(confidenceCodes[0], 0);
+  DREAM3D_REQUIRE_EQUAL(confidenceCodes[6], 255);
+
+  // A grid target with compact arrays gets the codes of the values of the reader's own grid
+  MicReader gridReader;
+  gridReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  int err = gridReader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  MicGridTarget target;
+  target.xDim = gridReader.getXDimension();
+  target.yDim = gridReader.getYDimension();
+  target.spacing = gridReader.getEdgeLength();
+  target.xOrigin = gridReader.getXOrigin();
+  target.yOrigin = gridReader.getYOrigin();
+  size_t numPoints = static_cast<size_t>(target.xDim) * static_cast<size_t>(target.yDim);
+  std::vector<uint16_t> eulerCodes(3 * numPoints, 0);
+  std::vector<uint8_t> gridConfidenceCodes(numPoints, 0);
+  target.compactEulerAngles = eulerCodes.data();
+  target.compactConfidences = gridConfidenceCodes.data();
+
+  MicReader reader;
+  reader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  reader.setGridTarget(&target);
+  err = reader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  for(size_t point = 0; point < numPoints; point++)
+  {
+    DREAM3D_REQUIRE_EQUAL(eulerCodes[3 * point], MicCompactCodec::encodeEulerAngle(gridReader.getEuler1Pointer()[point]));
+    DREAM3D_REQUIRE_EQUAL(eulerCodes[3 * point + 1], MicCompactCodec::encodeEulerAngle(gridReader.getEuler2Pointer()[point]));
+    DREAM3D_REQUIRE_EQUAL(eulerCodes[3 * point + 2], MicCompactCodec::encodeEulerAngle(gridReader.getEuler3Pointer()[point]));
+    DREAM3D_REQUIRE_EQUAL(gridConfidenceCodes[point], MicCompactCodec::encodeConfidence(gridReader.getConfidencePointer()[point]));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicRegionOfInterest()
+{
+  MicRegionOfInterest region;
+  region.enabled = true;
+  region.xMin = -0.1f;
+  region.xMax = 0.15f;
+  region.yMin = -0.12f;
+  region.yMax = 0.05f;
+
+  MicReader headerReader;
+  headerReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  headerReader.setRegionOfInterest(region);
+  int err = headerReader.readHeaderOnly();
+  DREAM3D_REQUIRE(err >= 0);
+
+  MicReader reader;
+  reader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  reader.setRegionOfInterest(region);
+  err = reader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE_EQUAL(reader.getXOrigin(), region.xMin);
+  DREAM3D_REQUIRE_EQUAL(reader.getYOrigin(), region.yMin);
+  DREAM3D_REQUIRE_EQUAL(reader.getXDimension(), headerReader.getXDimension());
+  DREAM3D_REQUIRE_EQUAL(reader.getYDimension(), headerReader.getYDimension());
+
+  // Resampling every triangle onto the same window gives the same values, so no triangle
+  // that reaches into the region was dropped
+  MicGridTarget target;
+  target.xDim = reader.getXDimension();
+  target.yDim = reader.getYDimension();
+  target.spacing = reader.getEdgeLength();
+  target.xOrigin = region.xMin;
+  target.yOrigin = region.yMin;
+  size_t numPoints = static_cast<size_t>(target.xDim) * static_cast<size_t>(target.yDim);
+  DREAM3D_REQUIRE_EQUAL(reader.getNumberOfElements(), numPoints);
+  std::vector<float> eulerAngles(3 * numPoints, 0.0f);
+  std::vector<int> phases(numPoints, 0);
+  target.eulerAngles = eulerAngles.data();
+  target.phases = phases.data();
+
+  MicReader targetReader;
+  targetReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  targetReader.setGridTarget(&target);
+  err = targetReader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  size_t numCovered = 0;
+  for(size_t point = 0; point < numPoints; point++)
+  {
+    DREAM3D_REQUIRE_EQUAL(reader.getEuler1Pointer()[point], eulerAngles[3 * point]);
+    DREAM3D_REQUIRE_EQUAL(reader.getEuler2Pointer()[point], eulerAngles[3 * point + 1]);
+    DREAM3D_REQUIRE_EQUAL(reader.getEuler3Pointer()[point], eulerAngles[3 * point + 2]);
+    DREAM3D_REQUIRE_EQUAL(reader.getPhasePointer()[point], phases[point]);
+    numCovered += (phases[point] != 0 || eulerAngles[3 * point] != 0.0f) ? 1 : 0;
+  }
+  DREAM3D_REQUIRE(numCovered > 0);
+
+  // The triangle table only holds the triangles that reach into the region
+  MicReader fullReader;
+  fullReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  fullReader.setResampleToGrid(false);
+  err = fullReader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  MicReader triangleReader;
+  triangleReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  triangleReader.setResampleToGrid(false);
+  triangleReader.setRegionOfInterest(region);
+  err = triangleReader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE(triangleReader.getNumberOfElements() > 0 && triangleReader.getNumberOfElements() < fullReader.getNumberOfElements());
+
+  // A region outside of the data or an empty region is an error
+  region.xMin = 100.0f;
+  region.xMax = 101.0f;
+  reader.setRegionOfInterest(region);
+  DREAM3D_REQUIRE(reader.readFile() < 0);
+  region.xMax = 99.0f;
+  reader.setRegionOfInterest(region);
+  DREAM3D_REQUIRE(reader.readFile() < 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicReaderBuffer()
+{
+  MicReader fileReader;
+  fileReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  int err = fileReader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  size_t numPoints = fileReader.getNumberOfElements();
+
+  QFile in(UnitTest::HedmReaderTest::MicFile);
+  DREAM3D_REQUIRE(in.open(QIODevice::ReadOnly));
+  QByteArray contents = in.readAll();
+  in.close();
+
+  // Without a file name the rows are read but there are no header files to read
+  MicReader bufferReader;
+  err = bufferReader.readBuffer(contents.constData(), static_cast<size_t>(contents.size()));
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE_EQUAL(bufferReader.getXDimension(), fileReader.getXDimension());
+  DREAM3D_REQUIRE_EQUAL(bufferReader.getYDimension(), fileReader.getYDimension());
+  DREAM3D_REQUIRE_EQUAL(bufferReader.getNumberOfElements(), numPoints);
+  DREAM3D_REQUIRE(bufferReader.getPhaseVector().empty());
+
+  // With a file name the header files next to it are read as well
+  MicReader deviceReader;
+  deviceReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  DREAM3D_REQUIRE(deviceReader.readDevice(nullptr) < 0);
+  DREAM3D_REQUIRE(in.open(QIODevice::ReadOnly));
+  err = deviceReader.readDevice(&in);
+  in.close();
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE_EQUAL(deviceReader.getPhaseVector().size(), fileReader.getPhaseVector().size());
+  DREAM3D_REQUIRE_EQUAL(deviceReader.getNumberOfElements(), numPoints);
+
+  for(size_t point = 0; point < numPoints; point++)
+  {
+    DREAM3D_REQUIRE_EQUAL(bufferReader.getEuler1Pointer()[point], fileReader.getEuler1Pointer()[point]);
+    DREAM3D_REQUIRE_EQUAL(bufferReader.getConfidencePointer()[point], fileReader.getConfidencePointer()[point]);
+    DREAM3D_REQUIRE_EQUAL(bufferReader.getPhasePointer()[point], fileReader.getPhasePointer()[point]);
+    DREAM3D_REQUIRE_EQUAL(deviceReader.getEuler2Pointer()[point], fileReader.getEuler2Pointer()[point]);
+    DREAM3D_REQUIRE_EQUAL(deviceReader.getXPointer()[point], fileReader.getXPointer()[point]);
+  }
+}
+
+/**
+ * @brief A sequential device, like the pipe of a QProcess, that delivers its chunks one
+ * waitForReadyRead() at a time. A stalled device never reaches its end.
+ */
+class ChunkedMicDevice : public QIODevice
+{
+  public:
+    ChunkedMicDevice(const QVector<QByteArray>& chunks, bool stalled)
+    : m_Chunks(chunks)
+    , m_Stalled(stalled)
+    {
+    }
+
+    bool isSequential() const override
+    {
+      return true;
+    }
+
+    bool atEnd() const override
+    {
+      return !m_Stalled && m_Next >= m_Chunks.size() && m_Pos >= m_Current.size();
+    }
+
+    bool waitForReadyRead(int msecs) override
+    {
+      if(m_Next >= m_Chunks.size())
+      {
+        m_LastTimeout = msecs;
+        return false;
+      }
+      m_Current = m_Chunks[m_Next++];
+      m_Pos = 0;
+      return true;
+    }
+
+    int getLastTimeout() const
+    {
+      return m_LastTimeout;
+    }
+
+  protected:
+    qint64 readData(char* data, qint64 maxSize) override
+    {
+      qint64 numBytes = std::min(maxSize, static_cast<qint64>(m_Current.size() - m_Pos));
+      ::memcpy(data, m_Current.constData() + m_Pos, static_cast<size_t>(numBytes));
+      m_Pos += static_cast<int>(numBytes);
+      return numBytes;
+    }
+
+    qint64 writeData(const char*, qint64) override
+    {
+      return -1;
+    }
+
+  private:
+    QVector<QByteArray> m_Chunks;
+    bool m_Stalled = false;
+    int m_Next = 0;
+    QByteArray m_Current;
+    int m_Pos = 0;
+    int m_LastTimeout = 0;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicReaderDevice()
 {
-  int err = EXIT_SUCCESS;
-  DREAM3D_REGISTER_TEST( TestHedmReader() )
+  MicReader fileReader;
+  fileReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  int err = fileReader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
 
+  QFile in(UnitTest::HedmReaderTest::MicFile);
+  DREAM3D_REQUIRE(in.open(QIODevice::ReadOnly));
+  QByteArray contents = in.readAll();
+  in.close();
+
+  // The chunks split a row, and the rows are parsed once the device is at its end
+  int split = contents.size() / 3 + 7;
+  DREAM3D_REQUIRE(contents[split - 1] != '\n');
+  QVector<QByteArray> chunks = {contents.left(split), contents.mid(split)};
+  ChunkedMicDevice device(chunks, false);
+  DREAM3D_REQUIRE(device.open(QIODevice::ReadOnly));
+  MicReader reader;
+  err = reader.readDevice(&device);
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE_EQUAL(reader.getNumberOfElements(), fileReader.getNumberOfElements());
+  for(size_t point = 0; point < fileReader.getNumberOfElements(); point++)
+  {
+    DREAM3D_REQUIRE_EQUAL(reader.getEuler1Pointer()[point], fileReader.getEuler1Pointer()[point]);
+  }
 
-  PRINT_TEST_SUMMARY();
-  return err;
+  // A device that stops delivering data before its end is an error after the timeout
+  ChunkedMicDevice stalledDevice(chunks, true);
+  DREAM3D_REQUIRE(stalledDevice.open(QIODevice::ReadOnly));
+  MicReader stalledReader;
+  DREAM3D_REQUIRE_EQUAL(stalledReader.getDeviceReadTimeout(), static_cast<int>(MicReader::k_DefaultDeviceReadTimeout));
+  stalledReader.setDeviceReadTimeout(10);
+  err = stalledReader.readDevice(&stalledDevice);
+  DREAM3D_REQUIRE_EQUAL(err, -118);
+  DREAM3D_REQUIRE_EQUAL(stalledReader.getErrorCode(), -118);
+  DREAM3D_REQUIRE_EQUAL(stalledDevice.getLastTimeout(), 10);
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestH5MicImporter()
+{
+  MicReader micReader;
+  micReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  int err = micReader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  size_t numPoints = micReader.getNumberOfElements();
+  int xDim = micReader.getXDimension();
+
+  QString h5File = UnitTest::TestTempDir + "/H5MicImporterTest.h5";
+  QVector<Mic::H5Mic::Compression> compressions = {Mic::H5Mic::NoCompression, Mic::H5Mic::DeflateCompression, Mic::H5Mic::ZstdCompression};
+  for(Mic::H5Mic::Compression compression : compressions)
+  {
+    hid_t fileId = QH5Utilities::createFile(h5File);
+    DREAM3D_REQUIRE(fileId >= 0);
+    H5MicImporter::Pointer importer = std::dynamic_pointer_cast<H5MicImporter>(H5MicImporter::New());
+    importer->setCompression(compression);
+    importer->setChunkRows(3);
+    err = importer->importFile(fileId, 0, UnitTest::HedmReaderTest::MicFile);
+    DREAM3D_REQUIRE(err >= 0);
+
+    // Compressed arrays are stored in chunks of whole image rows
+    hid_t datasetId = H5Dopen(fileId, "0/Data/Euler1", H5P_DEFAULT);
+    DREAM3D_REQUIRE(datasetId >= 0);
+    hid_t dataProperties = H5Dget_create_plist(datasetId);
+    if(compression == Mic::H5Mic::NoCompression)
+    {
+      DREAM3D_REQUIRE(H5Pget_layout(dataProperties) == H5D_CONTIGUOUS);
+    }
+    else
+    {
+      hsize_t chunkDims[1] = {0};
+      DREAM3D_REQUIRE(H5Pget_layout(dataProperties) == H5D_CHUNKED);
+      DREAM3D_REQUIRE_EQUAL(H5Pget_chunk(dataProperties, 1, chunkDims), 1);
+      DREAM3D_REQUIRE_EQUAL(chunkDims[0], std::min<hsize_t>(numPoints, 3 * xDim));
+      DREAM3D_REQUIRE(H5Pget_nfilters(dataProperties) == 2);
+    }
+    H5Pclose(dataProperties);
+    H5Dclose(datasetId);
+    QH5Utilities::closeFile(fileId);
+
+    H5MicReader::Pointer h5Reader = H5MicReader::New();
+    h5Reader->setFileName(h5File);
+    h5Reader->setHDF5Path("0");
+    err = h5Reader->readFile();
+    DREAM3D_REQUIRE(err >= 0);
+    DREAM3D_REQUIRE_EQUAL(h5Reader->getNumberOfElements(), numPoints);
+    for(size_t point = 0; point < numPoints; point++)
+    {
+      DREAM3D_REQUIRE_EQUAL(h5Reader->getEuler1Pointer()[point], micReader.getEuler1Pointer()[point]);
+      DREAM3D_REQUIRE_EQUAL(h5Reader->getEuler3Pointer()[point], micReader.getEuler3Pointer()[point]);
+      DREAM3D_REQUIRE_EQUAL(h5Reader->getConfidencePointer()[point], micReader.getConfidencePointer()[point]);
+      DREAM3D_REQUIRE_EQUAL(h5Reader->getPhasePointer()[point], micReader.getPhasePointer()[point]);
+    }
+  }
+  QFile::remove(h5File);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestH5MicImporterStack()
+{
+  MicReader micReader;
+  micReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  int err = micReader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  size_t numPoints = micReader.getNumberOfElements();
+
+  QString h5File = UnitTest::TestTempDir + "/H5MicImporterStackTest.h5";
+  QVector<QString> micFiles(6, UnitTest::HedmReaderTest::MicFile);
+  hid_t fileId = QH5Utilities::createFile(h5File);
+  DREAM3D_REQUIRE(fileId >= 0);
+  H5MicImporter::Pointer importer = std::dynamic_pointer_cast<H5MicImporter>(H5MicImporter::New());
+  importer->setMaxSlicesInFlight(2);
+  err = importer->importFiles(fileId, 10, micFiles);
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE_EQUAL(importer->numberOfSlicesImported(), 6);
+
+  // A file that can not be read stops the import, the slices before it are written
+  micFiles[3] = UnitTest::TestTempDir + "/DoesNotExist.mic";
+  err = importer->importFiles(fileId, 20, micFiles);
+  DREAM3D_REQUIRE(err < 0);
+  DREAM3D_REQUIRE_EQUAL(importer->numberOfSlicesImported(), 3);
+  DREAM3D_REQUIRE(H5Lexists(fileId, "22", H5P_DEFAULT) > 0);
+  DREAM3D_REQUIRE(H5Lexists(fileId, "23", H5P_DEFAULT) == 0);
+
+  // With every slice in flight the missing file fails long before the slices ahead of it
+  // are parsed, and those are still written
+  QVector<QString> manyFiles(12, UnitTest::HedmReaderTest::MicFile);
+  manyFiles[5] = micFiles[3];
+  importer->setMaxSlicesInFlight(manyFiles.size());
+  err = importer->importFiles(fileId, 30, manyFiles);
+  DREAM3D_REQUIRE(err < 0);
+  DREAM3D_REQUIRE_EQUAL(importer->numberOfSlicesImported(), 5);
+  DREAM3D_REQUIRE(H5Lexists(fileId, "34", H5P_DEFAULT) > 0);
+  DREAM3D_REQUIRE(H5Lexists(fileId, "35", H5P_DEFAULT) == 0);
+  QH5Utilities::closeFile(fileId);
+
+  for(int z = 10; z < 16; z++)
+  {
+    H5MicReader::Pointer h5Reader = H5MicReader::New();
+    h5Reader->setFileName(h5File);
+    h5Reader->setHDF5Path(QString::number(z));
+    err = h5Reader->readFile();
+    DREAM3D_REQUIRE(err >= 0);
+    DREAM3D_REQUIRE_EQUAL(h5Reader->getNumberOfElements(), numPoints);
+    for(size_t point = 0; point < numPoints; point++)
+    {
+      DREAM3D_REQUIRE_EQUAL(h5Reader->getEuler2Pointer()[point], micReader.getEuler2Pointer()[point]);
+      DREAM3D_REQUIRE_EQUAL(h5Reader->getPhasePointer()[point], micReader.getPhasePointer()[point]);
+    }
+  }
+  QFile::remove(h5File);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestH5MicVolumeLayout()
+{
+  // The same stack with per slice Data groups and with the Volume group only
+  QVector<QString> h5Files = {UnitTest::TestTempDir + "/H5MicSliceLayoutTest.h5", UnitTest::TestTempDir + "/H5MicVolumeLayoutTest.h5"};
+  QVector<Mic::H5Mic::Layout> layouts = {Mic::H5Mic::SliceGroups, Mic::H5Mic::VolumeOnly};
+  QVector<QString> micFiles(4, UnitTest::HedmReaderTest::MicFile);
+  int64_t xPoints = 0;
+  int64_t yPoints = 0;
+  for(int file = 0; file < h5Files.size(); file++)
+  {
+    hid_t fileId = QH5Utilities::createFile(h5Files[file]);
+    DREAM3D_REQUIRE(fileId >= 0);
+    H5MicImporter::Pointer importer = std::dynamic_pointer_cast<H5MicImporter>(H5MicImporter::New());
+    importer->setLayout(layouts[file]);
+    int err = importer->importFiles(fileId, 0, micFiles);
+    DREAM3D_REQUIRE(err >= 0);
+    importer->getDims(xPoints, yPoints);
+    DREAM3D_REQUIRE_EQUAL(H5Lexists(fileId, "Volume", H5P_DEFAULT) > 0, layouts[file] == Mic::H5Mic::VolumeOnly);
+    DREAM3D_REQUIRE_EQUAL(H5Lexists(fileId, "2/Data", H5P_DEFAULT) > 0, layouts[file] == Mic::H5Mic::SliceGroups);
+
+    int zStart = 0;
+    int zEnd = micFiles.size() - 1;
+    uint32_t stackingOrder = SIMPL::RefFrameZDir::LowtoHigh;
+    QH5Lite::writeScalarDataset(fileId, Ebsd::H5Ebsd::ZStartIndex, zStart);
+    QH5Lite::writeScalarDataset(fileId, Ebsd::H5Ebsd::ZEndIndex, zEnd);
+    QH5Lite::writeScalarDataset(fileId, Ebsd::H5Ebsd::XPoints, xPoints);
+    QH5Lite::writeScalarDataset(fileId, Ebsd::H5Ebsd::YPoints, yPoints);
+    QH5Lite::writeScalarDataset(fileId, Ebsd::H5Ebsd::StackingOrder, stackingOrder);
+    QH5Utilities::closeFile(fileId);
+  }
+
+  size_t numPoints = static_cast<size_t>(xPoints * yPoints * 3);
+  QVector<uint32_t> zDirs = {SIMPL::RefFrameZDir::LowtoHigh, SIMPL::RefFrameZDir::HightoLow};
+  for(uint32_t zDir : zDirs)
+  {
+    QVector<H5MicVolumeReader::Pointer> readers;
+    for(const QString& h5File : h5Files)
+    {
+      H5MicVolumeReader::Pointer reader = std::dynamic_pointer_cast<H5MicVolumeReader>(H5MicVolumeReader::New());
+      reader->setFileName(h5File);
+      reader->setSliceStart(1);
+      reader->setReadAllArrays(true);
+      int err = reader->loadData(xPoints, yPoints, 3, zDir);
+      DREAM3D_REQUIRE(err >= 0);
+      readers.push_back(reader);
+    }
+    for(size_t point = 0; point < numPoints; point++)
+    {
+      DREAM3D_REQUIRE_EQUAL(readers[1]->getEuler1Pointer()[point], readers[0]->getEuler1Pointer()[point]);
+      DREAM3D_REQUIRE_EQUAL(readers[1]->getConfidencePointer()[point], readers[0]->getConfidencePointer()[point]);
+      DREAM3D_REQUIRE_EQUAL(readers[1]->getXPointer()[point], readers[0]->getXPointer()[point]);
+      DREAM3D_REQUIRE_EQUAL(readers[1]->getPhasePointer()[point], readers[0]->getPhasePointer()[point]);
+    }
+  }
+  for(const QString& h5File : h5Files)
+  {
+    QFile::remove(h5File);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestH5MicVirtualVolume()
+{
+  QString h5File = UnitTest::TestTempDir + "/H5MicVirtualSourceTest.h5";
+  QString viewFile = UnitTest::TestTempDir + "/H5MicVirtualViewTest.h5";
+  QVector<QString> micFiles(4, UnitTest::HedmReaderTest::MicFile);
+  int64_t xPoints = 0;
+  int64_t yPoints = 0;
+  {
+    hid_t fileId = QH5Utilities::createFile(h5File);
+    DREAM3D_REQUIRE(fileId >= 0);
+    H5MicImporter::Pointer importer = std::dynamic_pointer_cast<H5MicImporter>(H5MicImporter::New());
+    int err = importer->importFiles(fileId, 0, micFiles);
+    DREAM3D_REQUIRE(err >= 0);
+    importer->getDims(xPoints, yPoints);
+
+    int zStart = 0;
+    int zEnd = micFiles.size() - 1;
+    uint32_t stackingOrder = SIMPL::RefFrameZDir::LowtoHigh;
+    QH5Lite::writeScalarDataset(fileId, Ebsd::H5Ebsd::ZStartIndex, zStart);
+    QH5Lite::writeScalarDataset(fileId, Ebsd::H5Ebsd::ZEndIndex, zEnd);
+    QH5Lite::writeScalarDataset(fileId, Ebsd::H5Ebsd::XPoints, xPoints);
+    QH5Lite::writeScalarDataset(fileId, Ebsd::H5Ebsd::YPoints, yPoints);
+    QH5Lite::writeScalarDataset(fileId, Ebsd::H5Ebsd::StackingOrder, stackingOrder);
+    QH5Utilities::closeFile(fileId);
+  }
+
+  // A view file that maps the slices of the source file
+  {
+    hid_t fileId = QH5Utilities::createFile(viewFile);
+    DREAM3D_REQUIRE(fileId >= 0);
+    H5MicImporter::Pointer importer = std::dynamic_pointer_cast<H5MicImporter>(H5MicImporter::New());
+    int err = importer->writeVirtualVolume(fileId, h5File);
+    DREAM3D_REQUIRE(err >= 0);
+    DREAM3D_REQUIRE(H5Lexists(fileId, "Volume/Euler1", H5P_DEFAULT) > 0);
+    DREAM3D_REQUIRE(H5Lexists(fileId, "2/Header", H5P_DEFAULT) > 0);
+    err = importer->writeVirtualVolume(fileId, h5File);
+    DREAM3D_REQUIRE(err < 0);
+    QH5Utilities::closeFile(fileId);
+  }
+
+  size_t numPoints = static_cast<size_t>(xPoints * yPoints * 3);
+  QVector<H5MicVolumeReader::Pointer> readers;
+  for(const QString& file : {h5File, viewFile})
+  {
+    H5MicVolumeReader::Pointer reader = std::dynamic_pointer_cast<H5MicVolumeReader>(H5MicVolumeReader::New());
+    reader->setFileName(file);
+    reader->setSliceStart(1);
+    reader->setReadAllArrays(true);
+    int err = reader->loadData(xPoints, yPoints, 3, SIMPL::RefFrameZDir::HightoLow);
+    DREAM3D_REQUIRE(err >= 0);
+    DREAM3D_REQUIRE_EQUAL(reader->getPhases().size(), readers.empty() ? reader->getPhases().size() : readers[0]->getPhases().size());
+    readers.push_back(reader);
+  }
+
+  // The same view added to the source file itself
+  {
+    hid_t fileId = QH5Utilities::openFile(h5File, false);
+    DREAM3D_REQUIRE(fileId >= 0);
+    H5MicImporter::Pointer importer = std::dynamic_pointer_cast<H5MicImporter>(H5MicImporter::New());
+    int err = importer->writeVirtualVolume(fileId);
+    DREAM3D_REQUIRE(err >= 0);
+    QH5Utilities::closeFile(fileId);
+
+    H5MicVolumeReader::Pointer reader = std::dynamic_pointer_cast<H5MicVolumeReader>(H5MicVolumeReader::New());
+    reader->setFileName(h5File);
+    reader->setSliceStart(1);
+    reader->setReadAllArrays(true);
+    err = reader->loadData(xPoints, yPoints, 3, SIMPL::RefFrameZDir::HightoLow);
+    DREAM3D_REQUIRE(err >= 0);
+    readers.push_back(reader);
+  }
+
+  for(int r = 1; r < readers.size(); r++)
+  {
+    for(size_t point = 0; point < numPoints; point++)
+    {
+      DREAM3D_REQUIRE_EQUAL(readers[r]->getEuler1Pointer()[point], readers[0]->getEuler1Pointer()[point]);
+      DREAM3D_REQUIRE_EQUAL(readers[r]->getConfidencePointer()[point], readers[0]->getConfidencePointer()[point]);
+      DREAM3D_REQUIRE_EQUAL(readers[r]->getYPointer()[point], readers[0]->getYPointer()[point]);
+      DREAM3D_REQUIRE_EQUAL(readers[r]->getPhasePointer()[point], readers[0]->getPhasePointer()[point]);
+    }
+  }
+  QFile::remove(viewFile);
+  QFile::remove(h5File);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicCacheFile()
+{
+  // Every layer of a stack gets its own sidecar, including names with more than one dot
+  QString firstCache = MicCacheFile::GenerateCacheFilePath(UnitTest::TestTempDir + "/sample.001.mic");
+  QString secondCache = MicCacheFile::GenerateCacheFilePath(UnitTest::TestTempDir + "/sample.002.mic");
+  DREAM3D_REQUIRE(firstCache != secondCache);
+  DREAM3D_REQUIRE(firstCache.endsWith("sample.001." + Mic::Cache::FileExt));
+
+  const quint64 numTriangles = 3;
+  const quint64 numCells = 2;
+  std::vector<float> triangleValues(numTriangles);
+  std::vector<float> cellValues(numCells);
+  QVector<const void*> triangleArrays(Mic::Cache::NumTriangleArrays);
+  QVector<const void*> cellArrays(Mic::Cache::NumCellArrays);
+  for(quint64 i = 0; i < numTriangles; i++)
+  {
+    triangleValues[i] = 0.5f + static_cast<float>(i);
+  }
+  for(quint64 i = 0; i < numCells; i++)
+  {
+    cellValues[i] = 10.0f + static_cast<float>(i);
+  }
+  std::fill(triangleArrays.begin(), triangleArrays.end(), triangleValues.data());
+  std::fill(cellArrays.begin(), cellArrays.end(), cellValues.data());
+
+  MicCacheHeader header;
+  header.micFileSize = 1000;
+  header.micLastModified = 123456;
+  header.xDim = 2;
+  header.yDim = 1;
+  header.edgeLength = 0.25f;
+  header.numTriangles = numTriangles;
+  header.numCells = numCells;
+  QString micFile = UnitTest::TestTempDir + "/sample.001.mic";
+  DREAM3D_REQUIRE(MicCacheFile::WriteFile(firstCache, header, micFile, triangleArrays, cellArrays));
+
+  // The round trip gives back the header and the arrays
+  {
+    MicCacheFile cacheFile(firstCache);
+    DREAM3D_REQUIRE(cacheFile.open(micFile, 1000, 123456));
+    DREAM3D_REQUIRE_EQUAL(cacheFile.getHeader().numTriangles, numTriangles);
+    DREAM3D_REQUIRE_EQUAL(cacheFile.getHeader().edgeLength, 0.25f);
+    for(int array = 0; array < Mic::Cache::NumTriangleArrays; array++)
+    {
+      DREAM3D_REQUIRE(::memcmp(cacheFile.getTriangleArray(array), triangleValues.data(), numTriangles * sizeof(float)) == 0);
+    }
+    for(int array = 0; array < Mic::Cache::NumCellArrays; array++)
+    {
+      DREAM3D_REQUIRE(::memcmp(cacheFile.getCellArray(array), cellValues.data(), numCells * sizeof(float)) == 0);
+    }
+  }
+
+  // A changed size, modification time or path invalidates the sidecar
+  {
+    MicCacheFile cacheFile(firstCache);
+    DREAM3D_REQUIRE(!cacheFile.open(micFile, 1001, 123456));
+    DREAM3D_REQUIRE(!cacheFile.open(micFile, 1000, 123457));
+    DREAM3D_REQUIRE(!cacheFile.open(UnitTest::TestTempDir + "/sample.002.mic", 1000, 123456));
+    DREAM3D_REQUIRE(cacheFile.open(micFile, 1000, 123456));
+  }
+
+  // So does a sidecar written by another version
+  {
+    QFile file(firstCache);
+    DREAM3D_REQUIRE(file.open(QIODevice::ReadWrite));
+    quint32 version = Mic::Cache::FileVersion + 1;
+    file.seek(offsetof(MicCacheHeader, version));
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.close();
+    MicCacheFile cacheFile(firstCache);
+    DREAM3D_REQUIRE(!cacheFile.open(micFile, 1000, 123456));
+  }
+  QFile::remove(firstCache);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicReaderCache()
+{
+  MicReaderCache* cache = MicReaderCache::Instance();
+  cache->clear();
+  DREAM3D_REQUIRE(cache->find(UnitTest::HedmReaderTest::MicFile).get() == nullptr);
+
+  std::shared_ptr<MicReader> reader(new MicReader());
+  reader->setFileName(UnitTest::HedmReaderTest::MicFile);
+  int err = reader->readFile();
+  DREAM3D_REQUIRE(err >= 0);
+
+  cache->insert(UnitTest::HedmReaderTest::MicFile, reader);
+  DREAM3D_REQUIRE(cache->find(UnitTest::HedmReaderTest::MicFile) == reader);
+  DREAM3D_REQUIRE_EQUAL(cache->getMemoryUsage(), reader->getDataSize());
+
+  // Shrinking the budget below the size of the reader drops it
+  size_t budget = cache->getMemoryBudget();
+  cache->setMemoryBudget(reader->getDataSize() - 1);
+  DREAM3D_REQUIRE(cache->find(UnitTest::HedmReaderTest::MicFile).get() == nullptr);
+  DREAM3D_REQUIRE_EQUAL(cache->getMemoryUsage(), 0);
+  cache->insert(UnitTest::HedmReaderTest::MicFile, reader);
+  DREAM3D_REQUIRE(cache->find(UnitTest::HedmReaderTest::MicFile).get() == nullptr);
+
+  cache->setMemoryBudget(budget);
+  cache->clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WriteMicLatticeFile(const QString& micFile, int numRows, int numColumns, bool onLattice)
+{
+  QString basePath = UnitTest::HedmReaderTest::MicFile.left(UnitTest::HedmReaderTest::MicFile.size() - 4);
+  QString latticeBasePath = micFile.left(micFile.size() - 4);
+  QFile::remove(latticeBasePath + ".config");
+  QFile::remove(latticeBasePath + ".dat");
+  DREAM3D_REQUIRE(QFile::copy(basePath + ".config", latticeBasePath + ".config"));
+  DREAM3D_REQUIRE(QFile::copy(basePath + ".dat", latticeBasePath + ".dat"));
+
+  // Level 4 triangles of a 0.6 edge, up and down in turn, with the left vertex of a down
+  // triangle at its top. Every triangle has its own Euler angles and confidence. A file that
+  // is not on a lattice starts every row with an up triangle, so the rows do not fit together.
+  const float edgeLength = 0.6f / 16.0f;
+  const float height = edgeLength * sqrtf(3.0f) / 2.0f;
+  QFile out(micFile);
+  DREAM3D_REQUIRE(out.open(QIODevice::WriteOnly));
+  out.write("0.600000\n", 9);
+  char line[256];
+  int triangle = 0;
+  for(int row = 0; row < numRows; row++)
+  {
+    for(int column = 0; column < numColumns; column++, triangle++)
+    {
+      bool up = (((onLattice ? row : 0) + column) % 2 == 0);
+      float x = column * edgeLength / 2.0f;
+      float y = (up ? row : row + 1) * height;
+      int numChars = snprintf(line, sizeof(line), "%.7f %.7f 0.0000000 %d 4 1 %f %f %f %f 0.0 0.0 0.0 0 0 0 0 0 0\n", x, y, up ? 1 : 2, 1.0f + triangle, 90.0f + 0.5f * triangle,
+                              180.0f - 0.25f * triangle, 0.2f + 0.001f * triangle);
+      out.write(line, numChars);
+    }
+  }
+  out.close();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestH5MicSliceData()
+{
+  // A slice that is smaller than the others between two full size slices
+  QString smallFile = UnitTest::TestTempDir + "/H5MicSmallSliceTest.mic";
+  WriteMicLatticeFile(smallFile, 8, 24, true);
+  QVector<QString> micFiles = {UnitTest::HedmReaderTest::MicFile, smallFile, UnitTest::HedmReaderTest::MicFile};
+  QString h5File = UnitTest::TestTempDir + "/H5MicSliceDataTest.h5";
+  hid_t fileId = QH5Utilities::createFile(h5File);
+  DREAM3D_REQUIRE(fileId >= 0);
+  H5MicImporter::Pointer importer = std::dynamic_pointer_cast<H5MicImporter>(H5MicImporter::New());
+  importer->setLayout(Mic::H5Mic::SliceGroups);
+  int err = importer->importFiles(fileId, 0, micFiles);
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE(H5Lexists(fileId, "Volume", H5P_DEFAULT) <= 0);
+
+  // The slices as H5MicReader reads them one at a time
+  QVector<H5MicReader::Pointer> sliceReaders;
+  int64_t xPoints = 0;
+  int64_t yPoints = 0;
+  for(int z = 0; z < micFiles.size(); z++)
+  {
+    H5MicReader::Pointer sliceReader = H5MicReader::New();
+    sliceReader->setFileName(h5File);
+    sliceReader->setHDF5Path(QString::number(z));
+    sliceReader->readAllArrays(true);
+    DREAM3D_REQUIRE(sliceReader->readSlice(fileId) >= 0);
+    xPoints = std::max(xPoints, static_cast<int64_t>(sliceReader->getXDimension()));
+    yPoints = std::max(yPoints, static_cast<int64_t>(sliceReader->getYDimension()));
+    sliceReaders.push_back(sliceReader);
+  }
+  DREAM3D_REQUIRE(sliceReaders[1]->getXDimension() < xPoints && sliceReaders[1]->getYDimension() < yPoints);
+
+  int zStart = 0;
+  int zEnd = micFiles.size() - 1;
+  uint32_t stackingOrder = SIMPL::RefFrameZDir::LowtoHigh;
+  QH5Lite::writeScalarDataset(fileId, Ebsd::H5Ebsd::ZStartIndex, zStart);
+  QH5Lite::writeScalarDataset(fileId, Ebsd::H5Ebsd::ZEndIndex, zEnd);
+  QH5Lite::writeScalarDataset(fileId, Ebsd::H5Ebsd::XPoints, xPoints);
+  QH5Lite::writeScalarDataset(fileId, Ebsd::H5Ebsd::YPoints, yPoints);
+  QH5Lite::writeScalarDataset(fileId, Ebsd::H5Ebsd::StackingOrder, stackingOrder);
+  QH5Utilities::closeFile(fileId);
+
+  size_t numZ = static_cast<size_t>(micFiles.size());
+  size_t sliceSize = static_cast<size_t>(xPoints * yPoints);
+  QVector<uint32_t> zDirs = {SIMPL::RefFrameZDir::LowtoHigh, SIMPL::RefFrameZDir::HightoLow};
+  for(uint32_t zDir : zDirs)
+  {
+    H5MicVolumeReader::Pointer reader = std::dynamic_pointer_cast<H5MicVolumeReader>(H5MicVolumeReader::New());
+    reader->setFileName(h5File);
+    reader->setSliceStart(0);
+    reader->setReadAllArrays(true);
+    err = reader->loadData(xPoints, yPoints, static_cast<int64_t>(numZ), zDir);
+    DREAM3D_REQUIRE(err >= 0);
+
+    // Every slice sits in the middle of its slab, the points around a smaller slice stay
+    // zero and phases below 1 are raised to 1
+    size_t raisedPhases = 0;
+    for(size_t z = 0; z < numZ; z++)
+    {
+      H5MicReader& sliceReader = *(sliceReaders[static_cast<int>(z)]);
+      size_t xSlice = static_cast<size_t>(sliceReader.getXDimension());
+      size_t ySlice = static_cast<size_t>(sliceReader.getYDimension());
+      size_t xOffset = (static_cast<size_t>(xPoints) - xSlice) / 2;
+      size_t yOffset = (static_cast<size_t>(yPoints) - ySlice) / 2;
+      size_t slab = (zDir == SIMPL::RefFrameZDir::HightoLow) ? numZ - 1 - z : z;
+      for(size_t j = 0; j < static_cast<size_t>(yPoints); j++)
+      {
+        for(size_t i = 0; i < static_cast<size_t>(xPoints); i++)
+        {
+          size_t point = slab * sliceSize + j * static_cast<size_t>(xPoints) + i;
+          bool inSlice = i >= xOffset && i < xOffset + xSlice && j >= yOffset && j < yOffset + ySlice;
+          if(!inSlice)
+          {
+            DREAM3D_REQUIRE_EQUAL(reader->getEuler1Pointer()[point], 0.0f);
+            DREAM3D_REQUIRE_EQUAL(reader->getPhasePointer()[point], 0);
+            continue;
+          }
+          size_t slicePoint = (j - yOffset) * xSlice + (i - xOffset);
+          DREAM3D_REQUIRE_EQUAL(reader->getEuler1Pointer()[point], sliceReader.getEuler1Pointer()[slicePoint]);
+          DREAM3D_REQUIRE_EQUAL(reader->getEuler3Pointer()[point], sliceReader.getEuler3Pointer()[slicePoint]);
+          DREAM3D_REQUIRE_EQUAL(reader->getConfidencePointer()[point], sliceReader.getConfidencePointer()[slicePoint]);
+          DREAM3D_REQUIRE_EQUAL(reader->getXPointer()[point], sliceReader.getXPointer()[slicePoint]);
+          DREAM3D_REQUIRE_EQUAL(reader->getYPointer()[point], sliceReader.getYPointer()[slicePoint]);
+          int phase = sliceReader.getPhasePointer()[slicePoint];
+          raisedPhases += (phase < 1) ? 1 : 0;
+          DREAM3D_REQUIRE_EQUAL(reader->getPhasePointer()[point], std::max(phase, 1));
+        }
+      }
+    }
+    DREAM3D_REQUIRE(raisedPhases > 0);
+  }
+
+  // A slice that does not fit into the requested volume is an error
+  H5MicVolumeReader::Pointer reader = std::dynamic_pointer_cast<H5MicVolumeReader>(H5MicVolumeReader::New());
+  reader->setFileName(h5File);
+  reader->setSliceStart(0);
+  reader->setReadAllArrays(true);
+  DREAM3D_REQUIRE(reader->loadData(xPoints - 1, yPoints, static_cast<int64_t>(numZ), SIMPL::RefFrameZDir::LowtoHigh) < 0);
+
+  QFile::remove(h5File);
+  RemoveMicFile(smallFile);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestReadMicDataResample()
+{
+  MicReaderCache* cache = MicReaderCache::Instance();
+  cache->clear();
+  QString latticeFile = UnitTest::TestTempDir + "/MicLattice.mic";
+  QString offLatticeFile = UnitTest::TestTempDir + "/MicOffLattice.mic";
+  WriteMicLatticeFile(latticeFile, 8, 24, true);
+  WriteMicLatticeFile(offLatticeFile, 8, 24, false);
+
+  // The filter keeps the triangle table of a file and resamples it straight into the cell
+  // arrays, which gives the same image as a reader that resamples the file itself. A file
+  // that is not on a regular lattice is rasterized on its own.
+  for(const QString& micFile : {UnitTest::HedmReaderTest::MicFile, latticeFile, offLatticeFile})
+  {
+    MicReader reader;
+    reader.setFileName(micFile);
+    int err = reader.readFile();
+    DREAM3D_REQUIRE(err >= 0);
+
+    ReadMicData::Pointer filter = ReadMicData::New();
+    filter->setInputFile(micFile);
+    filter->setDataContainerArray(DataContainerArray::New());
+    filter->execute();
+    DREAM3D_REQUIRE(filter->getErrorCode() >= 0);
+    std::shared_ptr<MicReader> cached = cache->find(micFile);
+    DREAM3D_REQUIRE(nullptr != cached.get());
+    DREAM3D_REQUIRE(!cached->getResampleToGrid());
+    DREAM3D_REQUIRE((nullptr != cached->getLattice().get()) == (micFile != offLatticeFile));
+
+    DataContainer::Pointer m = filter->getDataContainerArray()->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+    SizeVec3Type dims = m->getGeometryAs<ImageGeom>()->getDimensions();
+    FloatVec3Type origin = m->getGeometryAs<ImageGeom>()->getOrigin();
+    DREAM3D_REQUIRE_EQUAL(dims[0], static_cast<size_t>(reader.getXDimension()));
+    DREAM3D_REQUIRE_EQUAL(dims[1], static_cast<size_t>(reader.getYDimension()));
+    DREAM3D_REQUIRE_EQUAL(origin[0], reader.getXOrigin() * 1000.0f);
+    DREAM3D_REQUIRE_EQUAL(origin[1], reader.getYOrigin() * 1000.0f);
+    AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+    FloatArrayType::Pointer eulers = cellAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::EulerAngles);
+    FloatArrayType::Pointer confidences = cellAttrMat->getAttributeArrayAs<FloatArrayType>(Mic::Confidence);
+    Int32ArrayType::Pointer phases = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::Phases);
+    size_t numPoints = reader.getNumberOfElements();
+    DREAM3D_REQUIRE_EQUAL(confidences->getNumberOfTuples(), numPoints);
+    size_t numCovered = 0;
+    for(size_t point = 0; point < numPoints; point++)
+    {
+      DREAM3D_REQUIRE_EQUAL(eulers->getValue(3 * point), reader.getEuler1Pointer()[point]);
+      DREAM3D_REQUIRE_EQUAL(eulers->getValue(3 * point + 2), reader.getEuler3Pointer()[point]);
+      DREAM3D_REQUIRE_EQUAL(confidences->getValue(point), reader.getConfidencePointer()[point]);
+      DREAM3D_REQUIRE_EQUAL(phases->getValue(point), std::max(reader.getPhasePointer()[point], 1));
+      numCovered += (confidences->getValue(point) != 0.0f) ? 1 : 0;
+    }
+    DREAM3D_REQUIRE(numCovered > 0);
+  }
+
+  // A reader that resampled the file itself holds no triangle table
+  MicReader gridReader;
+  gridReader.setFileName(latticeFile);
+  DREAM3D_REQUIRE(gridReader.readFile() >= 0);
+  MicGridTarget target;
+  DREAM3D_REQUIRE(!gridReader.resampleTriangles(target));
+
+  // A reader that keeps the triangle table writes the resampled grid to the cache file as well,
+  // so a reader that resamples loads the same grid from it
+  QString cacheFile = MicCacheFile::GenerateCacheFilePath(latticeFile);
+  QFile::remove(cacheFile);
+  MicReader tableReader;
+  tableReader.setFileName(latticeFile);
+  tableReader.setResampleToGrid(false);
+  tableReader.setUseCacheFile(true);
+  DREAM3D_REQUIRE(tableReader.readFile() >= 0);
+  DREAM3D_REQUIRE(tableReader.getCacheFileWritten());
+  DREAM3D_REQUIRE(QFile::exists(cacheFile));
+  MicReader cachedGridReader;
+  cachedGridReader.setFileName(latticeFile);
+  cachedGridReader.setUseCacheFile(true);
+  DREAM3D_REQUIRE_EQUAL(cachedGridReader.readHeaderOnly(), 1);
+  DREAM3D_REQUIRE(cachedGridReader.readFile() >= 0);
+  DREAM3D_REQUIRE(!cachedGridReader.getCacheFileWritten());
+  DREAM3D_REQUIRE_EQUAL(cachedGridReader.getXDimension(), gridReader.getXDimension());
+  DREAM3D_REQUIRE_EQUAL(cachedGridReader.getYDimension(), gridReader.getYDimension());
+  for(size_t point = 0; point < gridReader.getNumberOfElements(); point++)
+  {
+    DREAM3D_REQUIRE_EQUAL(cachedGridReader.getXPointer()[point], gridReader.getXPointer()[point]);
+    DREAM3D_REQUIRE_EQUAL(cachedGridReader.getYPointer()[point], gridReader.getYPointer()[point]);
+    DREAM3D_REQUIRE_EQUAL(cachedGridReader.getEuler2Pointer()[point], gridReader.getEuler2Pointer()[point]);
+    DREAM3D_REQUIRE_EQUAL(cachedGridReader.getConfidencePointer()[point], gridReader.getConfidencePointer()[point]);
+    DREAM3D_REQUIRE_EQUAL(cachedGridReader.getPhasePointer()[point], gridReader.getPhasePointer()[point]);
+  }
+  QFile::remove(cacheFile);
+
+  // A cache file that can not be written does not fail the read. A folder that is not
+  // empty sits where the cache file goes.
+  DREAM3D_REQUIRE(QDir().mkpath(cacheFile));
+  QFile blocker(cacheFile + "/blocker");
+  DREAM3D_REQUIRE(blocker.open(QIODevice::WriteOnly));
+  blocker.close();
+  DREAM3D_REQUIRE(tableReader.readFile() >= 0);
+  DREAM3D_REQUIRE(!tableReader.getCacheFileWritten());
+  QFile::remove(cacheFile + "/blocker");
+  DREAM3D_REQUIRE(QDir().rmdir(cacheFile));
+
+  cache->clear();
+  RemoveMicFile(latticeFile);
+  RemoveMicFile(offLatticeFile);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestReadMicDataTriangleGeometry()
+{
+  MicReaderCache* cache = MicReaderCache::Instance();
+  cache->clear();
+  QString latticeFile = UnitTest::TestTempDir + "/MicLattice.mic";
+  QString offLatticeFile = UnitTest::TestTempDir + "/MicOffLattice.mic";
+  WriteMicLatticeFile(latticeFile, 8, 24, true);
+  WriteMicLatticeFile(offLatticeFile, 8, 24, false);
+
+  MicReader reader;
+  reader.setFileName(latticeFile);
+  reader.setResampleToGrid(false);
+  DREAM3D_REQUIRE(reader.readFile() >= 0);
+  MicLattice::Pointer lattice = reader.getLattice();
+  DREAM3D_REQUIRE(nullptr != lattice.get());
+  size_t numTriangles = reader.getNumberOfElements();
+  DREAM3D_REQUIRE_EQUAL(numTriangles, static_cast<size_t>(8 * 24));
+
+  ReadMicData::Pointer filter = ReadMicData::New();
+  filter->setInputFile(latticeFile);
+  filter->setOutputGeometryType(MIC_TRIANGLE_GEOMETRY);
+  filter->setDataContainerArray(DataContainerArray::New());
+  filter->execute();
+  DREAM3D_REQUIRE(filter->getErrorCode() >= 0);
+
+  // One face per triangle, the triangles that share an edge share its vertices. The corners
+  // are counted on the lattice in half edges along X and rows along Y.
+  DataContainer::Pointer m = filter->getDataContainerArray()->getDataContainer(filter->getDataContainerName());
+  TriangleGeom::Pointer triangleGeom = m->getGeometryAs<TriangleGeom>();
+  DREAM3D_REQUIRE(nullptr != triangleGeom.get());
+  DREAM3D_REQUIRE_EQUAL(triangleGeom->getNumberOfTris(), numTriangles);
+  std::set<std::pair<int, int>> corners;
+  for(size_t i = 0; i < numTriangles; i++)
+  {
+    int column = lattice->getColumn(i);
+    int row = lattice->getRow(i);
+    bool up = lattice->isUp(i);
+    corners.insert(std::make_pair(column, up ? row : row + 1));
+    corners.insert(std::make_pair(column + 2, up ? row : row + 1));
+    corners.insert(std::make_pair(column + 1, up ? row + 1 : row));
+  }
+  DREAM3D_REQUIRE_EQUAL(triangleGeom->getNumberOfVertices(), corners.size());
+
+  // The vertices are in microns, the left vertex of the triangle in the file is the lower (up)
+  // or upper (down) left corner of its face
+  const float edgeLength = reader.getEdgeLength() * 1000.0f;
+  for(size_t i = 0; i < numTriangles; i++)
+  {
+    float x = 0.0f;
+    float y = 0.0f;
+    lattice->getLeftVertex(i, x, y);
+    MeshIndexType* tri = triangleGeom->getTriPointer(i);
+    float xMin = std::numeric_limits<float>::max();
+    float xMax = -std::numeric_limits<float>::max();
+    float yMin = std::numeric_limits<float>::max();
+    float yMax = -std::numeric_limits<float>::max();
+    for(int corner = 0; corner < 3; corner++)
+    {
+      const float* vertex = triangleGeom->getVertexPointer(tri[corner]);
+      xMin = std::min(xMin, vertex[0]);
+      xMax = std::max(xMax, vertex[0]);
+      yMin = std::min(yMin, vertex[1]);
+      yMax = std::max(yMax, vertex[1]);
+      DREAM3D_REQUIRE_EQUAL(vertex[2], 0.0f);
+    }
+    DREAM3D_REQUIRE(std::fabs(xMin - x * 1000.0f) < 1.0e-3f);
+    DREAM3D_REQUIRE(std::fabs(xMax - (x * 1000.0f + edgeLength)) < 1.0e-3f);
+    DREAM3D_REQUIRE(std::fabs((lattice->isUp(i) ? yMin : yMax) - y * 1000.0f) < 1.0e-3f);
+    DREAM3D_REQUIRE(std::fabs((yMax - yMin) - edgeLength * sqrtf(3.0f) / 2.0f) < 1.0e-3f);
+  }
+
+  // The Face arrays hold the values of the triangles in file order
+  AttributeMatrix::Pointer faceAttrMat = m->getAttributeMatrix(filter->getFaceAttributeMatrixName());
+  DREAM3D_REQUIRE(nullptr != faceAttrMat.get());
+  DREAM3D_REQUIRE_EQUAL(faceAttrMat->getNumberOfTuples(), numTriangles);
+  FloatArrayType::Pointer eulers = faceAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::EulerAngles);
+  FloatArrayType::Pointer confidences = faceAttrMat->getAttributeArrayAs<FloatArrayType>(Mic::Confidence);
+  Int32ArrayType::Pointer phases = faceAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::Phases);
+  DREAM3D_REQUIRE(nullptr != eulers.get() && nullptr != confidences.get() && nullptr != phases.get());
+  for(size_t i = 0; i < numTriangles; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(eulers->getValue(3 * i), reader.getEuler1Pointer()[i]);
+    DREAM3D_REQUIRE_EQUAL(eulers->getValue(3 * i + 1), reader.getEuler2Pointer()[i]);
+    DREAM3D_REQUIRE_EQUAL(eulers->getValue(3 * i + 2), reader.getEuler3Pointer()[i]);
+    DREAM3D_REQUIRE_EQUAL(confidences->getValue(i), reader.getConfidencePointer()[i]);
+    DREAM3D_REQUIRE_EQUAL(phases->getValue(i), std::max(reader.getPhasePointer()[i], 1));
+  }
+
+  // A file that is not on a lattice has no mesh
+  filter = ReadMicData::New();
+  filter->setInputFile(offLatticeFile);
+  filter->setOutputGeometryType(MIC_TRIANGLE_GEOMETRY);
+  filter->setDataContainerArray(DataContainerArray::New());
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -390);
+
+  cache->clear();
+  RemoveMicFile(latticeFile);
+  RemoveMicFile(offLatticeFile);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestReadMicDataSharedCache()
+{
+  MicReaderCache* cache = MicReaderCache::Instance();
+  size_t budget = cache->getMemoryBudget();
+  cache->setMemoryBudget(MicReaderCache::k_DefaultMemoryBudget);
+  cache->clear();
+
+  // A shared cache of zero MiB keeps the file out of the cache without changing its budget.
+  // The image is resampled straight into the cell arrays.
+  ReadMicData::Pointer filter = ReadMicData::New();
+  filter->setInputFile(UnitTest::HedmReaderTest::MicFile);
+  filter->setSharedCacheSize(0);
+  filter->setDataContainerArray(DataContainerArray::New());
+  filter->execute();
+  DREAM3D_REQUIRE(filter->getErrorCode() >= 0);
+  DREAM3D_REQUIRE_EQUAL(cache->getMemoryBudget(), MicReaderCache::k_DefaultMemoryBudget);
+  DREAM3D_REQUIRE(cache->find(UnitTest::HedmReaderTest::MicFile).get() == nullptr);
+  AttributeMatrix::Pointer cellAttrMat = filter->getDataContainerArray()->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+  FloatArrayType::Pointer uncachedConfidences = cellAttrMat->getAttributeArrayAs<FloatArrayType>(Mic::Confidence);
+  DREAM3D_REQUIRE(nullptr != uncachedConfidences.get());
+
+  // The default size keeps the file for the next filter, which reads the same cells
+  filter = ReadMicData::New();
+  filter->setInputFile(UnitTest::HedmReaderTest::MicFile);
+  filter->setDataContainerArray(DataContainerArray::New());
+  filter->execute();
+  DREAM3D_REQUIRE(filter->getErrorCode() >= 0);
+  DREAM3D_REQUIRE_EQUAL(cache->getMemoryBudget(), MicReaderCache::k_DefaultMemoryBudget);
+  DREAM3D_REQUIRE(cache->find(UnitTest::HedmReaderTest::MicFile).get() != nullptr);
+  cellAttrMat = filter->getDataContainerArray()->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+  FloatArrayType::Pointer cachedConfidences = cellAttrMat->getAttributeArrayAs<FloatArrayType>(Mic::Confidence);
+  DREAM3D_REQUIRE(nullptr != cachedConfidences.get());
+  DREAM3D_REQUIRE_EQUAL(cachedConfidences->getNumberOfTuples(), uncachedConfidences->getNumberOfTuples());
+  for(size_t i = 0; i < cachedConfidences->getNumberOfTuples(); i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(cachedConfidences->getValue(i), uncachedConfidences->getValue(i));
+  }
+
+  // A filter with a size of zero leaves the files of the other filters alone, a larger size grows the budget
+  filter = ReadMicData::New();
+  filter->setInputFile(UnitTest::HedmReaderTest::MicFile);
+  filter->setSharedCacheSize(0);
+  filter->setDataContainerArray(DataContainerArray::New());
+  filter->execute();
+  DREAM3D_REQUIRE(filter->getErrorCode() >= 0);
+  DREAM3D_REQUIRE_EQUAL(cache->getMemoryBudget(), MicReaderCache::k_DefaultMemoryBudget);
+  DREAM3D_REQUIRE(cache->find(UnitTest::HedmReaderTest::MicFile).get() != nullptr);
+  filter->setSharedCacheSize(1024);
+  filter->setDataContainerArray(DataContainerArray::New());
+  filter->execute();
+  DREAM3D_REQUIRE(filter->getErrorCode() >= 0);
+  DREAM3D_REQUIRE_EQUAL(cache->getMemoryBudget(), 1024ULL * 1024ULL * 1024ULL);
+  filter->setSharedCacheSize(1);
+  filter->setDataContainerArray(DataContainerArray::New());
+  filter->execute();
+  DREAM3D_REQUIRE(filter->getErrorCode() >= 0);
+  DREAM3D_REQUIRE_EQUAL(cache->getMemoryBudget(), 1024ULL * 1024ULL * 1024ULL);
+  DREAM3D_REQUIRE(cache->find(UnitTest::HedmReaderTest::MicFile).get() != nullptr);
+
+  // A negative size is an error
+  filter = ReadMicData::New();
+  filter->setInputFile(UnitTest::HedmReaderTest::MicFile);
+  filter->setSharedCacheSize(-1);
+  filter->setDataContainerArray(DataContainerArray::New());
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -394);
+
+  cache->setMemoryBudget(budget);
+  cache->clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WriteMicStackLayer(const QString& micFile, const QByteArray& edgeLength, int numRows, const QByteArray& datContents)
+{
+  QString basePath = UnitTest::HedmReaderTest::MicFile.left(UnitTest::HedmReaderTest::MicFile.size() - 4);
+  QString layerBasePath = micFile.left(micFile.size() - 4);
+  QFile::remove(micFile);
+  QFile::remove(layerBasePath + ".config");
+  QFile::remove(layerBasePath + ".dat");
+  DREAM3D_REQUIRE(QFile::copy(basePath + ".config", layerBasePath + ".config"));
+
+  // The first line of the .mic file is the edge length, the data rows follow it
+  QFile in(UnitTest::HedmReaderTest::MicFile);
+  DREAM3D_REQUIRE(in.open(QIODevice::ReadOnly));
+  QByteArray contents = in.readAll();
+  in.close();
+  QList<QByteArray> lines = contents.split('\n');
+  QFile out(micFile);
+  DREAM3D_REQUIRE(out.open(QIODevice::WriteOnly));
+  out.write(edgeLength);
+  for(int row = 1; row < lines.size() && (numRows < 0 || row <= numRows); row++)
+  {
+    out.write("\n");
+    out.write(lines[row]);
+  }
+  out.close();
+
+  if(datContents.isEmpty())
+  {
+    DREAM3D_REQUIRE(QFile::copy(basePath + ".dat", layerBasePath + ".dat"));
+  }
+  else
+  {
+    QFile dat(layerBasePath + ".dat");
+    DREAM3D_REQUIRE(dat.open(QIODevice::WriteOnly));
+    dat.write(datContents);
+    dat.close();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ReadMicStack::Pointer CreateReadMicStack(int numLayers)
+{
+  ReadMicStack::Pointer filter = ReadMicStack::New();
+  FileListInfo_t fileListInfo = filter->getInputFileListInfo();
+  fileListInfo.InputPath = UnitTest::TestTempDir;
+  fileListInfo.FilePrefix = "ReadMicStack_";
+  fileListInfo.StartIndex = 0;
+  fileListInfo.EndIndex = numLayers - 1;
+  filter->setInputFileListInfo(fileListInfo);
+  filter->setZSpacing(2.5f);
+  filter->setDataContainerArray(DataContainerArray::New());
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestReadMicStack()
+{
+  // The middle layer has a coarser edge length than the other two, so its hexagon is
+  // larger and the stack has to grow to hold it, and only half of the rows. The last
+  // layer repeats the first.
+  QVector<QString> layerFiles;
+  for(int layer = 0; layer < 3; layer++)
+  {
+    layerFiles.push_back(UnitTest::TestTempDir + "/ReadMicStack_" + QString::number(layer) + ".mic");
+  }
+  WriteMicStackLayer(layerFiles[0], "0.600000", -1, QByteArray());
+  WriteMicStackLayer(layerFiles[1], "0.900000", 256, QByteArray());
+  WriteMicStackLayer(layerFiles[2], "0.600000", -1, QByteArray());
+
+  ReadMicStack::Pointer filter = CreateReadMicStack(3);
+  filter->execute();
+  DREAM3D_REQUIRE(filter->getErrorCode() >= 0);
+
+  DataContainer::Pointer m = filter->getDataContainerArray()->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+  DREAM3D_REQUIRE(nullptr != m.get());
+  ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
+  SizeVec3Type dims = image->getDimensions();
+  FloatVec3Type spacing = image->getSpacing();
+  FloatVec3Type origin = image->getOrigin();
+  DREAM3D_REQUIRE_EQUAL(dims[2], 3);
+  DREAM3D_REQUIRE_EQUAL(spacing[2], 2.5f);
+  DREAM3D_REQUIRE_EQUAL(origin[2], 0.0f);
+
+  // Every layer lies inside the shared grid, which has the finest spacing of all of them
+  for(int layer = 0; layer < 3; layer++)
+  {
+    MicReader header;
+    header.setFileName(layerFiles[layer]);
+    DREAM3D_REQUIRE(header.readHeaderOnly() >= 0);
+    float edgeLength = header.getEdgeLength() * 1000.0f;
+    DREAM3D_REQUIRE(spacing[0] <= edgeLength);
+    DREAM3D_REQUIRE(origin[0] <= header.getXOrigin() * 1000.0f + 0.001f);
+    DREAM3D_REQUIRE(origin[1] <= header.getYOrigin() * 1000.0f + 0.001f);
+    DREAM3D_REQUIRE(origin[0] + spacing[0] * (dims[0] - 1) >= header.getXOrigin() * 1000.0f + edgeLength * (header.getXDimension() - 1) - 0.001f);
+    DREAM3D_REQUIRE(origin[1] + spacing[1] * (dims[1] - 1) >= header.getYOrigin() * 1000.0f + edgeLength * (header.getYDimension() - 1) - 0.001f);
+    if(layer == 0)
+    {
+      DREAM3D_REQUIRE(dims[0] > static_cast<size_t>(header.getXDimension()));
+    }
+  }
+
+  // Each layer is at its own Z index, and the points outside the triangles belong to the first phase
+  AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+  DREAM3D_REQUIRE_EQUAL(cellAttrMat->getNumberOfTuples(), dims[0] * dims[1] * dims[2]);
+  Int32ArrayType::Pointer phases = cellAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::Phases);
+  FloatArrayType::Pointer eulers = cellAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::EulerAngles);
+  FloatArrayType::Pointer confidences = cellAttrMat->getAttributeArrayAs<FloatArrayType>(Mic::Confidence);
+  DREAM3D_REQUIRE(nullptr != phases.get() && nullptr != eulers.get() && nullptr != confidences.get());
+  size_t sliceSize = dims[0] * dims[1];
+  size_t numOutside = 0;
+  size_t numDifferent = 0;
+  for(size_t i = 0; i < sliceSize; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(phases->getValue(i), phases->getValue(2 * sliceSize + i));
+    DREAM3D_REQUIRE_EQUAL(confidences->getValue(i), confidences->getValue(2 * sliceSize + i));
+    DREAM3D_REQUIRE_EQUAL(eulers->getValue(3 * i + 1), eulers->getValue(3 * (2 * sliceSize + i) + 1));
+    numDifferent += (confidences->getValue(i) != confidences->getValue(sliceSize + i)) ? 1 : 0;
+    numOutside += (confidences->getValue(i) == 0.0f) ? 1 : 0;
+  }
+  DREAM3D_REQUIRE(numDifferent > 0);
+  DREAM3D_REQUIRE(numOutside > 0);
+  for(size_t i = 0; i < phases->getNumberOfTuples(); i++)
+  {
+    DREAM3D_REQUIRE(phases->getValue(i) >= 1);
+  }
+
+  // The ensemble arrays hold the phase of the .dat file
+  AttributeMatrix::Pointer cellEnsembleAttrMat = m->getAttributeMatrix(SIMPL::Defaults::CellEnsembleAttributeMatrixName);
+  FloatArrayType::Pointer latticeConstants = cellEnsembleAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::EnsembleData::LatticeConstants);
+  DREAM3D_REQUIRE(nullptr != latticeConstants.get());
+  DREAM3D_REQUIRE_EQUAL(latticeConstants->getComponent(1, 0), 5.0f);
+  DREAM3D_REQUIRE_EQUAL(latticeConstants->getComponent(1, 3), 90.0f);
+
+  // The compact codes go into arrays of their own, the float arrays are not created
+  filter = CreateReadMicStack(3);
+  filter->setUseCompactArrays(true);
+  filter->execute();
+  DREAM3D_REQUIRE(filter->getErrorCode() >= 0);
+  cellAttrMat = filter->getDataContainerArray()->getDataContainer(SIMPL::Defaults::ImageDataContainerName)->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName);
+  DREAM3D_REQUIRE(nullptr == cellAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::EulerAngles).get());
+  DREAM3D_REQUIRE(nullptr == cellAttrMat->getAttributeArrayAs<FloatArrayType>(Mic::Confidence).get());
+  UInt16ArrayType::Pointer eulerCodes = cellAttrMat->getAttributeArrayAs<UInt16ArrayType>(Mic::CompactEulerAngles);
+  UInt8ArrayType::Pointer confidenceCodes = cellAttrMat->getAttributeArrayAs<UInt8ArrayType>(Mic::CompactConfidence);
+  DREAM3D_REQUIRE(nullptr != eulerCodes.get() && nullptr != confidenceCodes.get());
+  for(size_t i = 0; i < confidences->getNumberOfTuples(); i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(confidenceCodes->getValue(i), MicCompactCodec::encodeConfidence(confidences->getValue(i)));
+    DREAM3D_REQUIRE_EQUAL(eulerCodes->getValue(3 * i + 1), MicCompactCodec::encodeEulerAngle(eulers->getValue(3 * i + 1)));
+  }
+
+  // A canceled filter leaves the layers unread
+  filter = CreateReadMicStack(3);
+  filter->setCancel(true);
+  filter->execute();
+  DREAM3D_REQUIRE(filter->getErrorCode() >= 0);
+  m = filter->getDataContainerArray()->getDataContainer(SIMPL::Defaults::ImageDataContainerName);
+  phases = m->getAttributeMatrix(SIMPL::Defaults::CellAttributeMatrixName)->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::Phases);
+  for(size_t i = 0; i < phases->getNumberOfTuples(); i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(phases->getValue(i), 0);
+  }
+
+  // A layer that does not exist is an error
+  filter = CreateReadMicStack(4);
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -388);
+
+  // So is a layer with other phases than the first one
+  WriteMicStackLayer(layerFiles[1], "0.900000", 256, "6.0,6.0,6.0\n90,90,90\n1\n26 0 0 0\n");
+  filter = CreateReadMicStack(3);
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -393);
+
+  // And a layer whose header files can not be read. The error names the layer.
+  QFile::remove(UnitTest::TestTempDir + "/ReadMicStack_1.dat");
+  filter = CreateReadMicStack(3);
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -111);
+  DREAM3D_REQUIRE(filter->getErrorMessage().toStdString().find(layerFiles[1].toStdString()) != std::string::npos);
+
+  for(const QString& layerFile : layerFiles)
+  {
+    QString layerBasePath = layerFile.left(layerFile.size() - 4);
+    QFile::remove(layerFile);
+    QFile::remove(layerBasePath + ".config");
+    QFile::remove(layerBasePath + ".dat");
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QByteArray ReadMicEdgeLength()
+{
+  QFile in(UnitTest::HedmReaderTest::MicFile);
+  DREAM3D_REQUIRE(in.open(QIODevice::ReadOnly));
+  return in.readLine().trimmed();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicReaderHeaderOnly()
+{
+  // The header dimensions only depend on the first rows, so a file that keeps just the
+  // first data row has the same grid as the whole file
+  QString firstRowFile = UnitTest::TestTempDir + "/MicHeaderOnly.mic";
+  WriteMicStackLayer(firstRowFile, ReadMicEdgeLength(), 1, QByteArray());
+  MicReader firstRowReader;
+  firstRowReader.setFileName(firstRowFile);
+  int err = firstRowReader.readHeaderOnly();
+  DREAM3D_REQUIRE(err >= 0);
+
+  MicReader headerReader;
+  headerReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  err = headerReader.readHeaderOnly();
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE_EQUAL(headerReader.getXDimension(), firstRowReader.getXDimension());
+  DREAM3D_REQUIRE_EQUAL(headerReader.getYDimension(), firstRowReader.getYDimension());
+  DREAM3D_REQUIRE_EQUAL(headerReader.getXOrigin(), firstRowReader.getXOrigin());
+  DREAM3D_REQUIRE_EQUAL(headerReader.getEdgeLength(), firstRowReader.getEdgeLength());
+  DREAM3D_REQUIRE_EQUAL(headerReader.getPhaseVector().size(), firstRowReader.getPhaseVector().size());
+
+  // The hexagon of the header is at least as large as the grid that readFile() fits to the data
+  MicReader reader;
+  reader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  err = reader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  float spacing = reader.getEdgeLength();
+  DREAM3D_REQUIRE_EQUAL(headerReader.getEdgeLength(), spacing);
+  DREAM3D_REQUIRE(headerReader.getXDimension() >= reader.getXDimension());
+  DREAM3D_REQUIRE(headerReader.getYDimension() >= reader.getYDimension());
+  DREAM3D_REQUIRE(headerReader.getXOrigin() <= reader.getXOrigin());
+  DREAM3D_REQUIRE(headerReader.getYOrigin() <= reader.getYOrigin());
+
+  // A file without data rows has no grid
+  QString emptyFile = UnitTest::TestTempDir + "/MicHeaderOnlyEmpty.mic";
+  WriteMicStackLayer(emptyFile, ReadMicEdgeLength(), 0, QByteArray());
+  MicReader emptyReader;
+  emptyReader.setFileName(emptyFile);
+  DREAM3D_REQUIRE_EQUAL(emptyReader.readHeaderOnly(), -114);
+
+  // An empty region of interest fails before any row is read
+  MicRegionOfInterest region;
+  region.enabled = true;
+  region.xMin = 1.0f;
+  region.xMax = 0.0f;
+  headerReader.setRegionOfInterest(region);
+  DREAM3D_REQUIRE_EQUAL(headerReader.readHeaderOnly(), -116);
+
+  for(const QString& micFile : {firstRowFile, emptyFile})
+  {
+    QString basePath = micFile.left(micFile.size() - 4);
+    QFile::remove(micFile);
+    QFile::remove(basePath + ".config");
+    QFile::remove(basePath + ".dat");
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMicTriangleTable()
+{
+  // The triangle table holds exactly the rows of the file, however many the level allows for
+  QString halfFile = UnitTest::TestTempDir + "/MicTriangleTable.mic";
+  WriteMicStackLayer(halfFile, ReadMicEdgeLength(), 256, QByteArray());
+  MicReader halfReader;
+  halfReader.setFileName(halfFile);
+  halfReader.setResampleToGrid(false);
+  int err = halfReader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE_EQUAL(halfReader.getNumberOfElements(), 256);
+
+  MicReader fullReader;
+  fullReader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  fullReader.setResampleToGrid(false);
+  err = fullReader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE(fullReader.getNumberOfElements() > 256);
+  DREAM3D_REQUIRE(halfReader.getDataSize() < fullReader.getDataSize());
+
+  // Rasterizing the kept table again gives the same grid, nothing of the first read is left over
+  MicReader reader;
+  reader.setFileName(UnitTest::HedmReaderTest::MicFile);
+  err = reader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  size_t numPoints = reader.getNumberOfElements();
+  DREAM3D_REQUIRE_EQUAL(numPoints, static_cast<size_t>(reader.getXDimension()) * static_cast<size_t>(reader.getYDimension()));
+  std::vector<float> euler1(reader.getEuler1Pointer(), reader.getEuler1Pointer() + numPoints);
+  std::vector<float> confidences(reader.getConfidencePointer(), reader.getConfidencePointer() + numPoints);
+  std::vector<int> phases(reader.getPhasePointer(), reader.getPhasePointer() + numPoints);
+  err = reader.readFile();
+  DREAM3D_REQUIRE(err >= 0);
+  DREAM3D_REQUIRE_EQUAL(reader.getNumberOfElements(), numPoints);
+  for(size_t point = 0; point < numPoints; point++)
+  {
+    DREAM3D_REQUIRE_EQUAL(reader.getEuler1Pointer()[point], euler1[point]);
+    DREAM3D_REQUIRE_EQUAL(reader.getConfidencePointer()[point], confidences[point]);
+    DREAM3D_REQUIRE_EQUAL(reader.getPhasePointer()[point], phases[point]);
+  }
+
+  // The grid holds the values of the table rows that cover it
+  size_t numCovered = 0;
+  for(size_t point = 0; point < numPoints; point++)
+  {
+    if(confidences[point] == 0.0f)
+    {
+      continue;
+    }
+    numCovered++;
+    bool found = false;
+    for(size_t row = 0; row < fullReader.getNumberOfElements() && !found; row++)
+    {
+      found = (fullReader.getEuler1Pointer()[row] == euler1[point] && fullReader.getConfidencePointer()[row] == confidences[point]);
+    }
+    DREAM3D_REQUIRE(found);
+  }
+  DREAM3D_REQUIRE(numCovered > 0);
+
+  QString halfBasePath = halfFile.left(halfFile.size() - 4);
+  QFile::remove(halfFile);
+  QFile::remove(halfBasePath + ".config");
+  QFile::remove(halfBasePath + ".dat");
+}
+
+/**
+ * @brief Runs the tests of the .mic and H5Mic readers and of the filters built on them. SIMPL_GenerateUnitTestFile includes
+ * this file into the unit test main it generates for TEST_NAMES and calls HedmReaderTest()().
+ */
+class HedmReaderTest
+{
+public:
+  HedmReaderTest() = default;
+  ~HedmReaderTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+    DREAM3D_REGISTER_TEST( TestMicDataParser() )
+    DREAM3D_REGISTER_TEST( TestMicConfigHeader() )
+    DREAM3D_REGISTER_TEST( TestMicTriangleRasterizer() )
+    DREAM3D_REGISTER_TEST( TestMicCoverageMap() )
+    DREAM3D_REGISTER_TEST( TestMicColumnArena() )
+    DREAM3D_REGISTER_TEST( TestMicLattice() )
+    DREAM3D_REGISTER_TEST( TestHedmReader() )
+    DREAM3D_REGISTER_TEST( TestMicColumnProjection() )
+    DREAM3D_REGISTER_TEST( TestMicRowFilter() )
+    DREAM3D_REGISTER_TEST( TestMicParallelParse() )
+    DREAM3D_REGISTER_TEST( TestMicGridTarget() )
+    DREAM3D_REGISTER_TEST( TestMicGridAllocator() )
+    DREAM3D_REGISTER_TEST( TestMicCompactCodec() )
+    DREAM3D_REGISTER_TEST( TestMicRegionOfInterest() )
+    DREAM3D_REGISTER_TEST( TestMicReaderBuffer() )
+    DREAM3D_REGISTER_TEST( TestMicReaderDevice() )
+    DREAM3D_REGISTER_TEST( TestMicReaderHeaderOnly() )
+    DREAM3D_REGISTER_TEST( TestMicTriangleTable() )
+    DREAM3D_REGISTER_TEST( TestH5MicImporter() )
+    DREAM3D_REGISTER_TEST( TestH5MicImporterStack() )
+    DREAM3D_REGISTER_TEST( TestH5MicVolumeLayout() )
+    DREAM3D_REGISTER_TEST( TestH5MicSliceData() )
+    DREAM3D_REGISTER_TEST( TestH5MicVirtualVolume() )
+    DREAM3D_REGISTER_TEST( TestMicCacheFile() )
+    DREAM3D_REGISTER_TEST( TestMicReaderCache() )
+    DREAM3D_REGISTER_TEST( TestReadMicDataSharedCache() )
+    DREAM3D_REGISTER_TEST( TestReadMicDataResample() )
+    DREAM3D_REGISTER_TEST( TestReadMicDataTriangleGeometry() )
+    DREAM3D_REGISTER_TEST( TestReadMicStack() )
+  }
+
+public:
+  HedmReaderTest(const HedmReaderTest&) = delete;            // Copy Constructor Not Implemented
+  HedmReaderTest(HedmReaderTest&&) = delete;                 // Move Constructor Not Implemented
+  HedmReaderTest& operator=(const HedmReaderTest&) = delete; // Copy Assignment Not Implemented
+  HedmReaderTest& operator=(HedmReaderTest&&) = delete;      // Move Assignment Not Implemented
+};